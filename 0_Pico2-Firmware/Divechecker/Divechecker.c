@@ -5,7 +5,7 @@
  * @details
  * Dual-core architecture for high-precision pressure monitoring:
  *   - Core 0: USB MIDI communication, command processing
- *   - Core 1: 160Hz BMP280 sensor sampling
+ *   - Core 1: 100Hz pressure sensor sampling (BMP280 or BMP390, see sensor.h)
  * 
  * Features:
  *   - USB MIDI SysEx protocol for cross-platform support
@@ -29,7 +29,6 @@
 #include "pico/unique_id.h"
 #include "pico/bootrom.h"  // For BOOTSEL reboot
 
-#include "hardware/i2c.h"
 #include "hardware/gpio.h"
 #include "hardware/pio.h"
 #include "hardware/flash.h"
@@ -37,11 +36,26 @@
 #include "hardware/watchdog.h"
 #include "hardware/clocks.h"
 #include "hardware/structs/usb.h"  // Direct USB SIE register access
-#include "pico/mutex.h"
 
 // TinyUSB for USB MIDI
 #include "tusb.h"
+#include "divechecker_config.h"
 #include "midi_sysex.h"
+#include "latency_stats.h"
+#include "profiler.h"
+#include "microbench.h"
+#include "crc32_dma.h"
+#include "flash_io.h"
+#include "settings_journal.h"
+#include "flash_maint.h"
+#include "recorder.h"
+#include "bulk_transfer.h"
+#include "capture.h"
+#include "burst.h"
+#include "sensor.h"
+#include "sensor_bus.h"
+#include "sensor_autotune.h"
+#include "power.h"
 
 // mbedtls for ECDSA authentication
 #include "mbedtls/ecdsa.h"
@@ -92,52 +106,80 @@
 #define FW_VERSION_PATCH    0
 #define FW_VERSION_STRING   "6.0.0"
 
-// I2C Configuration
-#define I2C_PORT            i2c0
-#define I2C_SDA_PIN         8
-#define I2C_SCL_PIN         9
-#define I2C_BAUDRATE        400000      // 400kHz (BMP280 max spec)
-
-// BMP280 Sensor
-#define BMP280_I2C_ADDR     0x76
-#define BMP280_CHIP_ID      0x58
-#define BME280_CHIP_ID      0x60
-
-// Sampling Configuration
-#define INTERNAL_SAMPLE_RATE_HZ  100     // Fixed internal sampling rate
-#define DEFAULT_OUTPUT_RATE_HZ   8       // Default output rate
-#define MIN_OUTPUT_RATE_HZ       4       // Minimum (most stable)
-#define MAX_OUTPUT_RATE_HZ       50      // Maximum (less averaging)
-#define MAX_SAMPLES_PER_OUTPUT   (INTERNAL_SAMPLE_RATE_HZ / MIN_OUTPUT_RATE_HZ)  // 25 max
-#define SAMPLE_INTERVAL_US       (1000000 / INTERNAL_SAMPLE_RATE_HZ)  // 10ms
+// Pressure sensor (bus pins in sensor_bus.h; the address is unused on SPI)
+#define SENSOR_I2C_ADDR     0x76
+#define SENSOR_I2C_ADDR_2   0x77        // Optional second sensor (SDO high)
+#define SENSOR_CHANNELS     2
+
+// Sampling rates, output rate range and the Core 1 -> Core 0 queue depth
+// come from the build profile (divechecker_config.h, see profiles.cmake)
 
 // Connection Timeout
 #define CONNECTION_TIMEOUT_MS   30000
+// Boot-time wait for a USB host; afterwards run standalone (recorder)
+#define USB_CONNECT_WAIT_MS     5000
+
+// Sensor bring-up on Core 1, in parallel with USB on Core 0. Failed
+// attempts back off from SENSOR_RETRY_FIRST_MS to SENSOR_RETRY_MAX_MS; the
+// boot phase (device info: starting) ends after SENSOR_BOOT_ATTEMPTS
+#define SENSOR_POWER_UP_MS      2       // t_startup, BMP280 and BMP3xx datasheets
+#define SENSOR_BOOT_ATTEMPTS    5       // At 0, 50, 150, 350, 750 ms
+#define SENSOR_RETRY_FIRST_MS   50
+#define SENSOR_RETRY_MAX_MS     5000
+
+// Clock governor (power.h). Output above FAST_OUTPUT_HZ runs at full
+// clock. Suspend starts once the bus has been suspended for
+// SUSPEND_ENTER_MS, which lets a remote wakeup complete first; keep-warm
+// samples once per interval, which holds the baseline, temperature and IIR
+// memory current without a stream
+#define FAST_OUTPUT_HZ          20
+#define SUSPEND_ENTER_MS        50
+#define KEEP_WARM_INTERVAL_US   250000
+#define IDLE_US                 100     // Main loop sleep, both cores
+#define SUSPEND_IDLE_US         1000    // The same while suspended
 
 // WS2812 LED (RP2350 Zero SuperMini)
 #define WS2812_PIN          16
 #define WS2812_IS_RGBW      false
 #define LED_BRIGHTNESS      50
 
-// Flash Storage (last 4KB sector of 4MB flash)
+// Flash Storage (settings journal in the last two 4KB sectors of 4MB flash)
 #define FLASH_SIZE_BYTES        (4 * 1024 * 1024)
-#define FLASH_SETTINGS_OFFSET   (FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define FLASH_SETTINGS_OFFSET   (FLASH_SIZE_BYTES - SETTINGS_JOURNAL_SECTORS * FLASH_SECTOR_SIZE)
+// Session recorder ring: from the end of the firmware image up to the journal
+extern char __flash_binary_end;
+#define FLASH_RECORDER_OFFSET   ((((uint32_t)(uintptr_t)&__flash_binary_end - XIP_BASE) + \
+                                  FLASH_SECTOR_SIZE - 1) & ~(FLASH_SECTOR_SIZE - 1))
+// v6.0 fixed-slot sector (= second journal sector), read once for migration
+#define FLASH_LEGACY_SETTINGS_OFFSET (FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
 #define SETTINGS_MAGIC          0x44495646  // "DIVF"
 
+// Settings journal keys (persisted in flash — never renumber)
+#define SETTING_KEY_PIN             0x01
+#define SETTING_KEY_NAME            0x02
+#define SETTING_KEY_LED_BRIGHTNESS  0x03
+#define SETTING_KEY_NOISE_FLOOR     0x04
+#define SETTING_KEY_OVERSAMPLING    0x05
+#define SETTING_KEY_IIR_CONFIG      0x06
+#define SETTING_KEY_OUTPUT_RATE     0x07
+#define SETTING_KEY_PIN_FAIL_COUNT  0x08
+#define SETTING_KEY_RECORDER_TRIGGER 0x09  // uint32 LE, hPa x1000, 0 = off
+#define SETTING_KEY_DUAL_MODE       0x0A
+#define SETTING_KEY_SENSOR_AUTO     0x0B
+
 // Device Settings Limits
 #define DEVICE_NAME_MAX_LEN     24      // UTF-8 bytes (8 Korean chars or 24 ASCII)
 #define DEVICE_PIN_LEN          4
 
-// Inter-core Queue
-#define PRESSURE_QUEUE_SIZE     32
-
 /* ============================================================================
  * Type Definitions
  * ========================================================================== */
 
 /**
- * @brief Flash-stored device settings structure
- * @note Must be exactly FLASH_PAGE_SIZE (256 bytes) for flash programming
+ * @brief Legacy (v6.0) flash-stored device settings structure
+ * @details Superseded by the settings journal; only read once at boot to
+ *          migrate devices that still carry the 16-slot layout.
+ * @note Exactly FLASH_PAGE_SIZE (256 bytes)
  * @note CRC32 at end covers bytes 0..(size-5), using polynomial 0xEDB88320
  */
 typedef struct __attribute__((packed)) {
@@ -149,7 +191,7 @@ typedef struct __attribute__((packed)) {
     uint8_t noise_floor;         // 0-50
     uint8_t oversampling_ctrl;   // 0-5
     uint8_t iir_config;          // 0-4
-    uint8_t output_rate;         // 4-50 Hz
+    uint8_t output_rate;         // MIN..MAX_OUTPUT_RATE_HZ (profile)
     uint8_t pin_fail_count;      // Persisted PIN failure count
     uint8_t _config_reserved[2]; // Future use
     uint8_t _reserved[FLASH_PAGE_SIZE - sizeof(uint32_t) - (DEVICE_PIN_LEN + 1) - (DEVICE_NAME_MAX_LEN + 1) - 8 - sizeof(uint32_t)];
@@ -160,23 +202,28 @@ _Static_assert(sizeof(device_settings_t) == FLASH_PAGE_SIZE,
                "device_settings_t must be exactly FLASH_PAGE_SIZE");
 
 /**
- * @brief Pressure data packet for inter-core communication
+ * @brief One output rate: a row of the profile's rate table
  */
 typedef struct {
-    int32_t delta_x1000;  // Delta pressure in hPa * 1000
-} pressure_packet_t;
+    uint16_t interval_ms;
+    uint32_t interval_us;
+    uint16_t samples;       // Averaged per output frame
+} output_rate_t;
 
 /**
- * @brief BMP280 calibration data
+ * @brief Pressure data packet for inter-core communication
  */
 typedef struct {
-    uint16_t dig_T1;
-    int16_t  dig_T2, dig_T3;
-    uint16_t dig_P1;
-    int16_t  dig_P2, dig_P3, dig_P4, dig_P5;
-    int16_t  dig_P6, dig_P7, dig_P8, dig_P9;
-    int32_t  t_fine;    // Temperature for pressure compensation
-} bmp280_calib_t;
+    int32_t delta_x1000;  // Delta pressure in hPa * 1000
+    int32_t delta2_x1000; // Same for the second sensor
+    int32_t min_x1000;    // Primary window extremes (no noise floor)
+    int32_t max_x1000;
+    uint32_t stddev_x1e6; // Primary window standard deviation, hPa * 1000000
+    uint8_t count;        // Primary samples averaged
+    uint32_t t_read_us;   // Newest sample in the window read (time_us_32)
+    uint32_t t_push_us;   // Packet queued by Core 1 (time_us_32)
+    uint8_t valid;        // DUAL_VALID_* (primary only without a second sensor)
+} pressure_packet_t;
 
 /**
  * @brief LED status colors
@@ -190,30 +237,20 @@ typedef enum {
 } led_state_t;
 
 /* ============================================================================
- * BMP280 Register Definitions
+ * Sensor Validity
  * ========================================================================== */
 
-#define BMP280_REG_ID           0xD0
-#define BMP280_REG_RESET        0xE0
-#define BMP280_REG_CTRL_MEAS    0xF4
-#define BMP280_REG_CONFIG       0xF5
-#define BMP280_REG_PRESS_MSB    0xF7
-#define BMP280_REG_CALIB_START  0x88
-#define BMP280_CALIB_LEN        24
-
-#define BMP280_RESET_VALUE      0xB6
-// Stable settings: osrs_t=001 (x1), osrs_p=101 (x16), mode=11 (normal) = 0x57
-#define BMP280_CTRL_STABLE      0x57    // T:x1, P:x16, normal mode
-#define BMP280_CONFIG_FILTERED  0x04    // standby=0.5ms, filter=x2
-
-// BMP280 valid measurement range (extended beyond datasheet 300-1100 hPa spec)
-#define BMP280_PRESSURE_MIN_HPA     300.0f
-#define BMP280_PRESSURE_MAX_HPA     1250.0f
-
-// Over-range recovery: discard initial samples after sensor reset
-// to let IIR filter stabilize with clean values
-#define OVERRANGE_RECOVERY_SAMPLES  30   // ~300ms at 100Hz
+// Valid readings: SENSOR_PLAUSIBLE_MIN_HPA..MAX_HPA (sensor.h, extended
+// beyond the datasheet 300-1100 hPa spec)
+
+// Over-range recovery. A part that can bypass its IIR filter
+// (SENSOR_CAP_FILTER_BYPASS) runs unfiltered while saturated, so its first
+// conversion back in range is clean: the averager restarts from it and a
+// frame goes out at once. Otherwise the part is reset and the first samples
+// are discarded while its IIR filter settles with clean values.
+#define OVERRANGE_RECOVERY_SAMPLES  30   // ~300ms at 100Hz (reset path)
 #define OVERRANGE_CONSEC_THRESHOLD  10   // consecutive bad readings before reset
+#define SATURATION_LOOKAHEAD        3    // Conversions the pressure trend looks ahead
 
 /* ============================================================================
  * Global State
@@ -224,9 +261,18 @@ static char g_serial_number[PICO_UNIQUE_BOARD_ID_SIZE_BYTES * 2 + 1];
 static char g_device_name[DEVICE_NAME_MAX_LEN + 1] = "DiveChecker";
 static char g_device_pin[DEVICE_PIN_LEN + 1] = "0000";
 
-// Sensor state
-static bmp280_calib_t g_calib;
+// Sensor state (g_sensor2: optional second sensor, probed once at boot)
+static sensor_t g_sensor;
 static volatile bool g_sensor_ready = false;
+static sensor_t g_sensor2;
+static volatile bool g_sensor2_ready = false;
+static sensor_health_t g_sensor_health[SENSOR_CHANNELS];  // Written by Core 1
+
+// Boot pipeline: Core 0 serves USB while Core 1 brings the sensor up
+static volatile bool g_sensor_starting = true;   // Boot attempts left (Core 1 clears)
+static boot_times_t g_boot_times = {              // sensor_ready_ms: Core 1, once
+    BOOT_TIME_PENDING, BOOT_TIME_PENDING, BOOT_TIME_PENDING, BOOT_TIME_PENDING,
+};
 
 // Baseline for delta calculation
 static volatile float g_baseline_pressure = 0;
@@ -237,10 +283,24 @@ static bool g_baseline_printed = false;
 static volatile bool g_app_connected = false;
 static volatile uint64_t g_last_ping_ms = 0;
 
-// Output rate (configurable via 'F' command)
+// Output rate (configurable via 'F' command). Interval and frame size are
+// looked up, never divided out: g_rate points at the rate's table row and
+// changes in one store, so Core 1 never sees half an update
+static const output_rate_t k_output_rates[] = { DIVECHECKER_RATE_TABLE };
+static const float k_mean_scale[MAX_SAMPLES_PER_OUTPUT + 1] = { DIVECHECKER_MEAN_SCALE_TABLE };
+_Static_assert(sizeof(k_output_rates) / sizeof(k_output_rates[0]) ==
+               MAX_OUTPUT_RATE_HZ - MIN_OUTPUT_RATE_HZ + 1, "rate table out of date");
 static volatile int g_output_rate = DEFAULT_OUTPUT_RATE_HZ;
-static volatile int g_output_interval_ms = 1000 / DEFAULT_OUTPUT_RATE_HZ;
-static volatile int g_samples_per_output = INTERNAL_SAMPLE_RATE_HZ / DEFAULT_OUTPUT_RATE_HZ;
+static const output_rate_t *volatile g_rate =
+    &k_output_rates[DEFAULT_OUTPUT_RATE_HZ - MIN_OUTPUT_RATE_HZ];
+
+/// Switch the output rate (MIN_OUTPUT_RATE_HZ..MAX_OUTPUT_RATE_HZ, checked by the caller)
+static inline void output_rate_set(int rate) {
+    g_output_rate = rate;
+    __dmb();
+    g_rate = &k_output_rates[rate - MIN_OUTPUT_RATE_HZ];
+    __dmb();  // Memory barrier for cross-core visibility
+}
 
 // Inter-core communication
 static queue_t g_pressure_queue;
@@ -268,10 +328,10 @@ static inline bool usb_is_suspended(void) {
            ((usb_hw->sie_status & USB_SIE_STATUS_SUSPENDED_BITS) != 0);
 }
 
-// I2C grace period after multicore lockout (flash save).
+// I2C grace period after multicore lockout (flash write).
 // Core 1's I2C transaction may be interrupted by lockout, causing transient
 // NaN readings on resume. These should not count toward over-range detection.
-static volatile uint8_t g_lockout_grace = 0;
+// Core 1 detects lockouts by watching flash_io_lockout_count().
 #define LOCKOUT_GRACE_SAMPLES  5  // ~50ms at 100Hz internal rate
 
 // Runtime-configurable parameters (via SysEx) — Core 0 only
@@ -279,35 +339,52 @@ static uint8_t g_led_brightness = LED_BRIGHTNESS;    // 0-100
 static volatile uint8_t g_noise_floor = 1;           // x1000 threshold (Core 1 reads)
 static uint8_t g_oversampling_ctrl = 5;              // 0=skip,1=x1,2=x2,3=x4,4=x8,5=x16
 static uint8_t g_iir_config = 1;                     // 0=off,1=x2,2=x4,3=x8,4=x16
+static uint32_t g_recorder_trigger_x1000 = 0;        // Recorder auto-start, 0 = off
+static volatile uint8_t g_dual_mode = DUAL_MODE_PRIMARY;  // Core 0 reads (DUAL_MODE_*)
+static bool g_pressure_stats = false;                // CMD_PRESSURE_STATS frames (not saved)
+static volatile bool g_sensor_auto = false;          // Oversampling/IIR chosen by sensor_autotune
+
+// Auto mode state — Core 0 only
+static int g_autotune_rate = 0;                      // Output rate of the last choice, 0 = retune
+static uint8_t g_autotune_passes = 0;                // Windows still to evaluate
+static autotune_measurement_t g_autotune_meas;       // Last window of the running config
+static bool g_autotune_have_meas = false;
+static autotune_result_t g_autotune_result;
 
 // Diagnostics counters (saturating increment helper)
 static inline void sat_inc_u16(volatile uint16_t *val) {
     if (*val < UINT16_MAX) (*val)++;
 }
 
-/// CRC32 (polynomial 0xEDB88320, same as zlib/PNG)
-static uint32_t crc32_compute(const uint8_t *data, size_t len) {
-    uint32_t crc = 0xFFFFFFFF;
-    for (size_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for (int j = 0; j < 8; j++) {
-            crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
-        }
-    }
-    return ~crc;
-}
-
 static volatile uint16_t g_sensor_error_count = 0;
 static volatile uint16_t g_overrange_event_count = 0;
-static volatile uint16_t g_i2c_recovery_count = 0;
-static volatile int16_t g_last_temperature_x100 = 0;  // From BMP280 t_fine
+static overrange_stats_t g_overrange_stats;  // Written by Core 1
+static volatile int16_t g_last_temperature_x100 = 0;  // From the latest valid sample
 static uint64_t g_boot_time_ms = 0;
 
-// I2C cross-core protection (Core 0 commands + Core 1 sensor reads)
-static mutex_t g_i2c_mutex;
+/// Stamp a boot phase the first time it is reached (ms since reset)
+static inline void boot_mark(uint32_t *phase) {
+    if (*phase == BOOT_TIME_PENDING) {
+        *phase = (uint32_t)(time_us_64() / 1000);
+    }
+}
+
+/// SENSOR_STATUS_* for device info
+static uint8_t sensor_status(void) {
+    if (g_sensor_ready) return SENSOR_STATUS_READY;
+    return g_sensor_starting ? SENSOR_STATUS_STARTING : SENSOR_STATUS_ABSENT;
+}
+
+// Core 1 skips sensor reads while Core 0 reconfigures (bus access itself is
+// serialized by sensor_bus)
 static volatile bool g_sensor_reconfiguring = false;
 
+// Bumped on every reconfiguration or reset: Core 1 starts a new auto-tune
+// window (a FIFO part is read too rarely to catch the flag itself)
+static volatile uint32_t g_sensor_config_gen = 0;
+
 static inline void set_sensor_reconfiguring(bool value) {
+    if (value) g_sensor_config_gen++;
     g_sensor_reconfiguring = value;
     __dmb();  // Memory barrier for cross-core visibility
 }
@@ -323,6 +400,9 @@ static volatile bool g_settings_dirty = false;
 static uint64_t g_settings_dirty_since_ms = 0;
 #define FLASH_SAVE_DEBOUNCE_MS  3000  // Save 3s after last change
 
+// flash_maint region id of the settings journal sectors
+static int g_settings_region = -1;
+
 /// Mark settings as needing to be saved (debounced)
 static void mark_settings_dirty(void) {
     g_settings_dirty = true;
@@ -364,6 +444,15 @@ static void led_init(void) {
     g_led_initialized = true;
 }
 
+/**
+ * @brief Keep the WS2812 bit time at 800 kHz after a clk_sys change
+ */
+static void led_retime(void) {
+    if (!g_led_initialized) return;
+    float div = (float)clock_get_hz(clk_sys) / (800000.0f * (ws2812_T1 + ws2812_T2 + ws2812_T3));
+    pio_sm_set_clkdiv(g_ws2812_pio, g_ws2812_sm, div);
+}
+
 static void led_set_state(led_state_t state) {
     uint8_t br = g_led_brightness;
     switch (state) {
@@ -378,36 +467,34 @@ static void led_set_state(led_state_t state) {
 
 // Forward declarations
 static bool pin_is_valid_format(const char *pin);
-static bool bmp280_apply_config(void);
+static bool sensor_apply_config(void);
 
-// Wear leveling: use 16 slots within the 4KB sector (256 bytes each)
-#define WEAR_LEVEL_SLOTS  (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)  // 16
-static int g_wear_slot = 0;  // Current active slot index
+// Legacy layout: 16 slots of 256 bytes within one 4KB sector
+#define LEGACY_SETTINGS_SLOTS  (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)  // 16
 
 /* ============================================================================
  * Flash Storage Functions
  * ========================================================================== */
 
-static const device_settings_t* flash_get_settings_ptr(void) {
-    return (const device_settings_t*)(XIP_BASE + FLASH_SETTINGS_OFFSET);
+static const device_settings_t* flash_get_legacy_settings_ptr(void) {
+    return (const device_settings_t*)flash_io_read_ptr(FLASH_LEGACY_SETTINGS_OFFSET);
 }
 
-/// Verify CRC32 of settings (legacy 0xFFFFFFFF accepted only if magic matches)
+/// Verify CRC32 of legacy settings (0xFFFFFFFF accepted only if magic matches)
 static bool flash_verify_crc(const device_settings_t *settings) {
     if (settings->crc32 == 0xFFFFFFFF) {
         return settings->magic == SETTINGS_MAGIC;
     }
-    uint32_t computed = crc32_compute((const uint8_t*)settings, 
-                                       sizeof(device_settings_t) - sizeof(uint32_t));
+    uint32_t computed = crc32_region(0, settings, sizeof(device_settings_t) - sizeof(uint32_t));
     return computed == settings->crc32;
 }
 
-/// Find the latest valid settings slot (wear leveling + CRC verification)
+/// Find the latest valid legacy settings slot (wear leveling + CRC verification)
 static int flash_find_active_slot(void) {
-    const device_settings_t *base = flash_get_settings_ptr();
+    const device_settings_t *base = flash_get_legacy_settings_ptr();
     // Scan all slots, find the last valid one (highest index)
     int active = -1;
-    for (int i = 0; i < WEAR_LEVEL_SLOTS; i++) {
+    for (int i = 0; i < (int)LEGACY_SETTINGS_SLOTS; i++) {
         if (base[i].magic == SETTINGS_MAGIC && flash_verify_crc(&base[i])) {
             active = i;
         }
@@ -415,105 +502,190 @@ static int flash_find_active_slot(void) {
     return active;
 }
 
-/// Build settings struct from current global state (for flash storage)
-static device_settings_t flash_build_settings(void) {
-    device_settings_t s = { .magic = SETTINGS_MAGIC };
-    strncpy(s.pin, g_device_pin, DEVICE_PIN_LEN);
-    s.pin[DEVICE_PIN_LEN] = '\0';
-    strncpy(s.name, g_device_name, DEVICE_NAME_MAX_LEN);
-    s.name[DEVICE_NAME_MAX_LEN] = '\0';
-    s.led_brightness = g_led_brightness;
-    s.noise_floor = g_noise_floor;
-    s.oversampling_ctrl = g_oversampling_ctrl;
-    s.iir_config = g_iir_config;
-    s.output_rate = g_output_rate;
-    s.pin_fail_count = (g_pin_fail_count <= 20) ? g_pin_fail_count : 20;
-    memset(s._config_reserved, 0xFF, sizeof(s._config_reserved));
-    memset(s._reserved, 0xFF, sizeof(s._reserved));
-    s.crc32 = crc32_compute((const uint8_t*)&s,
-                             sizeof(device_settings_t) - sizeof(uint32_t));
-    return s;
+/// Stage current global state into the settings journal.
+/// Only values that differ from the stored copy produce flash records.
+static void flash_build_settings(void) {
+    uint8_t pin_fail = (g_pin_fail_count <= 20) ? (uint8_t)g_pin_fail_count : 20;
+    uint8_t noise_floor = g_noise_floor;
+    uint8_t output_rate = (uint8_t)g_output_rate;
+    settings_journal_put(SETTING_KEY_PIN, g_device_pin, DEVICE_PIN_LEN);
+    settings_journal_put(SETTING_KEY_NAME, g_device_name, (uint8_t)strlen(g_device_name));
+    settings_journal_put(SETTING_KEY_LED_BRIGHTNESS, &g_led_brightness, 1);
+    settings_journal_put(SETTING_KEY_NOISE_FLOOR, &noise_floor, 1);
+    settings_journal_put(SETTING_KEY_OVERSAMPLING, &g_oversampling_ctrl, 1);
+    settings_journal_put(SETTING_KEY_IIR_CONFIG, &g_iir_config, 1);
+    settings_journal_put(SETTING_KEY_OUTPUT_RATE, &output_rate, 1);
+    settings_journal_put(SETTING_KEY_PIN_FAIL_COUNT, &pin_fail, 1);
+    settings_journal_put(SETTING_KEY_RECORDER_TRIGGER, &g_recorder_trigger_x1000,
+                         sizeof(g_recorder_trigger_x1000));
+    uint8_t dual_mode = g_dual_mode;
+    settings_journal_put(SETTING_KEY_DUAL_MODE, &dual_mode, 1);
+    uint8_t sensor_auto = g_sensor_auto ? 1 : 0;
+    settings_journal_put(SETTING_KEY_SENSOR_AUTO, &sensor_auto, 1);
+}
+
+/// Read a 1-byte setting from the journal, or fall back to a default
+static uint8_t settings_get_u8(uint8_t key, uint8_t fallback) {
+    uint8_t value;
+    return (settings_journal_get(key, &value, 1) == 1) ? value : fallback;
+}
+
+/// Copy values from a legacy slot into the globals (one-time migration)
+static void flash_import_legacy(const device_settings_t *settings) {
+    strncpy(g_device_name, settings->name, DEVICE_NAME_MAX_LEN);
+    g_device_name[DEVICE_NAME_MAX_LEN] = '\0';
+    strncpy(g_device_pin, settings->pin, DEVICE_PIN_LEN);
+    g_device_pin[DEVICE_PIN_LEN] = '\0';
+    g_led_brightness = settings->led_brightness;
+    g_noise_floor = settings->noise_floor;
+    g_oversampling_ctrl = settings->oversampling_ctrl;
+    g_iir_config = settings->iir_config;
+    g_output_rate = settings->output_rate;
+    g_pin_fail_count = settings->pin_fail_count;
 }
 
 static void flash_load_settings(void) {
-    int slot = flash_find_active_slot();
-    g_wear_slot = (slot >= 0) ? slot : 0;
-    
-    if (slot >= 0) {
-        const device_settings_t *settings = &flash_get_settings_ptr()[slot];
-        strncpy(g_device_name, settings->name, DEVICE_NAME_MAX_LEN);
-        g_device_name[DEVICE_NAME_MAX_LEN] = '\0';
-        strncpy(g_device_pin, settings->pin, DEVICE_PIN_LEN);
-        g_device_pin[DEVICE_PIN_LEN] = '\0';
-        // Guard against corrupted PIN in flash
-        if (!pin_is_valid_format(g_device_pin)) {
-            strncpy(g_device_pin, "0000", DEVICE_PIN_LEN);
-            g_device_pin[DEVICE_PIN_LEN] = '\0';
+    g_settings_region = flash_maint_add_region(FLASH_SETTINGS_OFFSET, SETTINGS_JOURNAL_SECTORS);
+    bool have_journal = settings_journal_init(FLASH_SETTINGS_OFFSET);
+    
+    if (have_journal) {
+        int len = settings_journal_get(SETTING_KEY_NAME, g_device_name, DEVICE_NAME_MAX_LEN);
+        if (len > 0) {
+            g_device_name[(len < DEVICE_NAME_MAX_LEN) ? len : DEVICE_NAME_MAX_LEN] = '\0';
+        } else {
+            strncpy(g_device_name, "DiveChecker", DEVICE_NAME_MAX_LEN);
+            g_device_name[DEVICE_NAME_MAX_LEN] = '\0';
         }
-        // Load runtime config (validate each field)
-        g_led_brightness = (settings->led_brightness <= 100) ? settings->led_brightness : LED_BRIGHTNESS;
-        g_noise_floor = (settings->noise_floor <= 50) ? settings->noise_floor : 1;
-        g_oversampling_ctrl = (settings->oversampling_ctrl <= 5) ? settings->oversampling_ctrl : 5;
-        g_iir_config = (settings->iir_config <= 4) ? settings->iir_config : 1;
-        if (settings->output_rate >= MIN_OUTPUT_RATE_HZ && settings->output_rate <= MAX_OUTPUT_RATE_HZ) {
-            g_output_rate = settings->output_rate;
-            g_output_interval_ms = 1000 / g_output_rate;
-            g_samples_per_output = INTERNAL_SAMPLE_RATE_HZ / g_output_rate;
+        if (settings_journal_get(SETTING_KEY_PIN, g_device_pin, DEVICE_PIN_LEN) != DEVICE_PIN_LEN) {
+            memcpy(g_device_pin, "0000", DEVICE_PIN_LEN);
         }
-        // Restore PIN lockout state
-        g_pin_fail_count = (settings->pin_fail_count <= 20) ? settings->pin_fail_count : 0;
-        if (g_pin_fail_count >= PIN_MAX_FAILURES) {
-            // Recalculate lockout time based on fail count
-            int shift = g_pin_fail_count - PIN_MAX_FAILURES;
-            if (shift > 6) shift = 6;
-            int delay_sec = 1 << shift;
-            if (delay_sec > PIN_LOCKOUT_MAX_SEC) delay_sec = PIN_LOCKOUT_MAX_SEC;
-            g_pin_lockout_until = make_timeout_time_ms(delay_sec * 1000);
+        g_device_pin[DEVICE_PIN_LEN] = '\0';
+        g_led_brightness = settings_get_u8(SETTING_KEY_LED_BRIGHTNESS, LED_BRIGHTNESS);
+        g_noise_floor = settings_get_u8(SETTING_KEY_NOISE_FLOOR, 1);
+        g_oversampling_ctrl = settings_get_u8(SETTING_KEY_OVERSAMPLING, 5);
+        g_iir_config = settings_get_u8(SETTING_KEY_IIR_CONFIG, 1);
+        g_output_rate = settings_get_u8(SETTING_KEY_OUTPUT_RATE, DEFAULT_OUTPUT_RATE_HZ);
+        g_pin_fail_count = settings_get_u8(SETTING_KEY_PIN_FAIL_COUNT, 0);
+        if (settings_journal_get(SETTING_KEY_RECORDER_TRIGGER, &g_recorder_trigger_x1000,
+                                 sizeof(g_recorder_trigger_x1000)) != sizeof(g_recorder_trigger_x1000)) {
+            g_recorder_trigger_x1000 = 0;
         }
+        g_dual_mode = settings_get_u8(SETTING_KEY_DUAL_MODE, DUAL_MODE_PRIMARY);
+        g_sensor_auto = settings_get_u8(SETTING_KEY_SENSOR_AUTO, 0) == 1;
     } else {
-        strncpy(g_device_name, "DiveChecker", DEVICE_NAME_MAX_LEN);
-        g_device_name[DEVICE_NAME_MAX_LEN] = '\0';
+        int slot = flash_find_active_slot();
+        if (slot >= 0) {
+            flash_import_legacy(&flash_get_legacy_settings_ptr()[slot]);
+        } else {
+            strncpy(g_device_name, "DiveChecker", DEVICE_NAME_MAX_LEN);
+            g_device_name[DEVICE_NAME_MAX_LEN] = '\0';
+            memcpy(g_device_pin, "0000", DEVICE_PIN_LEN);
+            g_device_pin[DEVICE_PIN_LEN] = '\0';
+        }
+    }
+    
+    // Guard against corrupted values in flash (validate each field)
+    if (!pin_is_valid_format(g_device_pin)) {
         strncpy(g_device_pin, "0000", DEVICE_PIN_LEN);
         g_device_pin[DEVICE_PIN_LEN] = '\0';
     }
-    
-    // Boot-time sector compaction: if the next save would require a sector
-    // erase (~100-400ms blocking both cores), do it NOW before Core 1 starts.
-    // At this point no sensor data is flowing, so the erase cost is invisible.
-    // This guarantees all runtime saves are write-only (~1ms, no data gaps).
-    if (g_wear_slot == WEAR_LEVEL_SLOTS - 1) {
-        device_settings_t compact = flash_build_settings();
-        uint32_t irq = save_and_disable_interrupts();
-        flash_range_erase(FLASH_SETTINGS_OFFSET, FLASH_SECTOR_SIZE);
-        flash_range_program(FLASH_SETTINGS_OFFSET,
-                            (const uint8_t*)&compact, FLASH_PAGE_SIZE);
-        restore_interrupts(irq);
-        g_wear_slot = 0;
+    if (g_led_brightness > 100) g_led_brightness = LED_BRIGHTNESS;
+    if (g_noise_floor > 50) g_noise_floor = 1;
+    if (g_oversampling_ctrl > 5) g_oversampling_ctrl = 5;
+    if (g_iir_config > 4) g_iir_config = 1;
+    if (g_dual_mode > DUAL_MODE_BOTH) g_dual_mode = DUAL_MODE_PRIMARY;
+    if (g_output_rate < MIN_OUTPUT_RATE_HZ || g_output_rate > MAX_OUTPUT_RATE_HZ) {
+        g_output_rate = DEFAULT_OUTPUT_RATE_HZ;
     }
-}
-
-static void flash_save_settings(void) {
-    device_settings_t new_settings = flash_build_settings();
+    output_rate_set(g_output_rate);
     
-    int next_slot = (g_wear_slot + 1) % WEAR_LEVEL_SLOTS;
-    bool need_erase = (next_slot == 0);
+    // Restore PIN lockout state
+    if (g_pin_fail_count > 20) g_pin_fail_count = 0;
+    if (g_pin_fail_count >= PIN_MAX_FAILURES) {
+        // Recalculate lockout time based on fail count
+        int shift = g_pin_fail_count - PIN_MAX_FAILURES;
+        if (shift > 6) shift = 6;
+        int delay_sec = 1 << shift;
+        if (delay_sec > PIN_LOCKOUT_MAX_SEC) delay_sec = PIN_LOCKOUT_MAX_SEC;
+        g_pin_lockout_until = make_timeout_time_ms(delay_sec * 1000);
+    }
     
-    // Core 1 executes from flash (XIP) — must pause it during flash ops.
-    // Thanks to boot-time compaction, need_erase is false for the first
-    // 15 saves per boot cycle, keeping lockout to ~1ms (write-only).
-    multicore_lockout_start_blocking();
-    uint32_t irq_state = save_and_disable_interrupts();
-    if (need_erase) {
-        flash_range_erase(FLASH_SETTINGS_OFFSET, FLASH_SECTOR_SIZE);
+    // First boot or migration: write the full key set into a fresh journal.
+    // Records are committed before the header, so losing power here simply
+    // repeats the migration from the untouched legacy slots on next boot.
+    if (!have_journal) {
+        flash_build_settings();
+        settings_journal_commit();
     }
-    flash_range_program(FLASH_SETTINGS_OFFSET + next_slot * FLASH_PAGE_SIZE,
-                        (const uint8_t*)&new_settings, FLASH_PAGE_SIZE);
-    restore_interrupts(irq_state);
-    multicore_lockout_end_blocking();
     
-    __dmb();  // Ensure Core 1 sees the grace counter before processing resumes
-    g_lockout_grace = LOCKOUT_GRACE_SAMPLES;
-    g_wear_slot = next_slot;
+    // Boot-time erase: the retired journal sector (or the legacy slots once
+    // migrated) is erased NOW, before Core 1 starts and no sensor data is
+    // flowing, so the erase cost is invisible. Later erases are deferred to
+    // idle periods by flash_maint_task() in the main loop.
+    flash_maint_erase_region(g_settings_region);
+}
+
+/* ============================================================================
+ * Bulk Transfer Objects
+ * ========================================================================== */
+
+static uint32_t bulk_object_size(uint8_t object) {
+    switch (object) {
+        case BULK_OBJECT_RECORDER: return recorder_page_count() * RECORDER_PAGE_SIZE;
+        case BULK_OBJECT_CAPTURE:  return capture_size();
+        default:                   return 0;
+    }
+}
+
+static uint32_t bulk_object_read(uint8_t object, uint32_t offset, uint8_t *dst, uint32_t len) {
+    switch (object) {
+        case BULK_OBJECT_RECORDER: return recorder_read(offset, dst, len);
+        case BULK_OBJECT_CAPTURE:  return capture_read(offset, dst, len);
+        default:                   return 0;
+    }
+}
+
+static bool bulk_object_available(uint8_t object) {
+    switch (object) {
+        // Page indices shift if a recording wraps the ring mid-download;
+        // a session that starts later aborts the transfer (recorder_feed)
+        case BULK_OBJECT_RECORDER: return !recorder_is_recording();
+        case BULK_OBJECT_CAPTURE:  return capture_size() > 0;
+        default:                   return false;
+    }
+}
+
+/// Feed the recorder; a trigger that opens a session stops a recorder
+/// download, whose page offsets the new session would move
+static void recorder_feed(int32_t value_x1000, uint32_t now_ms, uint16_t interval_ms) {
+    bool was_recording = recorder_is_recording();
+    recorder_append(value_x1000, now_ms, interval_ms);
+    if (!was_recording && recorder_is_recording() && bulk_active_object(BULK_OBJECT_RECORDER)) {
+        bulk_abort();
+    }
+}
+
+static uint32_t bulk_now_ms(void) {
+    return (uint32_t)(time_us_64() / 1000);
+}
+
+static const bulk_io_t g_bulk_io = {
+    .size = bulk_object_size,
+    .read = bulk_object_read,
+    .send = midi_sysex_send_bulk,
+    .now_ms = bulk_now_ms,
+    .available = bulk_object_available,
+    .cmd_info = CMD_BULK_INFO,
+    .cmd_data = CMD_BULK_DATA,
+};
+
+static void flash_save_settings(void) {
+    PROF_BEGIN(prof_t0);
+    // Append only changed keys (a few bytes each). Program-only, so Core 1
+    // lockout stays ~1ms; the sector erase happens later when idle.
+    flash_build_settings();
+    settings_journal_commit();
+    PROF_END(prof_t0, PROF_FLASH_SAVE);
 }
 
 /* ============================================================================
@@ -705,303 +877,155 @@ static bool ecdsa_init(void) {
 }
 
 /* ============================================================================
- * I2C Helper Functions (with timeout and bus recovery for EMC)
+ * Sensor Functions (driver interface in sensor.h)
  * ========================================================================== */
 
-// I2C timeout in microseconds (50ms should be plenty for 400kHz)
-#define I2C_TIMEOUT_US      50000
+static sensor_config_t sensor_current_config(void) {
+    return (sensor_config_t){
+        .oversampling = g_oversampling_ctrl,
+        .iir = g_iir_config,
+        .rate_hz = INTERNAL_SAMPLE_RATE_HZ,
+    };
+}
 
 /**
- * @brief Recover I2C bus from stuck state (SDA held low)
- * @details Generates clock pulses to release stuck slave devices
+ * @brief Probe, reset and configure whichever supported sensor answers
  */
-static void i2c_bus_recover(void) {
-    // Temporarily disable I2C function on pins
-    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_SIO);
-    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_SIO);
-    
-    gpio_set_dir(I2C_SDA_PIN, GPIO_IN);
-    gpio_set_dir(I2C_SCL_PIN, GPIO_OUT);
-    gpio_pull_up(I2C_SDA_PIN);
-    
-    // Generate 9 clock pulses to release any stuck slave
-    for (int i = 0; i < 9; i++) {
-        gpio_put(I2C_SCL_PIN, 0);
-        sleep_us(5);
-        gpio_put(I2C_SCL_PIN, 1);
-        sleep_us(5);
-        
-        // Check if SDA is released
-        if (gpio_get(I2C_SDA_PIN)) {
-            break;
-        }
-    }
-    
-    // Generate STOP condition
-    gpio_set_dir(I2C_SDA_PIN, GPIO_OUT);
-    gpio_put(I2C_SDA_PIN, 0);
-    sleep_us(5);
-    gpio_put(I2C_SCL_PIN, 1);
-    sleep_us(5);
-    gpio_put(I2C_SDA_PIN, 1);
-    sleep_us(5);
-    
-    // Restore I2C function
-    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA_PIN);
-    gpio_pull_up(I2C_SCL_PIN);
-}
-
-static bool i2c_write_register(uint8_t reg, uint8_t value) {
-    mutex_enter_blocking(&g_i2c_mutex);
-    uint8_t buf[2] = {reg, value};
-    int ret = i2c_write_timeout_us(I2C_PORT, BMP280_I2C_ADDR, buf, 2, false, I2C_TIMEOUT_US);
-    if (ret < 0) {
-        i2c_bus_recover();
-        sat_inc_u16(&g_i2c_recovery_count);
-        mutex_exit(&g_i2c_mutex);
-        return false;
-    }
-    mutex_exit(&g_i2c_mutex);
-    return true;
-}
-
-static bool i2c_read_registers(uint8_t start_reg, uint8_t *buffer, size_t len) {
-    mutex_enter_blocking(&g_i2c_mutex);
-    int ret = i2c_write_timeout_us(I2C_PORT, BMP280_I2C_ADDR, &start_reg, 1, true, I2C_TIMEOUT_US);
-    if (ret < 0) {
-        i2c_bus_recover();
-        sat_inc_u16(&g_i2c_recovery_count);
-        mutex_exit(&g_i2c_mutex);
-        return false;
-    }
-    ret = i2c_read_timeout_us(I2C_PORT, BMP280_I2C_ADDR, buffer, len, false, I2C_TIMEOUT_US);
-    if (ret < 0) {
-        i2c_bus_recover();
-        sat_inc_u16(&g_i2c_recovery_count);
-        mutex_exit(&g_i2c_mutex);
-        return false;
-    }
-    mutex_exit(&g_i2c_mutex);
-    return true;
+static bool sensor_start(void) {
+    sensor_config_t config = sensor_current_config();
+    return sensor_open(&g_sensor, SENSOR_I2C_ADDR, &config);
 }
 
-/* ============================================================================
- * BMP280 Sensor Functions
- * ========================================================================== */
-
-static bool bmp280_init(void) {
-    uint8_t chip_id;
-    if (!i2c_read_registers(BMP280_REG_ID, &chip_id, 1)) {
-        #if CFG_TUD_CDC
-        printf("ERR:I2C read chip ID failed\n");
-        #endif
-        return false;
-    }
-    
-    #if CFG_TUD_CDC
-    printf("INFO:ChipID=0x%02X", chip_id);
-    if (chip_id == BMP280_CHIP_ID) {
-        printf(" (BMP280)\n");
-    } else if (chip_id == BME280_CHIP_ID) {
-        printf(" (BME280)\n");
-    } else {
-        printf(" (Unknown)\n");
-    }
-    #endif
-    if (chip_id != BMP280_CHIP_ID && chip_id != BME280_CHIP_ID) {
-        return false;
-    }
-    
-    // Soft reset
-    if (!i2c_write_register(BMP280_REG_RESET, BMP280_RESET_VALUE)) {
-        return false;
-    }
-    sleep_ms(10);
-    
-    // Read calibration data
-    uint8_t calib_raw[BMP280_CALIB_LEN];
-    if (!i2c_read_registers(BMP280_REG_CALIB_START, calib_raw, BMP280_CALIB_LEN)) {
-        #if CFG_TUD_CDC
-        printf("ERR:Failed to read calibration data\n");
-        #endif
-        return false;
-    }
-    
-    // Parse calibration (little-endian 16-bit values)
-    g_calib.dig_T1 = calib_raw[0]  | (calib_raw[1]  << 8);
-    g_calib.dig_T2 = calib_raw[2]  | (calib_raw[3]  << 8);
-    g_calib.dig_T3 = calib_raw[4]  | (calib_raw[5]  << 8);
-    g_calib.dig_P1 = calib_raw[6]  | (calib_raw[7]  << 8);
-    g_calib.dig_P2 = calib_raw[8]  | (calib_raw[9]  << 8);
-    g_calib.dig_P3 = calib_raw[10] | (calib_raw[11] << 8);
-    g_calib.dig_P4 = calib_raw[12] | (calib_raw[13] << 8);
-    g_calib.dig_P5 = calib_raw[14] | (calib_raw[15] << 8);
-    g_calib.dig_P6 = calib_raw[16] | (calib_raw[17] << 8);
-    g_calib.dig_P7 = calib_raw[18] | (calib_raw[19] << 8);
-    g_calib.dig_P8 = calib_raw[20] | (calib_raw[21] << 8);
-    g_calib.dig_P9 = calib_raw[22] | (calib_raw[23] << 8);
-    
-    // BMP280 requires config to be written in sleep mode FIRST
-    // Step 1: Ensure sleep mode (after reset, already in sleep)
-    if (!i2c_write_register(BMP280_REG_CTRL_MEAS, 0x00)) return false;
-    sleep_ms(5);
-    
-    // Step 2: Write config register (IIR filter) while in sleep mode
-    if (!i2c_write_register(BMP280_REG_CONFIG, BMP280_CONFIG_FILTERED)) return false;
-    sleep_ms(5);
-    
-    // Step 3: Write ctrl_meas to enable measurements and start normal mode
-    // Stable: osrs_t=001 (x1), osrs_p=101 (x16), mode=11 (normal) = 0x57
-    if (!i2c_write_register(BMP280_REG_CTRL_MEAS, BMP280_CTRL_STABLE)) return false;
-    sleep_ms(50);  // Wait for first measurement
-    
-    // Verify registers were written correctly
-    uint8_t ctrl_meas_read = 0, config_read = 0;
-    i2c_read_registers(BMP280_REG_CTRL_MEAS, &ctrl_meas_read, 1);
-    i2c_read_registers(BMP280_REG_CONFIG, &config_read, 1);
-    #if CFG_TUD_CDC
-    printf("INFO:CTRL_MEAS=0x%02X CONFIG=0x%02X (X16+IIR2)\n", ctrl_meas_read, config_read);
-    #endif
-    
-    return true;
+/**
+ * @brief Probe the optional second sensor (boot only: it is either fitted
+ *        or not, and probing an empty address costs a bus timeout)
+ */
+static bool sensor_start_secondary(void) {
+    sensor_config_t config = sensor_current_config();
+    return sensor_open(&g_sensor2, SENSOR_I2C_ADDR_2, &config);
 }
 
 /**
- * @brief Reinitialize BMP280 config (clears IIR filter state)
+ * @brief Reinitialize a sensor (clears IIR filter state)
  * @details Called after over-range recovery to flush saturated values
  *          from the sensor's internal IIR filter
  */
-static bool bmp280_reinit_config(void) {
+static bool sensor_reinit(sensor_t *s) {
     // Prevent concurrent reconfiguration from both cores
     if (g_sensor_reconfiguring) return false;
     set_sensor_reconfiguring(true);  // Signal Core 1 to skip reads
-    
-    // Soft reset clears all internal registers including IIR filter
-    if (!i2c_write_register(BMP280_REG_RESET, BMP280_RESET_VALUE)) {
-        set_sensor_reconfiguring(false);
-        return false;
-    }
-    sleep_ms(10);
-    
-    // Re-apply configuration (must be done in sleep mode)
-    if (!i2c_write_register(BMP280_REG_CTRL_MEAS, 0x00)) {
-        set_sensor_reconfiguring(false);
-        return false;
-    }
-    sleep_ms(2);
-    if (!i2c_write_register(BMP280_REG_CONFIG, BMP280_CONFIG_FILTERED)) {
-        set_sensor_reconfiguring(false);
-        return false;
-    }
-    sleep_ms(2);
-    if (!i2c_write_register(BMP280_REG_CTRL_MEAS, BMP280_CTRL_STABLE)) {
-        set_sensor_reconfiguring(false);
-        return false;
-    }
-    sleep_ms(50);  // Wait for first clean measurement
-    
+    bool ok = sensor_reset(s);
     set_sensor_reconfiguring(false);
-    
-    // Re-apply user-configured oversampling and IIR settings
-    return bmp280_apply_config();
+    if (ok) sat_inc_u16(&g_sensor_health[s == &g_sensor2 ? 1 : 0].resets);
+    return ok;
+}
+
+/**
+ * @brief Primary sensor's IIR filter off (on) or back on, without a reset
+ * @details Guarded like sensor_reinit(); a configuration applied by Core 0
+ *          meanwhile brings the filter back on its own
+ */
+static bool sensor_set_filter_bypass(bool on) {
+    if (g_sensor_reconfiguring) return false;
+    set_sensor_reconfiguring(true);  // Autotune window must not span it
+    bool ok = sensor_filter_bypass(&g_sensor, on);
+    set_sensor_reconfiguring(false);
+    return ok;
 }
 
 /**
- * @brief Apply dynamic BMP280 configuration (oversampling + IIR filter)
- * @details Uses g_oversampling_ctrl and g_iir_config global variables
- *          Must put sensor in sleep mode before changing config registers
+ * @brief Apply dynamic sensor configuration (oversampling + IIR filter)
+ * @details Uses g_oversampling_ctrl and g_iir_config global variables;
+ *          both sensors always run the same configuration
  */
-static bool bmp280_apply_config(void) {
+static bool sensor_apply_config(void) {
     set_sensor_reconfiguring(true);  // Signal Core 1 to skip reads
-    
-    uint8_t osrs = g_oversampling_ctrl;
-    uint8_t iir = g_iir_config;
-    if (osrs > 5) osrs = 5;
-    if (iir > 4) iir = 4;
-    
-    // ctrl_meas: osrs_t[7:5]=x2(0b010), osrs_p[4:2]=variable, mode[1:0]=normal(0b11)
-    uint8_t ctrl_meas = (0x02 << 5) | (osrs << 2) | 0x03;
-    // config: t_sb[7:5]=0.5ms(0b000), filter[4:2]=variable, spi3w_en=0
-    uint8_t config_reg = (iir << 2);
-    
-    // Enter sleep mode first
-    if (!i2c_write_register(BMP280_REG_CTRL_MEAS, 0x00)) {
-        set_sensor_reconfiguring(false);
-        return false;
+    sensor_config_t config = sensor_current_config();
+    bool ok = sensor_configure(&g_sensor, &config);
+    if (g_sensor2_ready && !sensor_configure(&g_sensor2, &config)) {
+        sat_inc_u16(&g_sensor_health[1].bus_errors);
     }
-    sleep_ms(2);
-    
-    // Apply config (only writable in sleep mode)
-    if (!i2c_write_register(BMP280_REG_CONFIG, config_reg)) {
-        set_sensor_reconfiguring(false);
-        return false;
-    }
-    sleep_ms(2);
-    
-    // Back to normal mode with new oversampling
-    if (!i2c_write_register(BMP280_REG_CTRL_MEAS, ctrl_meas)) {
-        set_sensor_reconfiguring(false);
-        return false;
-    }
-    sleep_ms(50);  // Wait for first measurement with new config
-    
     set_sensor_reconfiguring(false);
-    return true;
+    return ok;
 }
 
-static float bmp280_read_pressure(void) {
-    uint8_t data[6] = {0};
-    if (!i2c_read_registers(BMP280_REG_PRESS_MSB, data, 6)) {
-        return NAN;  // I2C read failed - signal invalid reading
+/**
+ * @brief How often Core 1 drains a FIFO sensor
+ * @details Once per output frame (the fewest transactions that still feed
+ *          every frame), but well before the FIFO or one read_batch fills
+ */
+static uint32_t sensor_drain_interval_us(const sensor_caps_t *caps, const output_rate_t *rate) {
+    uint32_t us = rate->interval_us;
+    uint32_t depth = caps->fifo_samples / 2;
+    if (depth > SENSOR_BATCH_MAX) depth = SENSOR_BATCH_MAX;
+    if (us > depth * caps->period_us) us = depth * caps->period_us;
+    return (us < SAMPLE_INTERVAL_US) ? SAMPLE_INTERVAL_US : us;
+}
+
+/**
+ * @brief Enter or leave auto mode (CMD_SET_OVERSAMPLING)
+ * @details Entering retunes at once from the last measurement, if any;
+ *          leaving keeps whatever was chosen until the host sets values
+ */
+static void sensor_set_auto(bool enable) {
+    g_sensor_auto = enable;
+    g_autotune_rate = 0;
+    g_autotune_passes = enable ? AUTOTUNE_PASSES : 0;
+}
+
+/**
+ * @brief Core 0: collect auto-tune measurements and, in auto mode, retune
+ * @details A retune evaluates AUTOTUNE_PASSES windows: the first choice
+ *          comes from the old configuration, the next one re-checks it
+ *          with its own measured conversion rate. Output rate changes
+ *          start over. The choice is not persisted separately: it is the
+ *          running oversampling/IIR, saved with the other settings.
+ */
+static void sensor_autotune_task(void) {
+    if (!g_sensor_ready || g_sensor_reconfiguring) return;
+    
+    bool retune = false;
+    autotune_measurement_t m;
+    if (autotune_take_measurement(&m)) {
+        m.config = sensor_current_config();
+        g_autotune_meas = m;
+        g_autotune_have_meas = true;
+        if (g_autotune_passes > 0) {
+            g_autotune_passes--;
+            retune = true;
+        }
     }
-    
-    // Parse 20-bit ADC values
-    int32_t adc_P = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
-    int32_t adc_T = ((int32_t)data[3] << 12) | ((int32_t)data[4] << 4) | (data[5] >> 4);
-    
-    // ADC saturation check: 0x80000 means measurement was skipped/invalid
-    if (adc_P == 0x80000 || adc_T == 0x80000) {
-        return NAN;
+    if (!g_sensor_auto) return;
+    if (g_output_rate != g_autotune_rate) {
+        g_autotune_rate = g_output_rate;
+        g_autotune_passes = AUTOTUNE_PASSES;
+        retune = true;
     }
-    
-    // Temperature compensation (required for accurate pressure)
-    int32_t var1 = ((((adc_T >> 3) - ((int32_t)g_calib.dig_T1 << 1))) * 
-                    ((int32_t)g_calib.dig_T2)) >> 11;
-    int32_t var2 = (((((adc_T >> 4) - ((int32_t)g_calib.dig_T1)) * 
-                      ((adc_T >> 4) - ((int32_t)g_calib.dig_T1))) >> 12) * 
-                    ((int32_t)g_calib.dig_T3)) >> 14;
-    g_calib.t_fine = var1 + var2;
-    
-    // Store temperature for CMD_GET_TEMPERATURE (in °C x100)
-    g_last_temperature_x100 = (int16_t)((g_calib.t_fine * 5 + 128) >> 8);
-    
-    // Pressure compensation (64-bit arithmetic for precision)
-    int64_t p_var1 = ((int64_t)g_calib.t_fine) - 128000;
-    int64_t p_var2 = p_var1 * p_var1 * (int64_t)g_calib.dig_P6;
-    p_var2 += (p_var1 * (int64_t)g_calib.dig_P5) << 17;
-    p_var2 += ((int64_t)g_calib.dig_P4) << 35;
-    p_var1 = ((p_var1 * p_var1 * (int64_t)g_calib.dig_P3) >> 8) + 
-             ((p_var1 * (int64_t)g_calib.dig_P2) << 12);
-    p_var1 = ((((int64_t)1) << 47) + p_var1) * ((int64_t)g_calib.dig_P1) >> 33;
-    
-    if (p_var1 == 0) return NAN;  // Corrupt calibration data
-    
-    int64_t p = 1048576 - adc_P;
-    p = (((p << 31) - p_var2) * 3125) / p_var1;
-    p_var1 = (((int64_t)g_calib.dig_P9) * (p >> 13) * (p >> 13)) >> 25;
-    p_var2 = (((int64_t)g_calib.dig_P8) * p) >> 19;
-    p = ((p + p_var1 + p_var2) >> 8) + (((int64_t)g_calib.dig_P7) << 4);
-    
-    float pressure_hpa = (float)p / 25600.0f;  // Convert to hPa
-    
-    // Range validation: BMP280 only guarantees accuracy within 300-1100 hPa
-    if (pressure_hpa < BMP280_PRESSURE_MIN_HPA || pressure_hpa > BMP280_PRESSURE_MAX_HPA) {
-        return NAN;  // Out of valid range
+    if (!retune) return;
+    
+    sensor_config_t current = sensor_current_config();
+    autotune_choose(&g_sensor, g_autotune_have_meas ? &g_autotune_meas : NULL, &current,
+                    g_rate->interval_us, &g_autotune_result);
+    if (g_autotune_result.config.oversampling == g_oversampling_ctrl &&
+        g_autotune_result.config.iir == g_iir_config) {
+        return;
     }
     
-    return pressure_hpa;
+    #if CFG_TUD_CDC
+    printf("INFO:Auto sensor config osrs=%u iir=%u (%lu us/conversion)\n",
+           g_autotune_result.config.oversampling, g_autotune_result.config.iir,
+           (unsigned long)g_autotune_result.period_us);
+    #endif
+    g_oversampling_ctrl = g_autotune_result.config.oversampling;
+    g_iir_config = g_autotune_result.config.iir;
+    if (sensor_apply_config()) {
+        mark_settings_dirty();
+    } else {
+        sat_inc_u16(&g_sensor_error_count);
+    }
+    // A window published just before the change describes the old config
+    autotune_take_measurement(&m);
+    g_autotune_have_meas = false;
 }
 
 /* ============================================================================
@@ -1011,10 +1035,14 @@ static float bmp280_read_pressure(void) {
 // Forward declaration for serial number setup
 extern void usb_set_serial_number(const char* serial);
 
+_Static_assert(CMD_LAST < PROFILER_SYSEX_SLOTS,
+               "every SysEx command needs its own profiler slot");
+
 /**
  * @brief Process received MIDI SysEx message
  */
 static void midi_process_sysex(sysex_message_t* msg) {
+    PROF_BEGIN(prof_t0);
     uint64_t now_ms = time_us_64() / 1000;
     
     switch (msg->command) {
@@ -1031,7 +1059,7 @@ static void midi_process_sysex(sysex_message_t* msg) {
             
         case CMD_REQUEST_INFO:
             midi_sysex_send_device_info(g_serial_number, g_device_name, 
-                                         FW_VERSION_STRING, g_sensor_ready);
+                                         FW_VERSION_STRING, sensor_status());
             break;
             
         case CMD_RESET_BASELINE:
@@ -1043,13 +1071,7 @@ static void midi_process_sysex(sysex_message_t* msg) {
             if (msg->data_len >= 1) {
                 int rate = msg->data[0];
                 if (rate >= MIN_OUTPUT_RATE_HZ && rate <= MAX_OUTPUT_RATE_HZ) {
-                    int new_interval = 1000 / rate;
-                    int new_samples = INTERNAL_SAMPLE_RATE_HZ / rate;
-                    g_output_rate = rate;
-                    __dmb();
-                    g_output_interval_ms = new_interval;
-                    g_samples_per_output = new_samples;
-                    __dmb();
+                    output_rate_set(rate);
                     flash_save_settings();
                 }
                 midi_sysex_send_config(g_output_rate);
@@ -1085,7 +1107,7 @@ static void midi_process_sysex(sysex_message_t* msg) {
             }
             // Send updated device info
             midi_sysex_send_device_info(g_serial_number, g_device_name,
-                                         FW_VERSION_STRING, g_sensor_ready);
+                                         FW_VERSION_STRING, sensor_status());
             break;
             
         case CMD_SET_PIN:
@@ -1137,7 +1159,8 @@ static void midi_process_sysex(sysex_message_t* msg) {
                     break;
                 }
                 
-                // Sign and send response
+                // Sign and send response (key setup included) at full clock
+                power_profile_t power_token = power_enter(POWER_PROFILE_CRYPTO);
                 if (!g_ecdsa_initialized) {
                     ecdsa_init();
                 }
@@ -1163,9 +1186,11 @@ static void midi_process_sysex(sysex_message_t* msg) {
                     // Sign
                     uint8_t sig[MBEDTLS_ECDSA_MAX_LEN];
                     size_t sig_len = 0;
+                    PROF_BEGIN(prof_sign_t0);
                     int ret = mbedtls_ecdsa_write_signature(&g_ecdsa_ctx, MBEDTLS_MD_SHA256,
                                                             hash, 32, sig, sizeof(sig), &sig_len,
                                                             mbedtls_ctr_drbg_random, &g_ctr_drbg);
+                    PROF_END(prof_sign_t0, PROF_ECDSA_SIGN);
                     if (ret == 0) {
                         midi_sysex_send_auth_response(sig, sig_len);
                     } else {
@@ -1179,16 +1204,28 @@ static void midi_process_sysex(sysex_message_t* msg) {
                 } else {
                     midi_sysex_send_ack(CMD_AUTH_CHALLENGE, 0x03);  // ECDSA not initialized
                 }
+                power_leave(power_token);
             } else {
                 midi_sysex_send_ack(CMD_AUTH_CHALLENGE, 0x01);  // Invalid data length
             }
             break;
             
-        case CMD_GET_CONFIG:
+        case CMD_GET_CONFIG: {
+            sensor_caps_t caps;
+            sensor_get_caps(&g_sensor, &caps);
+            full_config_auto_t autotune = {
+                .enabled = g_sensor_auto,
+                .period_us = g_autotune_have_meas ? g_autotune_meas.period_us : caps.period_us,
+                .conversion_noise_mpa = g_autotune_have_meas
+                    ? (uint32_t)(sqrtf(g_autotune_meas.noise_var_hpa2) * 100000.0f) : 0,
+                .frame_noise_mpa = g_sensor_auto
+                    ? (uint32_t)(g_autotune_result.frame_noise_hpa * 100000.0f) : 0,
+            };
             midi_sysex_send_full_config(g_output_rate, g_led_brightness,
                                          g_noise_floor, g_oversampling_ctrl,
-                                         g_iir_config);
+                                         g_iir_config, &autotune);
             break;
+        }
             
         case CMD_SET_LED:
             if (msg->data_len >= 1) {
@@ -1207,7 +1244,10 @@ static void midi_process_sysex(sysex_message_t* msg) {
             break;
             
         case CMD_RESET_SENSOR:
-            if (bmp280_reinit_config()) {
+            if (g_sensor2_ready) {
+                sensor_reinit(&g_sensor2);  // Best effort: the status reflects 0x76
+            }
+            if (sensor_reinit(&g_sensor)) {
                 g_sensor_ready = true;
                 midi_sysex_send_ack(CMD_RESET_SENSOR, 0x00);
             } else {
@@ -1239,16 +1279,19 @@ static void midi_process_sysex(sysex_message_t* msg) {
                     g_noise_floor = 1;
                     g_oversampling_ctrl = 5;
                     g_iir_config = 1;
-                    g_output_rate = DEFAULT_OUTPUT_RATE_HZ;
-                    g_output_interval_ms = 1000 / DEFAULT_OUTPUT_RATE_HZ;
-                    g_samples_per_output = INTERNAL_SAMPLE_RATE_HZ / DEFAULT_OUTPUT_RATE_HZ;
+                    output_rate_set(DEFAULT_OUTPUT_RATE_HZ);
+                    g_recorder_trigger_x1000 = 0;
+                    recorder_set_trigger(0);
+                    g_dual_mode = DUAL_MODE_PRIMARY;
+                    g_pressure_stats = false;
+                    g_sensor_auto = false;
                     flash_save_settings();  // Save with all defaults
                     // Re-apply sensor config
-                    bmp280_apply_config();
+                    sensor_apply_config();
                     midi_sysex_send_ack(CMD_FACTORY_RESET, 0x00);
                     // Send updated info
                     midi_sysex_send_device_info(g_serial_number, g_device_name,
-                                                 FW_VERSION_STRING, g_sensor_ready);
+                                                 FW_VERSION_STRING, sensor_status());
                 } else {
                     pin_record_failure();
                     midi_sysex_send_ack(CMD_FACTORY_RESET, 0x02);  // Auth required
@@ -1311,21 +1354,266 @@ static void midi_process_sysex(sysex_message_t* msg) {
             }
             break;
             
+        case CMD_GET_LATENCY:
+            // Format: [stage 0-3] or [LATENCY_RESET_ALL]
+            if (msg->data_len >= 1 && msg->data[0] == LATENCY_RESET_ALL) {
+                latency_stats_reset();
+                midi_sysex_send_ack(CMD_GET_LATENCY, 0x00);
+            } else if (msg->data_len >= 1 && msg->data[0] < LATENCY_STAGE_COUNT) {
+                const latency_hist_t *h = latency_stats_get((latency_stage_t)msg->data[0]);
+                midi_sysex_send_latency_stats(msg->data[0], h->count, h->max_us,
+                                               h->buckets, LATENCY_HIST_BUCKETS);
+            } else {
+                midi_sysex_send_ack(CMD_GET_LATENCY, 0x01);
+            }
+            break;
+            
+        case CMD_GET_PROFILE:
+            // Format: [page] or [PROFILE_RESET_ALL]
+            if (!profiler_enabled()) {
+                midi_sysex_send_ack(CMD_GET_PROFILE, 0x03);  // Not compiled in
+            } else if (msg->data_len >= 1 && msg->data[0] == PROFILE_RESET_ALL) {
+                profiler_reset();
+                midi_sysex_send_ack(CMD_GET_PROFILE, 0x00);
+            } else {
+                uint8_t page = (msg->data_len >= 1) ? msg->data[0] : 0;
+                profiler_row_t rows[PROFILE_ROWS_PER_PAGE];
+                uint16_t total_rows = 0;
+                uint16_t n = profiler_collect(page * PROFILE_ROWS_PER_PAGE, rows,
+                                              PROFILE_ROWS_PER_PAGE, &total_rows);
+                uint16_t pages = (total_rows + PROFILE_ROWS_PER_PAGE - 1) / PROFILE_ROWS_PER_PAGE;
+                midi_sysex_send_profile_page(page, (uint8_t)(pages > 0x7F ? 0x7F : pages),
+                                              rows, (uint8_t)n);
+            }
+            break;
+            
+        case CMD_RECORDER_CONTROL:
+            // Format: [op] or [RECORDER_OP_SET_TRIGGER][threshold x5]
+            if (msg->data_len >= 1 && msg->data[0] == RECORDER_OP_START) {
+                // A new session moves the ring: stop reading it first
+                if (bulk_active_object(BULK_OBJECT_RECORDER)) {
+                    bulk_abort();
+                }
+                recorder_start((uint32_t)(time_us_64() / 1000));
+                midi_sysex_send_ack(CMD_RECORDER_CONTROL, 0x00);
+            } else if (msg->data_len >= 1 && msg->data[0] == RECORDER_OP_STOP) {
+                recorder_stop();
+                midi_sysex_send_ack(CMD_RECORDER_CONTROL, 0x00);
+            } else if (msg->data_len >= 6 && msg->data[0] == RECORDER_OP_SET_TRIGGER) {
+                g_recorder_trigger_x1000 = midi_sysex_decode_u32(&msg->data[1]);
+                recorder_set_trigger(g_recorder_trigger_x1000);
+                mark_settings_dirty();  // Survives the trip to the pool
+                midi_sysex_send_ack(CMD_RECORDER_CONTROL, 0x00);
+            } else {
+                midi_sysex_send_ack(CMD_RECORDER_CONTROL, 0x01);
+            }
+            break;
+            
+        case CMD_GET_RECORDER_STATUS: {
+            recorder_status_t status;
+            recorder_get_status(&status);
+            midi_sysex_send_recorder_status(&status);
+            break;
+        }
+            
+        case CMD_BULK_START:
+            // Format: [object][offset x5][chunk x2][window]; reply is CMD_BULK_INFO
+            if (msg->data_len >= 9) {
+                bulk_start(msg->data[0], midi_sysex_decode_u32(&msg->data[1]),
+                           (uint16_t)((msg->data[6] << 7) | msg->data[7]), msg->data[8]);
+            } else {
+                midi_sysex_send_ack(CMD_BULK_START, 0x01);
+            }
+            break;
+            
+        case CMD_BULK_ACK:
+            // Format: [next_seq x3][flags] — no reply, keeps the uplink free
+            if (msg->data_len >= 4) {
+                uint32_t next_seq = ((uint32_t)msg->data[0] << 14) |
+                                    ((uint32_t)msg->data[1] << 7) | msg->data[2];
+                bulk_ack(next_seq, (msg->data[3] & BULK_ACK_RETRANSMIT) != 0);
+            }
+            break;
+            
+        case CMD_BULK_ABORT:
+            bulk_abort();
+            midi_sysex_send_ack(CMD_BULK_ABORT, 0x00);
+            break;
+            
+        case CMD_CAPTURE_CONTROL:
+            // Format: [op] or [ARM_LEVEL|ARM_SLOPE][level x5][pre x2][post x2]
+            if (msg->data_len >= 1 && msg->data[0] == CAPTURE_OP_STATUS) {
+                capture_status_t status;
+                capture_get_status(&status);
+                midi_sysex_send_capture_status(&status);
+                break;
+            }
+            // Any change releases the frozen buffer: stop reading it first
+            if (bulk_active_object(BULK_OBJECT_CAPTURE)) {
+                bulk_abort();
+            }
+            if (msg->data_len >= 1 && msg->data[0] == CAPTURE_OP_OFF) {
+                capture_config_t cfg = { .mode = CAPTURE_TRIGGER_OFF };
+                capture_configure(&cfg);
+                midi_sysex_send_ack(CMD_CAPTURE_CONTROL, 0x00);
+            } else if (msg->data_len >= 1 && msg->data[0] == CAPTURE_OP_REARM) {
+                capture_rearm();
+                midi_sysex_send_ack(CMD_CAPTURE_CONTROL, 0x00);
+            } else if (msg->data_len >= 10 && (msg->data[0] == CAPTURE_OP_ARM_LEVEL ||
+                                               msg->data[0] == CAPTURE_OP_ARM_SLOPE)) {
+                capture_config_t cfg = {
+                    .mode = (msg->data[0] == CAPTURE_OP_ARM_LEVEL) ? CAPTURE_TRIGGER_LEVEL
+                                                                  : CAPTURE_TRIGGER_SLOPE,
+                    .level_x1000 = midi_sysex_decode_u32(&msg->data[1]),
+                    .pre_samples = (uint16_t)((msg->data[6] << 7) | msg->data[7]),
+                    .post_samples = (uint16_t)((msg->data[8] << 7) | msg->data[9]),
+                };
+                midi_sysex_send_ack(CMD_CAPTURE_CONTROL, capture_configure(&cfg) ? 0x00 : 0x01);
+            } else {
+                midi_sysex_send_ack(CMD_CAPTURE_CONTROL, 0x01);
+            }
+            break;
+            
+        case CMD_BURST_CONTROL:
+            // Format: [STOP] or [START][duration_ms x5]
+            if (msg->data_len >= 1 && msg->data[0] == BURST_OP_STOP) {
+                burst_stop();
+                midi_sysex_send_ack(CMD_BURST_CONTROL, 0x00);
+            } else if (msg->data_len >= 6 && (msg->data[0] == BURST_OP_START ||
+                                              msg->data[0] == BURST_OP_START_RAW)) {
+                burst_mode_t mode = (msg->data[0] == BURST_OP_START_RAW) ? BURST_MODE_RAW
+                                                                         : BURST_MODE_PRESSURE;
+                sensor_caps_t caps;
+                sensor_get_caps(&g_sensor, &caps);
+                if (mode == BURST_MODE_RAW && !(caps.flags & SENSOR_CAP_RAW_ADC)) {
+                    midi_sysex_send_ack(CMD_BURST_CONTROL, 0x01);  // Not on this sensor
+                    break;
+                }
+                bool ok = burst_start(mode, midi_sysex_decode_u32(&msg->data[1]), time_us_32());
+                midi_sysex_send_ack(CMD_BURST_CONTROL, ok ? 0x00 : 0x01);
+                #if CFG_TUD_CDC
+                if (ok) printf("CMD: Burst streaming started (%s)\n",
+                               mode == BURST_MODE_RAW ? "raw ADC" : "pressure");
+                #endif
+            } else {
+                midi_sysex_send_ack(CMD_BURST_CONTROL, 0x01);
+            }
+            break;
+            
+        case CMD_GET_CALIBRATION: {
+            if (!g_sensor_ready) {
+                midi_sysex_send_ack(CMD_GET_CALIBRATION, 0x03);
+                break;
+            }
+            sensor_calibration_t calib;
+            if (!sensor_get_calibration(&g_sensor, &calib)) {
+                midi_sysex_send_ack(CMD_GET_CALIBRATION, 0x01);  // No raw ADC mode
+                break;
+            }
+            sensor_caps_t caps;
+            sensor_get_caps(&g_sensor, &caps);
+            midi_sysex_send_calibration(caps.chip_id, calib.ctrl_meas, calib.config,
+                                        caps.period_us, calib.block);
+            break;
+        }
+            
+        case CMD_GET_SENSOR_INFO: {
+            // Format: [op][channel] (SENSOR_INFO_OP_CAPS, channel 0 if omitted)
+            uint8_t op = (msg->data_len >= 1) ? msg->data[0] : SENSOR_INFO_OP_CAPS;
+            uint8_t channel = (msg->data_len >= 2) ? msg->data[1] : 0;
+            if ((op != SENSOR_INFO_OP_CAPS && op != SENSOR_INFO_OP_SELF_TEST) ||
+                channel >= SENSOR_CHANNELS || (channel == 1 && !g_sensor2_ready)) {
+                midi_sysex_send_ack(CMD_GET_SENSOR_INFO, 0x01);
+                break;
+            }
+            sensor_t *sensor = (channel == 1) ? &g_sensor2 : &g_sensor;
+            uint8_t self_test = SENSOR_SELF_TEST_NOT_RUN;
+            if (op == SENSOR_INFO_OP_SELF_TEST) {
+                if (!g_sensor_ready || g_sensor_reconfiguring) {
+                    midi_sysex_send_ack(CMD_GET_SENSOR_INFO, 0x03);
+                    break;
+                }
+                set_sensor_reconfiguring(true);  // Keep Core 1 off the part meanwhile
+                self_test = (uint8_t)sensor_self_test(sensor);
+                set_sensor_reconfiguring(false);
+            }
+            sensor_caps_t caps;
+            sensor_get_caps(sensor, &caps);
+            midi_sysex_send_sensor_info(&caps, self_test, channel);
+            break;
+        }
+            
+        case CMD_GET_FLASH_STATS: {
+            flash_maint_stats_t stats;
+            flash_maint_get_stats(&stats);
+            midi_sysex_send_flash_stats(&stats);
+            break;
+        }
+            
         case CMD_GET_DIAGNOSTICS: {
+            power_stats_t power;
+            power_get_stats(&power);
             uint32_t uptime = (uint32_t)((time_us_64() / 1000 - (uint64_t)g_boot_time_ms) / 1000);
             midi_sysex_send_diagnostics(uptime, g_sensor_error_count,
                                          g_overrange_event_count,
-                                         g_i2c_recovery_count,
-                                         g_last_temperature_x100);
+                                         sensor_bus_recovery_count(),
+                                         g_last_temperature_x100,
+                                         g_sensor_health, g_sensor2_ready ? 2 : 1,
+                                         &g_boot_times, &power, &g_overrange_stats);
             break;
         }
             
+        case CMD_SET_PRESSURE_STATS:
+            // Per session: an app that does not know the frame never gets
+            // it after a reboot
+            if (msg->data_len >= 1 && msg->data[0] <= 1) {
+                g_pressure_stats = msg->data[0] != 0;
+                midi_sysex_send_ack(CMD_SET_PRESSURE_STATS, 0x00);
+            } else {
+                midi_sysex_send_ack(CMD_SET_PRESSURE_STATS, 0x01);
+            }
+            break;
+            
+        case CMD_SET_DUAL_MODE:
+            // Accepted without a second sensor: fused/both then carry the
+            // primary alone (valid mask tells the app)
+            if (msg->data_len >= 1 && msg->data[0] <= DUAL_MODE_BOTH) {
+                g_dual_mode = msg->data[0];
+                mark_settings_dirty();
+                midi_sysex_send_ack(CMD_SET_DUAL_MODE, 0x00);
+            } else {
+                midi_sysex_send_ack(CMD_SET_DUAL_MODE, 0x01);
+            }
+            break;
+            
+        case CMD_RUN_MICROBENCH:
+            // Format: [] or [iterations x5]
+            if (!microbench_enabled()) {
+                midi_sysex_send_ack(CMD_RUN_MICROBENCH, 0x03);  // Not compiled in
+            } else {
+                // Read before running: the parse case reuses the receive buffer
+                uint32_t iterations = (msg->data_len >= 5) ? midi_sysex_decode_u32(msg->data)
+                                                           : MICROBENCH_DEFAULT_ITERS;
+                microbench_result_t results[MICROBENCH_MAX_CASES];
+                int n = microbench_run_all(iterations, flash_build_settings, results);
+                for (int i = 0; i < n; i++) {
+                    midi_sysex_send_microbench_result((uint8_t)i, (uint8_t)n,
+                                                      microbench_unit(), &results[i]);
+                }
+            }
+            break;
+            
         case CMD_SET_OVERSAMPLING:
             if (msg->data_len >= 1) {
                 uint8_t osrs = msg->data[0];
-                if (osrs <= 5) {
+                if (osrs == OVERSAMPLING_AUTO) {
+                    sensor_set_auto(true);
+                    mark_settings_dirty();
+                    midi_sysex_send_ack(CMD_SET_OVERSAMPLING, 0x00);
+                } else if (osrs <= 5) {
+                    sensor_set_auto(false);  // A manual value ends auto mode
                     g_oversampling_ctrl = osrs;
-                    if (bmp280_apply_config()) {
+                    if (sensor_apply_config()) {
                         mark_settings_dirty();  // Debounced persist oversampling
                         midi_sysex_send_ack(CMD_SET_OVERSAMPLING, 0x00);
                     } else {
@@ -1344,8 +1632,9 @@ static void midi_process_sysex(sysex_message_t* msg) {
             if (msg->data_len >= 1) {
                 uint8_t iir = msg->data[0];
                 if (iir <= 4) {
+                    sensor_set_auto(false);
                     g_iir_config = iir;
-                    if (bmp280_apply_config()) {
+                    if (sensor_apply_config()) {
                         mark_settings_dirty();  // Debounced persist IIR filter
                         midi_sysex_send_ack(CMD_SET_IIR_FILTER, 0x00);
                     } else {
@@ -1390,6 +1679,10 @@ static void midi_process_sysex(sysex_message_t* msg) {
             midi_sysex_send_ack(msg->command, 0x01);
             break;
     }
+    // Unassigned command bytes have no slot; never fold them onto a real one
+    if (msg->command < PROFILER_SYSEX_SLOTS) {
+        PROF_END(prof_t0, PROF_SYSEX_CMD_BASE + msg->command);
+    }
 }
 
 /**
@@ -1444,202 +1737,499 @@ static void midi_task(void) {
  * Core 1: Sensor Sampling Task
  * ========================================================================== */
 
+/**
+ * @brief Core 1 state for the optional second sensor
+ * @details Simpler than the primary path on purpose: no burst, capture or
+ *          lockout grace, and a run of invalid samples just resets the part
+ */
+typedef struct {
+    uint64_t last_read_us;
+    float buffer[MAX_SAMPLES_PER_OUTPUT + 2];
+    int count;
+    int invalid_consec;
+    float baseline;
+    bool baseline_set;
+} secondary_state_t;
+
+/**
+ * @brief Read the second sensor on its own schedule (polled every sample
+ *        slot, FIFO drained per output frame, like the primary)
+ * @details Runs right after the primary read, so on a polled pair both bus
+ *          transactions share one 10ms slot back to back (about 0.4ms on
+ *          I2C, under 20us on SPI)
+ */
+static void core1_sample_secondary(secondary_state_t *st, const output_rate_t *rate,
+                                   uint64_t now_us, bool output_due) {
+    // Static: the Core 1 stack already holds the primary's batch
+    static sensor_sample_t samples[SENSOR_BATCH_MAX];
+    sensor_caps_t caps;
+    sensor_get_caps(&g_sensor2, &caps);
+    bool fifo = (caps.flags & SENSOR_CAP_FIFO) != 0;
+    uint32_t interval_us = fifo ? sensor_drain_interval_us(&caps, rate) : SAMPLE_INTERVAL_US;
+    if (now_us - st->last_read_us < interval_us && !(fifo && output_due)) return;
+    st->last_read_us = now_us;
+    if (g_sensor_reconfiguring) return;
+
+    int n = sensor_read_batch(&g_sensor2, samples, SENSOR_BATCH_MAX);
+    if (n < 0) {
+        sat_inc_u16(&g_sensor_health[1].bus_errors);
+        st->invalid_consec++;
+        n = 0;
+    }
+    for (int k = 0; k < n; k++) {
+        float reading = samples[k].pressure_hpa;
+        if (reading >= SENSOR_PLAUSIBLE_MIN_HPA && reading <= SENSOR_PLAUSIBLE_MAX_HPA) {
+            st->invalid_consec = 0;
+            if (st->count < rate->samples) {
+                st->buffer[st->count++] = reading;
+            }
+        } else {
+            sat_inc_u16(&g_sensor_health[1].invalid_samples);
+            st->invalid_consec++;
+        }
+    }
+    if (st->invalid_consec >= OVERRANGE_CONSEC_THRESHOLD) {
+        st->invalid_consec = 0;
+        st->count = 0;
+        sensor_reinit(&g_sensor2);
+    }
+}
+
+/**
+ * @brief Primary pressure trend, for seeing saturation coming
+ * @details The slope is taken between fresh conversions only: a polled
+ *          part is read several times per conversion
+ */
+typedef struct {
+    float last;             // Newest fresh reading (hPa), NAN to restart
+    float slope;            // hPa per conversion
+    bool approaching;       // Leaves the plausible range within the lookahead
+} saturation_trend_t;
+
+/// Feed one valid reading into the trend
+static void saturation_trend_update(saturation_trend_t *t, float reading) {
+    if (reading == t->last) return;
+    t->slope = isnan(t->last) ? 0.0f : reading - t->last;
+    t->last = reading;
+    float predicted = reading + t->slope * SATURATION_LOOKAHEAD;
+    t->approaching = predicted > SENSOR_PLAUSIBLE_MAX_HPA ||
+                     predicted < SENSOR_PLAUSIBLE_MIN_HPA;
+}
+
+/// Record one finished over-range recovery (last bad reading -> data again)
+static void overrange_recovered(uint32_t last_invalid_us) {
+    uint32_t ms = (time_us_32() - last_invalid_us) / 1000;
+    uint16_t v = (ms > UINT16_MAX) ? UINT16_MAX : (uint16_t)ms;
+    g_overrange_stats.last_ms = v;
+    if (v > g_overrange_stats.max_ms) g_overrange_stats.max_ms = v;
+}
+
+/**
+ * @brief One primary sensor bring-up attempt (Core 1)
+ * @details The first success stamps the boot timeline. The boot phase
+ *          ends on success or after SENSOR_BOOT_ATTEMPTS failures; from
+ *          then on device info reports the sensor ready or absent.
+ */
+static bool sensor_bring_up(void) {
+    static int attempts = 0;
+    bool ok = sensor_start();
+    g_sensor_ready = ok;  // Before g_sensor_starting: status never flickers absent
+    if (ok) {
+        boot_mark(&g_boot_times.sensor_ready_ms);
+        g_sensor_starting = false;
+    } else if (g_sensor_starting) {
+        sat_inc_u16(&g_sensor_error_count);
+        attempts++;
+        #if CFG_TUD_CDC
+        printf("WARN:Sensor init attempt %d/%d failed\n", attempts, SENSOR_BOOT_ATTEMPTS);
+        #endif
+        if (attempts >= SENSOR_BOOT_ATTEMPTS) g_sensor_starting = false;
+    }
+    return ok;
+}
+
 static void core1_sensor_task(void) {
-    // Allow Core 0 to lockout Core 1 during flash operations
+    // Allow Core 0 to lockout Core 1 during flash operations, then let
+    // Core 0 go: it must not touch flash before this point
     multicore_lockout_victim_init();
+    multicore_fifo_push_blocking(0);
+    profiler_init_core();
     
-    // Initialize I2C on Core 1
-    i2c_init(I2C_PORT, I2C_BAUDRATE);
-    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA_PIN);
-    gpio_pull_up(I2C_SCL_PIN);
-    
-    // EMC: Reduce drive strength and slew rate for I2C pins
-    gpio_set_drive_strength(I2C_SDA_PIN, GPIO_DRIVE_STRENGTH_2MA);
-    gpio_set_drive_strength(I2C_SCL_PIN, GPIO_DRIVE_STRENGTH_2MA);
-    gpio_set_slew_rate(I2C_SDA_PIN, GPIO_SLEW_RATE_SLOW);
-    gpio_set_slew_rate(I2C_SCL_PIN, GPIO_SLEW_RATE_SLOW);
+    // Initialize the sensor bus on Core 1
+    sensor_bus_setup_pins();
     
-    sleep_ms(100);  // Sensor power-up delay
+    sleep_ms(SENSOR_POWER_UP_MS);
     
-    // Sensor init with retry (exponential backoff)
-    // NOTE: Only ONE FIFO message is sent after the loop completes
-    //       to prevent Core 0 from reading a stale failure status
-    int retry_delay_ms = 1000;  // Start at 1s
-    int max_retries = 5;        // Max attempts before giving up (allows USB to start)
-    int retry_count = 0;
-    while (!g_sensor_ready && retry_count < max_retries) {
-        g_sensor_ready = bmp280_init();
-        if (g_sensor_ready) break;
-        
-        retry_count++;
-        
-        // Wait with watchdog feeding before retry
-        for (int i = 0; i < retry_delay_ms / 100; i++) {
-            watchdog_update();
-            sleep_ms(100);
-        }
-        
-        // Exponential backoff: 1s, 2s, 4s, 8s max
-        retry_delay_ms *= 2;
-        if (retry_delay_ms > 8000) retry_delay_ms = 8000;
-        
-        if (g_sensor_error_count < UINT16_MAX) g_sensor_error_count++;
-        #if CFG_TUD_CDC
-        printf("WARN:Sensor init retry %d/%d (delay=%dms)\n", retry_count, max_retries, retry_delay_ms);
-        #endif
-    }
+    // Nothing waits for the sensor: Core 0 already serves USB and reports
+    // the status via device info. A failed start is retried below.
+    sensor_bring_up();
     
-    // Single definitive status push — Core 0 reads exactly one value
-    multicore_fifo_push_blocking(g_sensor_ready ? 1 : 0);
+    // Optional second sensor at 0x77 (an empty address NAKs at once); a
+    // profile without DIVECHECKER_DUAL_SENSOR compiles the path out
+    g_sensor2_ready = DIVECHECKER_DUAL_SENSOR && sensor_start_secondary();
     
     // Sample buffer for averaging (sized for minimum rate = max samples)
     float sample_buffer[MAX_SAMPLES_PER_OUTPUT + 2];
     int sample_count = 0;
+    static secondary_state_t secondary;  // Static: keeps Core 1's stack small
     
     // Timing
     uint64_t last_sample_us = 0;
-    uint64_t last_output_ms = 0;
+    uint64_t last_output_us = 0;
+    uint32_t last_read_done_us = 0;  // Latency stamp: newest sample in window
+    
+    // Flash lockout grace (see LOCKOUT_GRACE_SAMPLES)
+    uint32_t seen_lockouts = flash_io_lockout_count();
+    uint8_t lockout_grace = 0;
+    
+    uint32_t autotune_gen = g_sensor_config_gen;
     
     // Over-range recovery state
     int overrange_consec = 0;        // Consecutive out-of-range readings
-    bool in_recovery = false;        // Currently recovering from over-range
+    bool in_recovery = false;        // Reset path: discarding samples
     int recovery_remaining = 0;      // Samples to discard before trusting data
+    bool saturated = false;          // Bypass path: waiting for a clean conversion
+    bool bypass = false;             // IIR filter off (saturated or approaching)
+    uint32_t last_invalid_us = 0;    // Newest bad reading
+    saturation_trend_t trend = { .last = NAN };
+    
+    // Sensor bring-up retries (see SENSOR_RETRY_*)
+    uint64_t sensor_retry_at_ms = time_us_64() / 1000 + SENSOR_RETRY_FIRST_MS;
+    uint32_t sensor_retry_delay_ms = SENSOR_RETRY_FIRST_MS * 2;
+    
+    // Keep-warm sampling while suspended (see KEEP_WARM_INTERVAL_US)
+    bool keep_warm = false;
+    bool standby = false;            // Sensor sleeps between forced conversions
+    uint64_t next_warm_us = 0;
     
     // Main sampling loop
     // ARCHITECTURE: Sensor runs ALWAYS regardless of app connection state.
-    // This keeps the BMP280 IIR filter warm, averaging buffer fresh, and
+    // This keeps the sensor IIR filter warm, averaging buffer fresh, and
     // timing stable. Only the queue-to-Core0 step checks g_app_connected.
     // Result: reconnection is seamless — no data gaps, no value spikes.
     while (true) {
         watchdog_update();
         
         if (!g_sensor_ready) {
-            // Sensor not ready — auto-retry every 5 seconds
-            static uint64_t last_sensor_retry_ms = 0;
+            // Sensor not found or lost — retry, backing off to every 5 s
             uint64_t now_retry = time_us_64() / 1000;
-            if (now_retry - last_sensor_retry_ms > 5000) {
-                last_sensor_retry_ms = now_retry;
-                g_sensor_ready = bmp280_init();
-                if (g_sensor_ready) {
-                    bmp280_apply_config();
+            if (now_retry >= sensor_retry_at_ms) {
+                if (sensor_bring_up()) {
+                    sensor_retry_delay_ms = SENSOR_RETRY_FIRST_MS;
                     #if CFG_TUD_CDC
                     printf("INFO:Sensor auto-recovered\n");
                     #endif
+                } else {
+                    sensor_retry_at_ms = now_retry + sensor_retry_delay_ms;
+                    sensor_retry_delay_ms *= 2;
+                    if (sensor_retry_delay_ms > SENSOR_RETRY_MAX_MS) {
+                        sensor_retry_delay_ms = SENSOR_RETRY_MAX_MS;
+                    }
                 }
             }
-            sleep_us(100);
+            power_idle_us(IDLE_US);
             continue;
         }
         
         uint64_t now_us = time_us_64();
-        uint64_t now_ms = now_us / 1000;
+        const output_rate_t *rate = g_rate;
+        
+        // Suspended (power.h): one forced conversion per keep-warm
+        // interval, the part asleep in between with its IIR memory intact.
+        // The reading only refreshes the temperature; the baseline and the
+        // averager are left alone and nothing is queued. A sensor without
+        // standby stays in normal mode and is just read less often.
+        if (power_is_suspended()) {
+            if (!keep_warm) {
+                keep_warm = true;
+                standby = !g_sensor_reconfiguring && sensor_standby(&g_sensor, true);
+                next_warm_us = now_us;
+            }
+            if (now_us >= next_warm_us && !g_sensor_reconfiguring) {
+                next_warm_us = now_us + KEEP_WARM_INTERVAL_US;
+                if (standby && sensor_trigger(&g_sensor)) {
+                    sensor_caps_t caps;
+                    sensor_get_caps(&g_sensor, &caps);
+                    // Wait out the conversion, but not past a resume
+                    uint64_t done_us = time_us_64() + caps.period_us;
+                    while (time_us_64() < done_us && power_is_suspended()) {
+                        power_idle_us(SUSPEND_IDLE_US);
+                    }
+                }
+                sensor_sample_t samples[SENSOR_BATCH_MAX];
+                int n = sensor_read_batch(&g_sensor, samples, SENSOR_BATCH_MAX);
+                if (n < 0) {
+                    sat_inc_u16(&g_sensor_health[0].bus_errors);
+                } else if (n > 0 && samples[n - 1].pressure_hpa >= SENSOR_PLAUSIBLE_MIN_HPA &&
+                           samples[n - 1].pressure_hpa <= SENSOR_PLAUSIBLE_MAX_HPA) {
+                    g_last_temperature_x100 = samples[n - 1].temperature_x100;
+                }
+            }
+            power_idle_us(SUSPEND_IDLE_US);
+            continue;
+        }
+        if (keep_warm) {
+            // Full rate again: the first frame is one output period away and
+            // averages a whole window of fresh samples
+            keep_warm = false;
+            if (standby) sensor_standby(&g_sensor, false);
+            sample_count = 0;
+            last_sample_us = now_us;
+            last_output_us = now_us;
+            overrange_consec = 0;
+            autotune_core1_restart();  // Window must not span the pause
+        }
         
-        // 100Hz internal sampling — runs continuously
-        if (now_us - last_sample_us >= SAMPLE_INTERVAL_US) {
+        // Raw ADC passthrough: thin sampler at the sensor's own output rate,
+        // the host compensates (no averaging, capture or over-range logic)
+        sensor_caps_t caps;
+        sensor_get_caps(&g_sensor, &caps);
+        if (burst_is_active(BURST_MODE_RAW)) {
+            if (now_us - last_sample_us >= caps.period_us) {
+                last_sample_us = now_us;
+                int32_t adc_P, adc_T;
+                if (!g_sensor_reconfiguring && sensor_read_raw(&g_sensor, &adc_P, &adc_T)) {
+                    burst_core1_push_raw((uint32_t)adc_P, (uint32_t)adc_T, time_us_32());
+                }
+            }
+            sample_count = 0;
+            last_output_us = now_us;  // First averaged frame a full window later
+            power_idle_us(IDLE_US);
+            continue;
+        }
+        
+        // Sensor read: BMP280 is polled at 100Hz; a FIFO part is drained in
+        // batches (sensor_drain_interval_us) and always right before an
+        // output frame so the frame sees every sample
+        bool fifo = (caps.flags & SENSOR_CAP_FIFO) != 0;
+        uint32_t read_interval_us = fifo ? sensor_drain_interval_us(&caps, rate) : SAMPLE_INTERVAL_US;
+        bool output_due = now_us - last_output_us >= rate->interval_us;
+        if (now_us - last_sample_us >= read_interval_us || (fifo && output_due)) {
             last_sample_us = now_us;
             
-            float reading;
-            if (g_sensor_reconfiguring) {
-                reading = NAN;
-            } else {
-                reading = bmp280_read_pressure();
+            uint32_t lockouts = flash_io_lockout_count();
+            if (lockouts != seen_lockouts) {
+                seen_lockouts = lockouts;
+                lockout_grace = LOCKOUT_GRACE_SAMPLES;
             }
             
-            if (isnan(reading)) {
-                if (g_lockout_grace > 0) {
-                    g_lockout_grace--;
+            if (autotune_gen != g_sensor_config_gen) {
+                autotune_gen = g_sensor_config_gen;
+                autotune_core1_restart();  // Window must not mix configurations
+            }
+            
+            sensor_sample_t samples[SENSOR_BATCH_MAX];
+            int n = -1;
+            if (!g_sensor_reconfiguring) {
+                PROF_BEGIN(prof_t0);
+                n = sensor_read_batch(&g_sensor, samples, SENSOR_BATCH_MAX);
+                PROF_END(prof_t0, PROF_BMP280_READ);
+            }
+            if (n < 0) {
+                if (!g_sensor_reconfiguring) sat_inc_u16(&g_sensor_health[0].bus_errors);
+                // Bus error or reconfiguring: counts as one invalid sample
+                samples[0] = (sensor_sample_t){ .pressure_hpa = NAN, .t_us = time_us_32() };
+                n = 1;
+            }
+            
+            bool reseeded = false;
+            for (int k = 0; k < n; k++) {
+                float reading = samples[k].pressure_hpa;
+                bool saturating = false;  // A real pressure outside the range, not a skip
+                if (!(reading >= SENSOR_PLAUSIBLE_MIN_HPA && reading <= SENSOR_PLAUSIBLE_MAX_HPA)) {
+                    saturating = !isnan(reading);
+                    reading = NAN;  // Over-range (or skipped) measurement
+                    sat_inc_u16(&g_sensor_health[0].invalid_samples);
                 } else {
-                    overrange_consec++;
+                    g_last_temperature_x100 = samples[k].temperature_x100;
                 }
                 
-                if (overrange_consec >= OVERRANGE_CONSEC_THRESHOLD && !in_recovery) {
-                    if (g_sensor_reconfiguring) {
-                        overrange_consec = 0;
-                    } else {
-                        #if CFG_TUD_CDC
-                        printf("WARN:Sensor over-range, resetting...\n");
-                        #endif
-                        sat_inc_u16(&g_overrange_event_count);
-                        
-                        if (bmp280_reinit_config()) {
-                            in_recovery = true;
-                            recovery_remaining = OVERRANGE_RECOVERY_SAMPLES;
+                if (isnan(reading)) {
+                    if (lockout_grace > 0) {
+                        lockout_grace--;
+                    } else if (!(saturated && saturating)) {
+                        // Over range while bypassed is expected; skips and
+                        // bus errors still count towards a reset
+                        overrange_consec++;
+                    }
+                    last_invalid_us = samples[k].t_us;
+                    
+                    // A saturation the trend saw coming needs no confirmation
+                    int threshold = (saturating && trend.approaching) ? 1 : OVERRANGE_CONSEC_THRESHOLD;
+                    if (overrange_consec >= threshold && !in_recovery) {
+                        if (g_sensor_reconfiguring) {
+                            overrange_consec = 0;
+                        } else if (saturating && !saturated &&
+                                   (bypass || sensor_set_filter_bypass(true))) {
+                            // Fast path: no reset, the filter just stays out
+                            // of the way until the pressure is back
+                            #if CFG_TUD_CDC
+                            printf("WARN:Sensor over-range, IIR filter bypassed\n");
+                            #endif
+                            sat_inc_u16(&g_overrange_event_count);
+                            if (trend.approaching) sat_inc_u16(&g_overrange_stats.predicted);
+                            bypass = true;
+                            saturated = true;
                             sample_count = 0;
                             overrange_consec = 0;
                             g_overrange_alert = true;
-                            
+                        } else {
                             #if CFG_TUD_CDC
-                            printf("INFO:Sensor reset OK, stabilizing (%d samples)\n",
-                                   OVERRANGE_RECOVERY_SAMPLES);
+                            printf("WARN:Sensor over-range, resetting...\n");
                             #endif
-                        } else {
-                            g_sensor_ready = bmp280_init();
-                            sat_inc_u16(&g_sensor_error_count);
-                            overrange_consec = 0;
+                            sat_inc_u16(&g_overrange_event_count);
+                            bypass = false;  // Reset or restart applies the configured filter
+                            saturated = false;
+                            
+                            if (sensor_reinit(&g_sensor)) {
+                                in_recovery = true;
+                                recovery_remaining = OVERRANGE_RECOVERY_SAMPLES;
+                                sample_count = 0;
+                                overrange_consec = 0;
+                                g_overrange_alert = true;
+                                
+                                #if CFG_TUD_CDC
+                                printf("INFO:Sensor reset OK, stabilizing (%d samples)\n",
+                                       OVERRANGE_RECOVERY_SAMPLES);
+                                #endif
+                            } else {
+                                g_sensor_ready = sensor_start();
+                                sat_inc_u16(&g_sensor_error_count);
+                                overrange_consec = 0;
+                            }
+                            break;  // Rest of the batch predates the reset
                         }
                     }
-                }
-            } else {
-                overrange_consec = 0;
-                
-                if (in_recovery) {
-                    recovery_remaining--;
-                    if (recovery_remaining <= 0) {
-                        in_recovery = false;
+                } else {
+                    overrange_consec = 0;
+                    
+                    if (saturated) {
+                        // First conversion back in range, unfiltered: the
+                        // averager restarts from it and a frame goes out now
+                        saturated = false;
+                        sample_count = 0;
+                        reseeded = true;
+                        trend.last = NAN;  // The jump back is not a trend
+                        overrange_recovered(last_invalid_us);
                         #if CFG_TUD_CDC
-                        printf("INFO:Sensor recovered, resuming normal operation\n");
+                        printf("INFO:Sensor back in range, averaging re-seeded\n");
                         #endif
                     }
-                } else if (sample_count < g_samples_per_output) {
-                    sample_buffer[sample_count++] = reading;
+                    saturation_trend_update(&trend, reading);
+                    
+                    if (in_recovery) {
+                        recovery_remaining--;
+                        if (recovery_remaining <= 0) {
+                            in_recovery = false;
+                            overrange_recovered(last_invalid_us);
+                            #if CFG_TUD_CDC
+                            printf("INFO:Sensor recovered, resuming normal operation\n");
+                            #endif
+                        }
+                    } else if (burst_is_active(BURST_MODE_PRESSURE) && g_baseline_set) {
+                        // Burst: every sample goes out, the averager sits idle
+                        sample_count = 0;
+                        burst_core1_push((int32_t)((reading - g_baseline_pressure) * 1000.0f),
+                                         samples[k].t_us);
+                    } else if (sample_count < rate->samples) {
+                        sample_buffer[sample_count++] = reading;
+                        last_read_done_us = samples[k].t_us;
+                    }
+                    
+                    // Full-rate capture ring (raw, before averaging/noise floor)
+                    if (g_baseline_set && !in_recovery) {
+                        capture_core1_sample((int32_t)((reading - g_baseline_pressure) * 1000.0f),
+                                             samples[k].t_us);
+                    }
+                    if (!in_recovery) {
+                        autotune_core1_sample(reading, samples[k].t_us, fifo);
+                    }
                 }
             }
+            
+            // The filter is bypassed ahead of a predicted saturation and
+            // during one, and back once the trend points inside the range
+            bool want_bypass = saturated || trend.approaching;
+            if (want_bypass != bypass && (caps.flags & SENSOR_CAP_FILTER_BYPASS) &&
+                sensor_set_filter_bypass(want_bypass)) {
+                bypass = want_bypass;
+            }
+            if (reseeded) output_due = true;
+        }
+        
+        if (DIVECHECKER_DUAL_SENSOR && g_sensor2_ready) {
+            core1_sample_secondary(&secondary, rate, now_us, output_due);
         }
         
         // Output at configured rate — averaging runs continuously
-        if (now_ms - last_output_ms >= (uint64_t)g_output_interval_ms) {
-            last_output_ms = now_ms;
+        if (output_due) {
+            last_output_us = now_us;
+            
+            pressure_packet_t packet = { .valid = 0 };
+            int32_t nf = (int32_t)g_noise_floor;
+            if (!g_baseline_set) {
+                secondary.baseline_set = false;  // Re-zero both channels together
+            }
             
             if (sample_count > 0) {
-                float sum = 0;
-                for (int i = 0; i < sample_count; i++) {
-                    sum += sample_buffer[i];
-                }
-                float avg_pressure = sum / sample_count;
+                // Mean, extremes and spread in the same pass over the window
+                sensor_frame_stats_t stats;
+                sensor_frame_stats(sample_buffer, sample_count, k_mean_scale[sample_count], &stats);
+                packet.count = (uint8_t)sample_count;
                 sample_count = 0;
                 
                 if (!g_baseline_set) {
-                    g_baseline_pressure = avg_pressure;
+                    g_baseline_pressure = stats.mean;
                     __dmb();  // Ensure pressure is visible before setting flag
                     g_baseline_set = true;
                 }
                 
-                float delta = avg_pressure - g_baseline_pressure;
+                float baseline = g_baseline_pressure;
+                float delta = stats.mean - baseline;
                 int32_t delta_x1000 = (int32_t)(delta * 1000.0f);
                 
-                int32_t nf = (int32_t)g_noise_floor;
                 if (delta_x1000 > -nf && delta_x1000 < nf) {
                     delta_x1000 = 0;
                 }
+                packet.delta_x1000 = delta_x1000;
+                packet.min_x1000 = (int32_t)((stats.min - baseline) * 1000.0f);
+                packet.max_x1000 = (int32_t)((stats.max - baseline) * 1000.0f);
+                packet.stddev_x1e6 = (uint32_t)(sqrtf(stats.variance) * 1000000.0f);
+                packet.valid |= DUAL_VALID_PRIMARY;
+            }
+            
+            if (DIVECHECKER_DUAL_SENSOR && secondary.count > 0) {
+                float avg_pressure = sensor_mean(secondary.buffer, secondary.count,
+                                                 k_mean_scale[secondary.count]);
+                secondary.count = 0;
                 
-                // Always forward to Core 0 — data flow is decoupled from
-                // ping/pong connection state.  Core 0 gates on tud_midi_mounted().
-                {
-                    pressure_packet_t packet = {
-                        .delta_x1000 = delta_x1000
-                    };
-                    if (!queue_try_add(&g_pressure_queue, &packet)) {
-                        pressure_packet_t discard;
-                        queue_try_remove(&g_pressure_queue, &discard);
-                        queue_try_add(&g_pressure_queue, &packet);
-                    }
+                // Own baseline: per-sensor offset calibration at zeroing time
+                if (!secondary.baseline_set) {
+                    secondary.baseline = avg_pressure;
+                    secondary.baseline_set = true;
+                }
+                int32_t delta_x1000 = (int32_t)((avg_pressure - secondary.baseline) * 1000.0f);
+                if (delta_x1000 > -nf && delta_x1000 < nf) {
+                    delta_x1000 = 0;
+                }
+                packet.delta2_x1000 = delta_x1000;
+                packet.valid |= DUAL_VALID_SECONDARY;
+            }
+            
+            // Always forward to Core 0 — data flow is decoupled from
+            // ping/pong connection state.  Core 0 gates on tud_midi_mounted().
+            if (packet.valid != 0) {
+                packet.t_read_us = last_read_done_us;
+                packet.t_push_us = time_us_32();
+                if (!queue_try_add(&g_pressure_queue, &packet)) {
+                    pressure_packet_t discard;
+                    queue_try_remove(&g_pressure_queue, &discard);
+                    queue_try_add(&g_pressure_queue, &packet);
                 }
             }
         }
         
-        sleep_us(100);
+        power_idle_us(IDLE_US);
     }
 }
 
@@ -1647,6 +2237,29 @@ static void core1_sensor_task(void) {
  * Core 0: Main Entry Point
  * ========================================================================== */
 
+/**
+ * @brief The value a frame carries under the current dual mode
+ * @details Primary mode ignores the second sensor; fused and both modes
+ *          average whichever channels were valid
+ * @return false if there is nothing to send for this mode
+ */
+static bool pressure_frame_value(const pressure_packet_t *packet, int32_t *value) {
+    bool primary = (packet->valid & DUAL_VALID_PRIMARY) != 0;
+    bool secondary = (packet->valid & DUAL_VALID_SECONDARY) != 0;
+    if (g_dual_mode == DUAL_MODE_PRIMARY || !secondary) {
+        *value = packet->delta_x1000;
+        return primary;
+    }
+    if (!primary) {
+        *value = packet->delta2_x1000;
+        return true;
+    }
+    // Halves first: the sum of two int32 could overflow
+    *value = packet->delta_x1000 / 2 + packet->delta2_x1000 / 2 +
+             (packet->delta_x1000 % 2 + packet->delta2_x1000 % 2) / 2;
+    return true;
+}
+
 static void init_serial_number(void) {
     pico_unique_board_id_t board_id;
     pico_get_unique_board_id(&board_id);
@@ -1662,15 +2275,25 @@ static void print_startup_banner(void) {
     printf("\n");
     printf("========================================\n");
     printf("  DiveChecker RP2350 v%s (USB MIDI)\n", FW_VERSION_STRING);
-    printf("  Dual-Core %dHz -> %dHz Output\n", INTERNAL_SAMPLE_RATE_HZ, g_output_rate);
+    printf("  Dual-Core %dHz -> %dHz Output (%s)\n", INTERNAL_SAMPLE_RATE_HZ, g_output_rate,
+           DIVECHECKER_PROFILE_NAME);
     printf("========================================\n\n");
     printf("Device : %s\n", g_device_name);
     printf("Serial : %s\n", g_serial_number);
+    #if SENSOR_BUS_SPI
+    printf("SPI    : SCK GP%d, CS GP%d @ %dMHz (DMA)\n", SPI_SCK_PIN, SPI_CS_PIN,
+           SPI_BAUDRATE / 1000000);
+    #else
     printf("I2C    : GP%d/GP%d @ %dkHz\n", I2C_SDA_PIN, I2C_SCL_PIN, I2C_BAUDRATE / 1000);
-    printf("Sensor : %s (X16 + IIR X2)\n", g_sensor_ready ? "OK" : "NOT FOUND");
+    #endif
+    sensor_caps_t caps;
+    sensor_get_caps(&g_sensor, &caps);
+    printf("Sensor : %s\n", g_sensor_ready ? caps.name : "NOT FOUND");
+    sensor_get_caps(&g_sensor2, &caps);
+    printf("Second : %s\n", g_sensor2_ready ? caps.name : "none");
     printf("Mode   : Core0=USB MIDI, Core1=Sensor\n");
     printf("Output : %dHz (%d-%dHz)\n", g_output_rate, MIN_OUTPUT_RATE_HZ, MAX_OUTPUT_RATE_HZ);
-    printf("Filter : Average (%d samples)\n", g_samples_per_output);
+    printf("Filter : Average (%d samples)\n", g_rate->samples);
     printf("\nReady for MIDI connection...\n");
     printf("========================================\n");
     #endif
@@ -1725,12 +2348,92 @@ void tud_resume_cb(void) {
     #endif
 }
 
+/**
+ * @brief Clock governor: the workload profile for this loop iteration
+ * @details Suspend starts once the bus has stayed suspended for
+ *          SUSPEND_ENTER_MS and ends on the first iteration after resume;
+ *          a recording or a burst never suspends, both want every sample.
+ *          Crypto and flash jobs switch around themselves (power_enter).
+ */
+static void power_task(uint64_t now_ms) {
+    static uint64_t suspended_since_ms = 0;
+    
+    bool bursting = burst_is_active(burst_mode());
+    if (!usb_is_suspended() || recorder_is_recording() || bursting) {
+        suspended_since_ms = 0;
+    } else if (suspended_since_ms == 0) {
+        suspended_since_ms = now_ms;
+    }
+    
+    power_profile_t profile;
+    if (suspended_since_ms != 0 && now_ms - suspended_since_ms >= SUSPEND_ENTER_MS) {
+        profile = POWER_PROFILE_SUSPEND;
+    } else if (bursting || (g_app_connected && g_output_rate > FAST_OUTPUT_HZ)) {
+        profile = POWER_PROFILE_FULL;
+    } else if (g_app_connected) {
+        profile = POWER_PROFILE_STREAMING;
+    } else {
+        profile = POWER_PROFILE_IDLE;
+    }
+    power_set_profile(profile);
+}
+
+/**
+ * @brief Core 0 side of the boot pipeline, once per main loop iteration
+ * @details Nothing here blocks: USB and MIDI commands are serviced from
+ *          the first iteration while Core 1 brings the sensor up. This
+ *          stamps enumeration, blinks the LED until a host configures the
+ *          device (or USB_CONNECT_WAIT_MS passes without one), and pushes
+ *          a change of sensor status to a connected app as device info.
+ */
+static void boot_task(uint64_t now_ms) {
+    static bool waiting_for_host = true;
+    static bool blink = false;
+    static uint64_t last_blink_ms = 0;
+    static uint8_t reported_status = SENSOR_STATUS_STARTING;
+    
+    bool mounted = tud_mounted();
+    if (mounted) {
+        boot_mark(&g_boot_times.usb_mounted_ms);
+    }
+    if (waiting_for_host) {
+        if (mounted || now_ms - g_boot_time_ms >= USB_CONNECT_WAIT_MS) {
+            waiting_for_host = false;
+            if (!g_app_connected) led_set_state(LED_STATE_USB_READY);
+        } else if (now_ms - last_blink_ms >= 500) {
+            last_blink_ms = now_ms;
+            blink = !blink;
+            led_set_state(blink ? LED_STATE_USB_WAIT : LED_STATE_OFF);
+        }
+    }
+    
+    uint8_t status = sensor_status();
+    if (status != reported_status) {
+        if (reported_status == SENSOR_STATUS_STARTING) {
+            print_startup_banner();  // Once the sensor line is known
+        }
+        reported_status = status;
+        if (g_app_connected) {
+            midi_sysex_send_device_info(g_serial_number, g_device_name,
+                                         FW_VERSION_STRING, status);
+        }
+    }
+}
+
 int main(void) {
     // =========================================================================
     // EMC: Configure unused GPIO pins to prevent floating (reduce EMI)
-    // Used GPIOs: GP8 (I2C SDA), GP9 (I2C SCL), GP16 (WS2812 LED)
+    // Used GPIOs: the sensor bus (SPI: GP3-GP7, I2C: GP8 SDA, GP9 SCL)
+    // and GP16 (WS2812 LED)
     // =========================================================================
-    static const uint8_t used_gpios[] = {8, 9, 16};
+    static const uint8_t used_gpios[] = {
+#if SENSOR_BUS_SPI
+        SPI_CS2_PIN, SPI_MISO_PIN, SPI_CS_PIN, SPI_SCK_PIN, SPI_MOSI_PIN,
+#else
+        I2C_SDA_PIN, I2C_SCL_PIN,
+#endif
+        WS2812_PIN,
+    };
     for (uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++) {
         bool in_use = false;
         for (size_t i = 0; i < sizeof(used_gpios); i++) {
@@ -1746,61 +2449,47 @@ int main(void) {
         }
     }
     
+    profiler_init_core();
+    crc32_dma_init();  // Before anything checks flash, and before Core 1 starts
     init_serial_number();
     flash_load_settings();
+    recorder_init(FLASH_RECORDER_OFFSET,
+                  (uint16_t)((FLASH_SETTINGS_OFFSET - FLASH_RECORDER_OFFSET) / FLASH_SECTOR_SIZE));
+    recorder_set_trigger(g_recorder_trigger_x1000);
     
     usb_set_serial_number(g_serial_number);
     tusb_init();
+    boot_mark(&g_boot_times.usb_init_ms);
     
     // Initialize MIDI SysEx handler
     midi_sysex_init();
+    bulk_init(&g_bulk_io);
     
-    // Initialize inter-core queue
+    // Initialize inter-core queues
     queue_init(&g_pressure_queue, sizeof(pressure_packet_t), PRESSURE_QUEUE_SIZE);
+    burst_init();
     
-    // Initialize I2C mutex for cross-core access protection
-    mutex_init(&g_i2c_mutex);
+    // Sensor bus mutex for cross-core access protection
+    sensor_bus_init();
     
     // Initialize LED
     led_init();
     led_set_state(LED_STATE_BOOT);
+    power_init(led_retime);
     
-    // Launch sensor task on Core 1
+    // Launch sensor task on Core 1. Only its lockout setup is waited for
+    // (microseconds); sensor bring-up and USB enumeration overlap, and
+    // boot_task() tracks both from the main loop.
     multicore_launch_core1(core1_sensor_task);
-    
-    // Wait for Core 1 initialization
-    uint32_t sensor_status = multicore_fifo_pop_blocking();
-    g_sensor_ready = (sensor_status == 1);
-    
-    // Wait for USB connection with blinking LED
-    // Enable watchdog early for self-recovery if USB init hangs
-    watchdog_enable(8000, true);  // 8s generous timeout during boot
-    uint64_t last_blink_us = 0;
-    bool blink = false;
-    while (!tud_connected()) {
-        tud_task();
-        watchdog_update();
-        uint64_t now_us = time_us_64();
-        if (now_us - last_blink_us > 500000) {
-            last_blink_us = now_us;
-            blink = !blink;
-            led_set_state(blink ? LED_STATE_USB_WAIT : LED_STATE_OFF);
-        }
-        sleep_ms(10);
-    }
-    led_set_state(LED_STATE_USB_READY);
-    sleep_ms(500);
-    
-    // Print startup info (to CDC debug port if available)
-    print_startup_banner();
+    multicore_fifo_pop_blocking();
     
     // Record boot time for uptime calculation
     g_boot_time_ms = time_us_64() / 1000;
     
     // =========================================================================
     // EMC: Enable watchdog for auto-recovery from ESD-induced hangs
-    // Timeout: 2000ms - both cores must feed regularly
-    // Tighten from boot timeout (8s) to operational timeout (2s)
+    // Timeout: 2000ms - both cores must feed regularly. Neither core
+    // blocks during boot, so there is no separate boot timeout.
     // =========================================================================
     watchdog_enable(2000, true);  // 2 second timeout, pause on debug
     
@@ -1812,10 +2501,17 @@ int main(void) {
         uint64_t now_ms = time_us_64() / 1000;
         
         // TinyUSB device task - MUST be called frequently
+        PROF_BEGIN(prof_usb_t0);
         tud_task();
+        PROF_END(prof_usb_t0, PROF_TUD_TASK);
         
         // Process incoming MIDI messages
+        PROF_BEGIN(prof_midi_t0);
         midi_task();
+        PROF_END(prof_midi_t0, PROF_MIDI_TASK);
+        
+        boot_task(now_ms);
+        power_task(now_ms);
         
         // Check for connection timeout.
         // While USB is suspended (detected via hardware register OR
@@ -1827,6 +2523,7 @@ int main(void) {
             } else if (now_ms - g_last_ping_ms > CONNECTION_TIMEOUT_MS) {
                 g_app_connected = false;
                 g_baseline_printed = false;  // Reset for next connection
+                burst_stop();                // Nobody is listening
                 led_set_state(LED_STATE_USB_READY);
                 #if CFG_TUD_CDC
                 printf("MIDI: App disconnected (timeout)\n");
@@ -1841,6 +2538,11 @@ int main(void) {
         {
             pressure_packet_t packet;
             while (queue_try_remove(&g_pressure_queue, &packet)) {
+                uint32_t t_pop_us = time_us_32();
+                int32_t value;
+                if (!pressure_frame_value(&packet, &value)) continue;
+                // Every frame goes to the recorder, connected or not
+                recorder_feed(value, (uint32_t)(time_us_64() / 1000), g_rate->interval_ms);
                 // Send baseline info once
                 if (!g_baseline_printed && g_baseline_set) {
                     #if CFG_TUD_CDC
@@ -1849,7 +2551,62 @@ int main(void) {
                     g_baseline_printed = true;
                 }
                 // Send pressure via MIDI SysEx
-                midi_sysex_send_pressure(packet.delta_x1000);
+                bool sent;
+                if (g_dual_mode == DUAL_MODE_BOTH) {
+                    bool both = (packet.valid & DUAL_VALID_PRIMARY) &&
+                                (packet.valid & DUAL_VALID_SECONDARY);
+                    sent = midi_sysex_send_pressure_dual(
+                        value, both ? packet.delta2_x1000 - packet.delta_x1000 : 0, packet.valid);
+                } else if (g_pressure_stats && (g_dual_mode == DUAL_MODE_PRIMARY ||
+                                                !(packet.valid & DUAL_VALID_SECONDARY))) {
+                    // Stats describe the primary window: fused frames stay plain
+                    sent = midi_sysex_send_pressure_stats(value, packet.min_x1000, packet.max_x1000,
+                                                          packet.stddev_x1e6, packet.count);
+                } else {
+                    sent = midi_sysex_send_pressure(value);
+                }
+                if (sent) {
+                    boot_mark(&g_boot_times.first_frame_ms);
+                    // Unsigned subtraction handles the 71-minute time_us_32 wrap
+                    uint32_t t_tx_us = time_us_32();
+                    latency_stats_record(LATENCY_STAGE_READ_TO_PUSH, packet.t_push_us - packet.t_read_us);
+                    latency_stats_record(LATENCY_STAGE_PUSH_TO_POP, t_pop_us - packet.t_push_us);
+                    latency_stats_record(LATENCY_STAGE_POP_TO_TX, t_tx_us - t_pop_us);
+                    latency_stats_record(LATENCY_STAGE_READ_TO_TX, t_tx_us - packet.t_read_us);
+                }
+            }
+
+            // Burst samples (Core 1 bypasses the averager while active).
+            // A batch that could not be queued is retried next iteration;
+            // meanwhile the burst queue absorbs the backlog.
+            {
+                burst_sample_t sample;
+                uint32_t now_us = time_us_32();
+                uint32_t now_ms_64 = (uint32_t)(time_us_64() / 1000);
+                while (burst_pop(&sample)) {
+                    // Read time on the recorder's clock keeps its timestamps exact
+                    if (burst_mode() == BURST_MODE_PRESSURE) {
+                        recorder_feed(sample.delta_x1000,
+                                      now_ms_64 - (now_us - sample.t_us) / 1000,
+                                      SAMPLE_INTERVAL_MS);
+                    }
+                    burst_batch_add(&sample);
+                }
+                const burst_batch_t *batch = burst_batch_ready(now_us);
+                if (batch != NULL && midi_sysex_send_burst_batch(batch)) {
+                    burst_batch_sent();
+                }
+            }
+
+            // Bulk download: one chunk per iteration so pressure frames and
+            // commands interleave with the transfer
+            bulk_task();
+
+            // Capture froze (Core 1): offer it to the host once
+            if (capture_take_frozen_event()) {
+                capture_status_t status;
+                capture_get_status(&status);
+                midi_sysex_send_capture_status(&status);
             }
 
             // Send over-range alert to app (set by Core 1)
@@ -1866,7 +2623,14 @@ int main(void) {
             g_settings_dirty = false;
         }
         
-        sleep_us(100);
+        // Background flash maintenance: pre-erase released sectors only while
+        // nobody is watching the stream and nothing is being recorded, so the
+        // ~100-400ms lockout never shows up as a data gap
+        recorder_task();
+        sensor_autotune_task();
+        flash_maint_task((!g_app_connected || usb_is_suspended()) && !recorder_is_recording());
+        
+        power_idle_us(power_is_suspended() ? SUSPEND_IDLE_US : IDLE_US);
     }
     
     return 0;
@@ -0,0 +1,95 @@
+/**
+ * @file bmp280_compensate.h
+ * @brief BMP280 integer compensation (Bosch 64-bit reference formula)
+ *
+ * The single definition of the math the firmware runs on every sample.
+ * Header-only and free of SDK dependencies so host tools (raw ADC
+ * post-processing, the batch library under host/) compile the exact same
+ * code and stay bit-exact with the device.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef BMP280_COMPENSATE_H
+#define BMP280_COMPENSATE_H
+
+#include <stdint.h>
+
+#define BMP280_CALIB_LEN        24      // Registers 0x88-0x9F
+
+/**
+ * @brief BMP280 calibration data
+ */
+typedef struct {
+    uint16_t dig_T1;
+    int16_t  dig_T2, dig_T3;
+    uint16_t dig_P1;
+    int16_t  dig_P2, dig_P3, dig_P4, dig_P5;
+    int16_t  dig_P6, dig_P7, dig_P8, dig_P9;
+} bmp280_calib_t;
+
+/**
+ * @brief Parse the calibration block (little-endian 16-bit values)
+ */
+static inline void bmp280_parse_calib(const uint8_t *raw, bmp280_calib_t *calib) {
+    calib->dig_T1 = (uint16_t)(raw[0]  | (raw[1]  << 8));
+    calib->dig_T2 = (int16_t)(raw[2]   | (raw[3]  << 8));
+    calib->dig_T3 = (int16_t)(raw[4]   | (raw[5]  << 8));
+    calib->dig_P1 = (uint16_t)(raw[6]  | (raw[7]  << 8));
+    calib->dig_P2 = (int16_t)(raw[8]   | (raw[9]  << 8));
+    calib->dig_P3 = (int16_t)(raw[10]  | (raw[11] << 8));
+    calib->dig_P4 = (int16_t)(raw[12]  | (raw[13] << 8));
+    calib->dig_P5 = (int16_t)(raw[14]  | (raw[15] << 8));
+    calib->dig_P6 = (int16_t)(raw[16]  | (raw[17] << 8));
+    calib->dig_P7 = (int16_t)(raw[18]  | (raw[19] << 8));
+    calib->dig_P8 = (int16_t)(raw[20]  | (raw[21] << 8));
+    calib->dig_P9 = (int16_t)(raw[22]  | (raw[23] << 8));
+}
+
+/**
+ * @brief Temperature compensation
+ * @return t_fine (input to the pressure formula)
+ */
+static inline int32_t bmp280_compensate_t_fine(const bmp280_calib_t *calib, int32_t adc_T) {
+    int32_t var1 = ((((adc_T >> 3) - ((int32_t)calib->dig_T1 << 1))) *
+                    ((int32_t)calib->dig_T2)) >> 11;
+    int32_t var2 = (((((adc_T >> 4) - ((int32_t)calib->dig_T1)) *
+                      ((adc_T >> 4) - ((int32_t)calib->dig_T1))) >> 12) *
+                    ((int32_t)calib->dig_T3)) >> 14;
+    return var1 + var2;
+}
+
+/**
+ * @brief Temperature in °C x100 from t_fine
+ */
+static inline int32_t bmp280_t_fine_to_x100(int32_t t_fine) {
+    return (t_fine * 5 + 128) >> 8;
+}
+
+/**
+ * @brief Pressure compensation (64-bit arithmetic for precision)
+ * @return Pressure in Pa as Q24.8 (Pa x256), 0 if the calibration is corrupt
+ */
+static inline uint32_t bmp280_compensate_p_q24_8(const bmp280_calib_t *calib, int32_t adc_P,
+                                                 int32_t t_fine) {
+    int64_t p_var1 = ((int64_t)t_fine) - 128000;
+    int64_t p_var2 = p_var1 * p_var1 * (int64_t)calib->dig_P6;
+    p_var2 += (p_var1 * (int64_t)calib->dig_P5) << 17;
+    p_var2 += ((int64_t)calib->dig_P4) << 35;
+    p_var1 = ((p_var1 * p_var1 * (int64_t)calib->dig_P3) >> 8) +
+             ((p_var1 * (int64_t)calib->dig_P2) << 12);
+    p_var1 = ((((int64_t)1) << 47) + p_var1) * ((int64_t)calib->dig_P1) >> 33;
+
+    if (p_var1 == 0) return 0;  // Avoid division by zero
+
+    int64_t p = 1048576 - adc_P;
+    p = (((p << 31) - p_var2) * 3125) / p_var1;
+    p_var1 = (((int64_t)calib->dig_P9) * (p >> 13) * (p >> 13)) >> 25;
+    p_var2 = (((int64_t)calib->dig_P8) * p) >> 19;
+    p = ((p + p_var1 + p_var2) >> 8) + (((int64_t)calib->dig_P7) << 4);
+    return (uint32_t)p;
+}
+
+#endif // BMP280_COMPENSATE_H
@@ -0,0 +1,203 @@
+/**
+ * @file bulk_transfer.c
+ * @brief Windowed bulk download over SysEx (8-to-7 packed chunks)
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "bulk_transfer.h"
+#include "crc32.h"
+#include <string.h>
+
+_Static_assert(BULK_DATA_HEADER + BULK_PACKED_SIZE(BULK_CHUNK_MAX) <= 251,
+               "bulk chunk must fit one SysEx message");
+
+static const bulk_io_t *g_io = NULL;
+static bool g_active = false;
+static uint8_t g_object = 0;
+static uint32_t g_offset = 0;       // Byte offset of seq 0
+static uint32_t g_length = 0;       // Bytes to send from g_offset
+static uint16_t g_chunk = BULK_CHUNK_DEFAULT;
+static uint8_t g_window = BULK_WINDOW_DEFAULT;
+static uint32_t g_num_chunks = 0;
+static uint32_t g_acked = 0;        // Oldest unacknowledged seq
+static uint32_t g_next = 0;         // Next seq to send
+static uint32_t g_sent_max = 0;     // Highest seq sent + 1 (retransmit accounting)
+static uint32_t g_progress_ms = 0;
+static uint8_t g_timeouts = 0;
+static bulk_stats_t g_stats;
+
+// Same encoding as the rest of the protocol: 7 bits per byte, big-endian
+static void put_u32_7bit(uint8_t *dst, uint32_t val) {
+    dst[0] = (val >> 28) & 0x0F;
+    dst[1] = (val >> 21) & 0x7F;
+    dst[2] = (val >> 14) & 0x7F;
+    dst[3] = (val >> 7) & 0x7F;
+    dst[4] = val & 0x7F;
+}
+
+static void put_u21_7bit(uint8_t *dst, uint32_t val) {
+    dst[0] = (val >> 14) & 0x7F;
+    dst[1] = (val >> 7) & 0x7F;
+    dst[2] = val & 0x7F;
+}
+
+uint16_t bulk_pack_8to7(const uint8_t *src, uint16_t len, uint8_t *dst) {
+    uint16_t out = 0;
+    for (uint16_t i = 0; i < len; i += 7) {
+        uint16_t group = (len - i < 7) ? (uint16_t)(len - i) : 7;
+        uint8_t msbs = 0;
+        for (uint16_t k = 0; k < group; k++) {
+            msbs |= (uint8_t)((src[i + k] >> 7) << k);
+            dst[out + 1 + k] = src[i + k] & 0x7F;
+        }
+        dst[out] = msbs;
+        out += group + 1;
+    }
+    return out;
+}
+
+uint16_t bulk_unpack_7to8(const uint8_t *src, uint16_t len, uint8_t *dst) {
+    uint16_t out = 0;
+    for (uint16_t i = 0; i < len; i += 8) {
+        uint16_t group = (len - i < 8) ? (uint16_t)(len - i - 1) : 7;
+        uint8_t msbs = src[i];
+        for (uint16_t k = 0; k < group; k++) {
+            dst[out++] = (uint8_t)((src[i + 1 + k] & 0x7F) | (((msbs >> k) & 1) << 7));
+        }
+    }
+    return out;
+}
+
+void bulk_init(const bulk_io_t *io) {
+    g_io = io;
+    g_active = false;
+    memset(&g_stats, 0, sizeof(g_stats));
+}
+
+uint8_t bulk_start(uint8_t object, uint32_t offset, uint16_t chunk, uint8_t window) {
+    uint8_t status = BULK_STATUS_OK;
+    uint32_t total = 0;
+
+    if (g_io == NULL) {
+        status = BULK_STATUS_BUSY;
+    } else if (chunk < BULK_CHUNK_MIN || chunk > BULK_CHUNK_MAX ||
+               window == 0 || window > BULK_WINDOW_MAX) {
+        status = BULK_STATUS_INVALID;
+    } else if (g_io->available != NULL && !g_io->available(object)) {
+        status = BULK_STATUS_BUSY;
+    } else {
+        total = g_io->size(object);
+        if (offset > total) status = BULK_STATUS_INVALID;
+    }
+
+    // Format: [object][status][total x5][offset x5][chunk x2][window]
+    uint8_t info[15];
+    info[0] = object & 0x7F;
+    info[1] = status;
+    put_u32_7bit(&info[2], total);
+    put_u32_7bit(&info[7], offset);
+    info[12] = (chunk >> 7) & 0x7F;
+    info[13] = chunk & 0x7F;
+    info[14] = window & 0x7F;
+
+    if (status == BULK_STATUS_OK) {
+        // A new start replaces any transfer in progress (host resume)
+        g_object = object;
+        g_offset = offset;
+        g_length = total - offset;
+        g_chunk = chunk;
+        g_window = window;
+        g_num_chunks = (g_length + chunk - 1) / chunk;
+        g_active = (g_num_chunks > 0);
+        g_acked = 0;
+        g_next = 0;
+        g_sent_max = 0;
+        g_timeouts = 0;
+        g_progress_ms = g_io->now_ms();
+    }
+    if (g_io != NULL) {
+        g_io->send(g_io->cmd_info, info, sizeof(info));
+    }
+    return status;
+}
+
+void bulk_ack(uint32_t next_seq, bool retransmit) {
+    if (!g_active) return;
+    if (next_seq > g_sent_max) return;  // Acknowledges chunks never sent: ignore
+
+    if (next_seq > g_acked) {
+        g_acked = next_seq;
+        g_progress_ms = g_io->now_ms();
+        g_timeouts = 0;
+    }
+    if (g_next < g_acked) {
+        g_next = g_acked;
+    }
+    if (retransmit) {
+        g_next = g_acked;
+        g_progress_ms = g_io->now_ms();
+    }
+    if (g_acked >= g_num_chunks) {
+        g_active = false;
+        g_stats.transfers++;
+    }
+}
+
+void bulk_abort(void) {
+    g_active = false;
+}
+
+bool bulk_task(void) {
+    if (!g_active) return false;
+
+    uint32_t now = g_io->now_ms();
+    if (now - g_progress_ms > BULK_RETX_TIMEOUT_MS) {
+        g_stats.timeouts++;
+        if (++g_timeouts >= BULK_MAX_TIMEOUTS) {
+            g_active = false;
+            return false;
+        }
+        g_next = g_acked;  // Go back N
+        g_progress_ms = now;
+    }
+
+    if (g_next >= g_num_chunks || g_next >= g_acked + g_window) {
+        return true;  // Window full or everything in flight
+    }
+
+    // Static: keeps ~460 bytes off the Core 0 stack
+    static uint8_t raw[BULK_CHUNK_MAX];
+    static uint8_t msg[BULK_DATA_HEADER + BULK_PACKED_SIZE(BULK_CHUNK_MAX)];
+    uint32_t pos = g_next * g_chunk;
+    uint32_t len = (g_length - pos < g_chunk) ? g_length - pos : g_chunk;
+    len = g_io->read(g_object, g_offset + pos, raw, len);
+
+    put_u21_7bit(&msg[0], g_next);
+    put_u32_7bit(&msg[3], crc32_compute(raw, len));
+    uint16_t packed = bulk_pack_8to7(raw, (uint16_t)len, &msg[BULK_DATA_HEADER]);
+
+    if (g_io->send(g_io->cmd_data, msg, BULK_DATA_HEADER + packed)) {
+        if (g_next < g_sent_max) {
+            g_stats.retransmits++;
+        }
+        g_stats.chunks_sent++;
+        g_next++;
+        if (g_next > g_sent_max) g_sent_max = g_next;
+    }
+    return true;
+}
+
+bool bulk_active(void) {
+    return g_active;
+}
+
+bool bulk_active_object(uint8_t object) {
+    return g_active && g_object == object;
+}
+
+void bulk_get_stats(bulk_stats_t *stats) {
+    *stats = g_stats;
+}
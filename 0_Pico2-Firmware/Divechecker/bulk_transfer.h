@@ -0,0 +1,117 @@
+/**
+ * @file bulk_transfer.h
+ * @brief Windowed bulk download over SysEx (8-to-7 packed chunks)
+ *
+ * The host opens an object (e.g. the recorder ring) at a byte offset with
+ * its preferred chunk size and window. The device then streams up to
+ * `window` unacknowledged chunks:
+ *
+ *   CMD_BULK_DATA: [seq x3][crc32 x5][8-to-7 packed chunk]
+ *
+ * seq counts chunks from the start offset (offset + seq * chunk_size),
+ * the CRC32 covers the unpacked bytes. The host acknowledges cumulatively
+ * (next expected seq); on a gap or CRC error it asks for a retransmit from
+ * that seq (go-back-N). Without ACK progress the device rewinds to the
+ * oldest unacknowledged chunk on its own. A broken transfer is resumed by
+ * starting again at the last good offset.
+ *
+ * Transport-agnostic (I/O via callbacks) so the host benchmark runs the
+ * exact same code. Core 0 only on the device.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef BULK_TRANSFER_H
+#define BULK_TRANSFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BULK_CHUNK_MIN          7
+#define BULK_CHUNK_MAX          210     // 210 + 30 packing + 8 header = 248 <= 251 SysEx data bytes
+#define BULK_CHUNK_DEFAULT      196
+#define BULK_WINDOW_MAX         64
+#define BULK_WINDOW_DEFAULT     16
+#define BULK_DATA_HEADER        8       // seq (3) + crc32 (5)
+#define BULK_RETX_TIMEOUT_MS    250     // No ACK progress: go back N
+#define BULK_MAX_TIMEOUTS       20      // Give up (host gone)
+
+/// Packed size of n raw bytes
+#define BULK_PACKED_SIZE(n)     ((n) + ((n) + 6) / 7)
+
+// Start status (same codes as CMD_ACK)
+#define BULK_STATUS_OK          0x00
+#define BULK_STATUS_INVALID     0x01
+#define BULK_STATUS_BUSY        0x03
+
+typedef struct {
+    /// Object size in bytes, 0 if unknown/empty
+    uint32_t (*size)(uint8_t object);
+    /// Copy len bytes at offset; returns bytes copied
+    uint32_t (*read)(uint8_t object, uint32_t offset, uint8_t *dst, uint32_t len);
+    /// Send one SysEx message (7-bit data); false if it could not be queued
+    bool (*send)(uint8_t command, const uint8_t *data, uint16_t len);
+    /// Millisecond clock
+    uint32_t (*now_ms)(void);
+    /// Whether the object can be opened right now (may be NULL)
+    bool (*available)(uint8_t object);
+    uint8_t cmd_info;       // Device -> host: transfer parameters
+    uint8_t cmd_data;       // Device -> host: one chunk
+} bulk_io_t;
+
+typedef struct {
+    uint32_t chunks_sent;
+    uint32_t retransmits;       // Chunks sent again (go-back-N)
+    uint32_t timeouts;
+    uint32_t transfers;         // Completed transfers
+} bulk_stats_t;
+
+void bulk_init(const bulk_io_t *io);
+
+/**
+ * @brief Open an object and reply with the info message
+ * @param chunk Raw bytes per chunk (BULK_CHUNK_MIN..BULK_CHUNK_MAX)
+ * @param window Unacknowledged chunks in flight (1..BULK_WINDOW_MAX)
+ * @return BULK_STATUS_*
+ */
+uint8_t bulk_start(uint8_t object, uint32_t offset, uint16_t chunk, uint8_t window);
+
+/**
+ * @brief Host acknowledgment
+ * @param next_seq Every chunk below this seq has been received intact
+ * @param retransmit Resend starting at next_seq right away
+ */
+void bulk_ack(uint32_t next_seq, bool retransmit);
+
+void bulk_abort(void);
+
+/**
+ * @brief Send at most one chunk; call from the main loop
+ * @return true while a transfer is running
+ */
+bool bulk_task(void);
+
+bool bulk_active(void);
+
+/**
+ * @brief Whether a transfer of this object is running
+ */
+bool bulk_active_object(uint8_t object);
+
+void bulk_get_stats(bulk_stats_t *stats);
+
+/**
+ * @brief MIDI-style 8-to-7 packing: per 7 bytes, one byte of MSBs first
+ * @return Packed length (BULK_PACKED_SIZE(len))
+ */
+uint16_t bulk_pack_8to7(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+/**
+ * @brief Inverse of bulk_pack_8to7
+ * @return Unpacked length
+ */
+uint16_t bulk_unpack_7to8(const uint8_t *src, uint16_t len, uint8_t *dst);
+
+#endif // BULK_TRANSFER_H
@@ -0,0 +1,144 @@
+/**
+ * @file burst.c
+ * @brief Time-limited full-rate streaming of every internal sample
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "burst.h"
+#include "pico/util/queue.h"
+#include "hardware/sync.h"
+
+_Static_assert(BURST_BATCH_HEADER + BURST_BATCH_MAX * BURST_SAMPLE_BYTES <= 251,
+               "burst batch must fit one SysEx message");
+_Static_assert(BURST_BATCH_HEADER + BURST_RAW_BATCH_MAX * BURST_RAW_SAMPLE_BYTES <= 251,
+               "raw batch must fit one SysEx message");
+
+static queue_t g_queue;
+static volatile bool g_active = false;      // Core 0 writes, Core 1 reads
+static volatile uint8_t g_mode = BURST_MODE_PRESSURE;
+static volatile uint32_t g_dropped = 0;     // Core 1 writes, Core 0 reads
+
+// Core 0 only
+static bool g_open = false;                 // Until the LAST frame went out
+static uint32_t g_end_us = 0;
+static uint32_t g_dropped_seen = 0;
+static burst_batch_t g_batch;
+
+void burst_init(void) {
+    queue_init(&g_queue, sizeof(burst_sample_t), BURST_QUEUE_SIZE);
+}
+
+bool burst_start(burst_mode_t mode, uint32_t duration_ms, uint32_t now_us) {
+    if (duration_ms == 0 || duration_ms > BURST_MAX_DURATION_MS) {
+        return false;
+    }
+    if (g_open && g_mode != mode) {
+        return false;  // Let the other mode finish (or stop it) first
+    }
+
+    if (!g_open) {
+        // Stragglers pushed after the previous LAST frame
+        burst_sample_t discard;
+        while (queue_try_remove(&g_queue, &discard)) {}
+        g_mode = mode;
+        g_batch.mode = mode;
+        g_batch.flags = 0;
+        g_batch.seq = 0;
+        g_batch.count = 0;
+        g_dropped_seen = g_dropped;
+    }
+    // A start while open (even while finishing) just moves the deadline
+    g_batch.flags &= ~BURST_FLAG_LAST;
+    g_end_us = now_us + duration_ms * 1000u;
+    g_open = true;
+    __dmb();
+    g_active = true;
+    return true;
+}
+
+void burst_stop(void) {
+    g_active = false;
+}
+
+bool burst_is_active(burst_mode_t mode) {
+    return g_active && g_mode == mode;
+}
+
+burst_mode_t burst_mode(void) {
+    return (burst_mode_t)g_mode;
+}
+
+static bool push(const burst_sample_t *sample) {
+    if (!queue_try_add(&g_queue, sample)) {
+        g_dropped++;
+        return false;
+    }
+    return true;
+}
+
+bool burst_core1_push(int32_t delta_x1000, uint32_t t_us) {
+    burst_sample_t sample = { .t_us = t_us, .delta_x1000 = delta_x1000 };
+    return push(&sample);
+}
+
+bool burst_core1_push_raw(uint32_t adc_P, uint32_t adc_T, uint32_t t_us) {
+    burst_sample_t sample = { .t_us = t_us, .adc_P = adc_P, .adc_T = adc_T };
+    return push(&sample);
+}
+
+static uint8_t batch_capacity(void) {
+    return (g_batch.mode == BURST_MODE_RAW) ? BURST_RAW_BATCH_MAX : BURST_BATCH_MAX;
+}
+
+bool burst_pop(burst_sample_t *sample) {
+    if (g_batch.count >= batch_capacity()) {
+        return false;
+    }
+    return queue_try_remove(&g_queue, sample);
+}
+
+void burst_batch_add(const burst_sample_t *sample) {
+    if (g_batch.count < batch_capacity()) {
+        g_batch.samples[g_batch.count++] = *sample;
+    }
+}
+
+const burst_batch_t *burst_batch_ready(uint32_t now_us) {
+    if (!g_open) {
+        return NULL;
+    }
+    if (g_active && (int32_t)(now_us - g_end_us) >= 0) {
+        g_active = false;
+    }
+
+    uint32_t dropped = g_dropped;
+    if (dropped != g_dropped_seen) {
+        g_dropped_seen = dropped;
+        g_batch.flags |= BURST_FLAG_DROPPED;
+    }
+
+    if (!g_active && queue_get_level(&g_queue) == 0) {
+        g_batch.flags |= BURST_FLAG_LAST;
+        return &g_batch;
+    }
+    if (g_batch.count >= BURST_BATCH_SAMPLES) {
+        return &g_batch;
+    }
+    if (g_batch.count > 0 &&
+        now_us - g_batch.samples[0].t_us >= BURST_BATCH_MAX_AGE_MS * 1000u) {
+        return &g_batch;
+    }
+    return NULL;
+}
+
+void burst_batch_sent(void) {
+    if (g_batch.flags & BURST_FLAG_LAST) {
+        g_open = false;
+    }
+    g_batch.seq++;
+    g_batch.flags = 0;
+    g_batch.count = 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file burst.h
+ * @brief Time-limited full-rate streaming of every internal sample
+ *
+ * While a burst is active Core 1 skips the averager and pushes each sample
+ * with its read time into a dedicated inter-core queue, deeper than the
+ * averaged-frame queue so USB hiccups do not cost samples. Core 0 packs
+ * the samples into batched frames. Two modes:
+ *
+ *   PRESSURE - every valid 100 Hz reading (baseline-relative, no noise
+ *              floor):
+ *     CMD_PRESSURE_BATCH: [flags][seq x3][t0_us x5][count]
+ *                         count x ([dt_us x3][delta x5])
+ *
+ *   RAW      - uncompensated 20-bit adc_P/adc_T at the sensor's own output
+ *              rate; the host compensates with the CMD_CALIBRATION block:
+ *     CMD_RAW_BATCH:      [flags][seq x3][t0_us x5][count]
+ *                         count x ([dt_us x3][adc_P << 20 | adc_T x6])
+ *
+ * t0_us is the read time of the first sample (time_us_32), dt_us the gap
+ * to the previous sample (0 for the first), delta uses the CMD_PRESSURE
+ * encoding. The burst ends on its own after the requested duration (a new
+ * start extends it) and the configured output rate resumes; the last frame
+ * carries BURST_FLAG_LAST.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef BURST_H
+#define BURST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "divechecker_config.h"
+
+#define BURST_QUEUE_SIZE        DIVECHECKER_BURST_QUEUE // Profile (standard: 2.56 s at 100 Hz, 3KB)
+#define BURST_MAX_DURATION_MS   60000
+#define BURST_BATCH_SAMPLES     10      // Send once this many are pending...
+#define BURST_BATCH_MAX_AGE_MS  100     // ...or the oldest is this old
+#define BURST_BATCH_MAX         30      // 10 + 30 * 8 = 250 <= 251 SysEx data bytes
+#define BURST_BATCH_HEADER      10
+#define BURST_SAMPLE_BYTES      8
+#define BURST_RAW_BATCH_MAX     26      // 10 + 26 * 9 = 244
+#define BURST_RAW_SAMPLE_BYTES  9
+
+// Batch flags
+#define BURST_FLAG_LAST         0x01    // Final frame of the burst
+#define BURST_FLAG_DROPPED      0x02    // Samples were lost before this frame
+
+typedef enum {
+    BURST_MODE_PRESSURE = 0,
+    BURST_MODE_RAW,
+} burst_mode_t;
+
+typedef struct {
+    uint32_t t_us;                  // Read completion time (time_us_32)
+    union {
+        int32_t delta_x1000;        // PRESSURE: hPa x1000 from baseline
+        struct {                    // RAW: 20-bit ADC codes
+            uint32_t adc_P;
+            uint32_t adc_T;
+        };
+    };
+} burst_sample_t;
+
+typedef struct {
+    uint8_t mode;                   // burst_mode_t
+    uint8_t flags;
+    uint32_t seq;                   // Frame counter since burst start
+    uint8_t count;
+    burst_sample_t samples[BURST_BATCH_MAX];
+} burst_batch_t;
+
+/**
+ * @brief Create the inter-core queue (before Core 1 starts)
+ */
+void burst_init(void);
+
+/**
+ * @brief Start (or extend) a burst
+ * @param duration_ms 1..BURST_MAX_DURATION_MS
+ * @param now_us time_us_32()
+ * @return false if the duration is out of range or a burst of the other
+ *         mode is still open
+ */
+bool burst_start(burst_mode_t mode, uint32_t duration_ms, uint32_t now_us);
+
+/**
+ * @brief End the burst early (the last frame is still sent)
+ */
+void burst_stop(void);
+
+/**
+ * @brief Whether a burst of this mode is running (Core 1 bypasses the averager)
+ */
+bool burst_is_active(burst_mode_t mode);
+
+/**
+ * @brief Mode of the current (or last) burst
+ */
+burst_mode_t burst_mode(void);
+
+/**
+ * @brief Core 1: queue one sample (PRESSURE mode)
+ * @return false if the queue was full (sample dropped)
+ */
+bool burst_core1_push(int32_t delta_x1000, uint32_t t_us);
+
+/**
+ * @brief Core 1: queue one uncompensated reading (RAW mode)
+ * @return false if the queue was full (sample dropped)
+ */
+bool burst_core1_push_raw(uint32_t adc_P, uint32_t adc_T, uint32_t t_us);
+
+/**
+ * @brief Core 0: take one queued sample, unless the pending batch is full
+ */
+bool burst_pop(burst_sample_t *sample);
+
+/**
+ * @brief Core 0: add a popped sample to the pending batch
+ */
+void burst_batch_add(const burst_sample_t *sample);
+
+/**
+ * @brief Core 0: batch due for sending (full, aged, or final), else NULL
+ * @details Also ends the burst once its duration has passed.
+ * @param now_us time_us_32()
+ */
+const burst_batch_t *burst_batch_ready(uint32_t now_us);
+
+/**
+ * @brief Core 0: the batch from burst_batch_ready() went out
+ */
+void burst_batch_sent(void);
+
+#endif // BURST_H
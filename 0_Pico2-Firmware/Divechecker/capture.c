@@ -0,0 +1,175 @@
+/**
+ * @file capture.c
+ * @brief Pre/post-trigger capture of raw 100 Hz samples
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "capture.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+typedef struct {
+    uint32_t t_us;
+    int32_t value_x1000;
+} capture_sample_t;
+
+static capture_sample_t g_ring[CAPTURE_MAX_SAMPLES];
+
+// Core 1 working state
+static capture_config_t g_cfg;
+static uint16_t g_write = 0;            // Next ring slot
+static uint16_t g_filled = 0;           // Valid samples in the ring
+static uint16_t g_post_left = 0;
+static uint16_t g_trigger_slot = 0;
+static int32_t g_prev_value = 0;
+static bool g_have_prev = false;
+
+// Shared (Core 1 writes state/frozen fields, Core 0 reads after the barrier)
+static volatile uint8_t g_state = CAPTURE_STATE_OFF;
+static volatile uint8_t g_id = 0;
+static volatile uint16_t g_frozen_first = 0;    // Ring slot of the oldest frozen sample
+static volatile uint16_t g_frozen_count = 0;
+static volatile uint16_t g_frozen_pre = 0;
+static volatile int32_t g_trigger_value = 0;
+
+// Core 0 -> Core 1 handoff
+static capture_config_t g_pending_cfg;
+static volatile bool g_pending = false;
+static bool g_frozen_reported = false;          // Core 0 only
+
+bool capture_configure(const capture_config_t *cfg) {
+    if (cfg->mode != CAPTURE_TRIGGER_OFF &&
+        (cfg->post_samples == 0 ||
+         (uint32_t)cfg->pre_samples + cfg->post_samples > CAPTURE_MAX_SAMPLES ||
+         cfg->mode > CAPTURE_TRIGGER_SLOPE)) {
+        return false;
+    }
+    g_pending_cfg = *cfg;
+    __dmb();  // Config visible before the flag
+    g_pending = true;
+    return true;
+}
+
+void capture_rearm(void) {
+    capture_config_t cfg = g_pending_cfg;
+    capture_configure(&cfg);
+}
+
+void capture_get_status(capture_status_t *status) {
+    status->state = g_state;
+    status->id = g_id;
+    status->mode = g_pending_cfg.mode;
+    bool frozen = (g_state == CAPTURE_STATE_FROZEN);
+    __dmb();
+    status->samples = frozen ? g_frozen_count : 0;
+    status->pre_samples = frozen ? g_frozen_pre : 0;
+    status->trigger_value = frozen ? g_trigger_value : 0;
+}
+
+bool capture_take_frozen_event(void) {
+    bool frozen = (g_state == CAPTURE_STATE_FROZEN) && !g_pending;
+    if (!frozen) {
+        g_frozen_reported = false;
+        return false;
+    }
+    if (g_frozen_reported) return false;
+    g_frozen_reported = true;
+    return true;
+}
+
+uint32_t capture_size(void) {
+    if (g_state != CAPTURE_STATE_FROZEN || g_pending) return 0;
+    __dmb();
+    return (uint32_t)g_frozen_count * CAPTURE_SAMPLE_BYTES;
+}
+
+uint32_t capture_read(uint32_t offset, uint8_t *dst, uint32_t len) {
+    uint32_t total = capture_size();
+    uint32_t t_trigger = g_ring[(g_frozen_first + g_frozen_pre) % CAPTURE_MAX_SAMPLES].t_us;
+    uint32_t copied = 0;
+    while (copied < len && offset < total) {
+        uint32_t index = offset / CAPTURE_SAMPLE_BYTES;
+        uint32_t in_sample = offset % CAPTURE_SAMPLE_BYTES;
+        const capture_sample_t *s = &g_ring[(g_frozen_first + index) % CAPTURE_MAX_SAMPLES];
+        uint8_t bytes[CAPTURE_SAMPLE_BYTES];
+        int32_t dt_us = (int32_t)(s->t_us - t_trigger);
+        memcpy(&bytes[0], &dt_us, sizeof(dt_us));
+        memcpy(&bytes[4], &s->value_x1000, sizeof(s->value_x1000));
+        uint32_t n = CAPTURE_SAMPLE_BYTES - in_sample;
+        if (n > len - copied) n = len - copied;
+        memcpy(&dst[copied], &bytes[in_sample], n);
+        copied += n;
+        offset += n;
+    }
+    return copied;
+}
+
+static bool trigger_fired(int32_t value) {
+    uint32_t magnitude = (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    bool fired = false;
+    if (g_have_prev) {
+        if (g_cfg.mode == CAPTURE_TRIGGER_LEVEL) {
+            uint32_t prev = (g_prev_value < 0) ? (uint32_t)(-(int64_t)g_prev_value)
+                                               : (uint32_t)g_prev_value;
+            fired = (magnitude >= g_cfg.level_x1000 && prev < g_cfg.level_x1000);
+        } else if (g_cfg.mode == CAPTURE_TRIGGER_SLOPE) {
+            int64_t step = (int64_t)value - g_prev_value;
+            if (step < 0) step = -step;
+            fired = ((uint64_t)step >= g_cfg.level_x1000);
+        }
+    }
+    g_prev_value = value;
+    g_have_prev = true;
+    return fired;
+}
+
+void capture_core1_sample(int32_t value_x1000, uint32_t t_us) {
+    if (g_pending) {
+        __dmb();
+        g_cfg = g_pending_cfg;
+        g_write = 0;
+        g_filled = 0;
+        g_have_prev = false;
+        g_state = (g_cfg.mode == CAPTURE_TRIGGER_OFF) ? CAPTURE_STATE_OFF : CAPTURE_STATE_ARMED;
+        __dmb();
+        g_pending = false;
+    }
+
+    uint8_t state = g_state;
+    if (state == CAPTURE_STATE_OFF || state == CAPTURE_STATE_FROZEN) return;
+
+    uint16_t slot = g_write;
+    g_ring[slot].t_us = t_us;
+    g_ring[slot].value_x1000 = value_x1000;
+    g_write = (uint16_t)((slot + 1) % CAPTURE_MAX_SAMPLES);
+    if (g_filled < CAPTURE_MAX_SAMPLES) g_filled++;
+
+    if (state == CAPTURE_STATE_ARMED) {
+        if (trigger_fired(value_x1000)) {
+            g_trigger_slot = slot;
+            g_trigger_value = value_x1000;
+            g_post_left = g_cfg.post_samples - 1;  // Trigger sample counts as post
+            g_state = CAPTURE_STATE_TRIGGERED;
+            state = CAPTURE_STATE_TRIGGERED;
+            if (g_post_left > 0) return;
+        } else {
+            return;
+        }
+    } else if (g_post_left > 0) {
+        g_post_left--;
+        if (g_post_left > 0) return;
+    }
+
+    // Post window complete: freeze [trigger - pre, trigger + post)
+    uint16_t pre_avail = (uint16_t)(g_filled - g_cfg.post_samples);
+    uint16_t pre = (g_cfg.pre_samples < pre_avail) ? g_cfg.pre_samples : pre_avail;
+    g_frozen_first = (uint16_t)((g_trigger_slot + CAPTURE_MAX_SAMPLES - pre) % CAPTURE_MAX_SAMPLES);
+    g_frozen_pre = pre;
+    g_frozen_count = (uint16_t)(pre + g_cfg.post_samples);
+    g_id = (uint8_t)((g_id + 1) & 0x7F);
+    __dmb();  // Frozen window visible before the state change
+    g_state = CAPTURE_STATE_FROZEN;
+}
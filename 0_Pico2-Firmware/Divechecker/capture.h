@@ -0,0 +1,101 @@
+/**
+ * @file capture.h
+ * @brief Pre/post-trigger capture of raw 100 Hz samples
+ *
+ * Core 1 writes every valid internal sample (baseline-relative, no
+ * averaging, no noise floor) into a RAM ring. When the armed trigger fires
+ * it keeps writing for `post` more samples and then freezes the ring, so
+ * the last `pre` samples before the trigger and `post` after it stay put
+ * until Core 0 re-arms. The averaged output stream is not affected.
+ *
+ * Triggers:
+ *   LEVEL - |value| crosses level_x1000 from below
+ *   SLOPE - |value - previous| >= level_x1000 within one sample
+ *
+ * Ownership: Core 1 owns the ring while not frozen; Core 0 reads it only
+ * when frozen. Configuration travels through a pending copy that Core 1
+ * picks up at its next sample.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "divechecker_config.h"
+
+#define CAPTURE_MAX_SAMPLES     DIVECHECKER_CAPTURE_SAMPLES // Profile (standard: 20.48 s at 100 Hz, 16KB RAM)
+#define CAPTURE_SAMPLE_BYTES    8       // Serialized: [dt_us int32][value int32]
+
+typedef enum {
+    CAPTURE_TRIGGER_OFF = 0,
+    CAPTURE_TRIGGER_LEVEL,
+    CAPTURE_TRIGGER_SLOPE,
+} capture_trigger_t;
+
+typedef enum {
+    CAPTURE_STATE_OFF = 0,
+    CAPTURE_STATE_ARMED,        // Filling the pre-trigger ring
+    CAPTURE_STATE_TRIGGERED,    // Collecting post-trigger samples
+    CAPTURE_STATE_FROZEN,       // Ready for download
+} capture_state_t;
+
+typedef struct {
+    uint8_t mode;               // capture_trigger_t
+    uint32_t level_x1000;       // Level or per-sample slope, hPa x1000
+    uint16_t pre_samples;
+    uint16_t post_samples;
+} capture_config_t;
+
+typedef struct {
+    uint8_t state;              // capture_state_t
+    uint8_t id;                 // Increments per freeze
+    uint8_t mode;
+    uint16_t samples;           // Frozen samples (pre actually filled + post)
+    uint16_t pre_samples;       // Samples before the trigger sample
+    int32_t trigger_value;      // Value that fired the trigger, hPa x1000
+} capture_status_t;
+
+/**
+ * @brief Set trigger and window, and arm (mode OFF disarms) — Core 0
+ * @return false if pre + post exceeds CAPTURE_MAX_SAMPLES or post is 0
+ */
+bool capture_configure(const capture_config_t *cfg);
+
+/**
+ * @brief Discard the frozen capture and arm again — Core 0
+ */
+void capture_rearm(void);
+
+/**
+ * @brief Current status — Core 0
+ */
+void capture_get_status(capture_status_t *status);
+
+/**
+ * @brief True once per freeze (for the host notification) — Core 0
+ */
+bool capture_take_frozen_event(void);
+
+/**
+ * @brief Serialized size of the frozen capture, 0 if not frozen — Core 0
+ */
+uint32_t capture_size(void);
+
+/**
+ * @brief Copy serialized samples, oldest first; dt_us is relative to the
+ *        trigger sample — Core 0, frozen only
+ * @return Bytes copied
+ */
+uint32_t capture_read(uint32_t offset, uint8_t *dst, uint32_t len);
+
+/**
+ * @brief Feed one raw sample — Core 1, every valid internal sample
+ */
+void capture_core1_sample(int32_t value_x1000, uint32_t t_us);
+
+#endif // CAPTURE_H
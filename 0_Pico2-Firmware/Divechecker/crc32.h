@@ -0,0 +1,43 @@
+/**
+ * @file crc32.h
+ * @brief CRC32 (polynomial 0xEDB88320, same as zlib/PNG)
+ *
+ * Portable slice-by-8 software implementation, shared with the host tools.
+ * The firmware checks flash-resident data through crc32_region()
+ * (crc32_dma.h), which hands large regions to the DMA sniffer and falls
+ * back to this code.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Build the lookup tables (8KB RAM)
+ * @note Called on first use otherwise; the firmware calls it before
+ *       Core 1 starts so both cores only ever read the tables.
+ */
+void crc32_init(void);
+
+/**
+ * @brief Compute CRC32 over a buffer
+ * @param data Input bytes
+ * @param len Number of bytes
+ * @return Final CRC32 (init 0xFFFFFFFF, final XOR 0xFFFFFFFF)
+ */
+uint32_t crc32_compute(const uint8_t *data, size_t len);
+
+/**
+ * @brief Continue a CRC32 over the next piece of data (zlib crc32() style)
+ * @param crc Result for the data so far, 0 to start
+ * @return CRC32 of everything so far
+ */
+uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len);
+
+#endif // CRC32_H
@@ -0,0 +1,62 @@
+/**
+ * @file crc32_dma.c
+ * @brief CRC32 of flash-resident data, on the DMA sniffer when it pays
+ *
+ * The sniffer's CRC32R mode feeds each byte LSB first into an MSB-first
+ * CRC-32 register, so the register holds the bit-reverse of the zlib
+ * state: the seed is bitrev(~crc), and reading it back with output
+ * reverse + invert gives the zlib result directly. 8-bit transfers keep
+ * the byte order independent of alignment; the destination is a single
+ * dummy byte.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "crc32_dma.h"
+#include "crc32.h"
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+
+static int g_dma_chan = -1;
+static uint8_t g_dma_sink;
+
+static uint32_t bitrev32(uint32_t v) {
+    v = ((v >> 1) & 0x55555555u) | ((v & 0x55555555u) << 1);
+    v = ((v >> 2) & 0x33333333u) | ((v & 0x33333333u) << 2);
+    v = ((v >> 4) & 0x0F0F0F0Fu) | ((v & 0x0F0F0F0Fu) << 4);
+    return __builtin_bswap32(v);  // Once per region
+}
+
+bool crc32_dma_init(void) {
+    crc32_init();
+    if (g_dma_chan < 0) {
+        g_dma_chan = dma_claim_unused_channel(false);
+    }
+    return g_dma_chan >= 0;
+}
+
+uint32_t crc32_region(uint32_t crc, const void *data, size_t len) {
+    if (g_dma_chan < 0 || len < CRC32_DMA_MIN_LEN || get_core_num() != 0) {
+        return crc32_update(crc, (const uint8_t *)data, len);
+    }
+
+    dma_channel_config c = dma_channel_get_default_config((uint)g_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_sniff_enable(&c, true);
+
+    dma_sniffer_enable((uint)g_dma_chan, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true);
+    dma_sniffer_set_output_reverse_enabled(true);
+    dma_sniffer_set_output_invert_enabled(true);
+    dma_sniffer_set_data_accumulator(bitrev32(~crc));
+
+    dma_channel_configure((uint)g_dma_chan, &c, &g_dma_sink, data, len, true);
+    dma_channel_wait_for_finish_blocking((uint)g_dma_chan);
+
+    uint32_t result = dma_sniffer_get_data_accumulator();
+    dma_sniffer_disable();
+    return result;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file crc32_dma.h
+ * @brief CRC32 of flash-resident data, on the DMA sniffer when it pays
+ *
+ * Regions of CRC32_DMA_MIN_LEN bytes or more are streamed through a DMA
+ * channel with the sniffer in bit-reversed CRC-32 mode (output reversed
+ * and inverted), which gives the same value as crc32_compute() at about
+ * one byte per clk_sys cycle and without evicting the XIP cache. Shorter
+ * regions, Core 1 callers (the sniffer is one shared unit, owned by
+ * Core 0) and boots where no DMA channel is free use the slice-by-8
+ * software path.
+ *
+ * Use this for any data checked in place in flash (settings, recorder
+ * pages, images); crc32_compute() stays the portable entry point for
+ * code shared with the host tools.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef CRC32_DMA_H
+#define CRC32_DMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define CRC32_DMA_MIN_LEN       64      // Below this the channel setup costs more
+
+/**
+ * @brief Build the software tables and claim a DMA channel for the sniffer
+ * @note Call once on Core 0 before Core 1 starts
+ * @return true if the DMA path is available
+ */
+bool crc32_dma_init(void);
+
+/**
+ * @brief CRC32 of a region (RAM or XIP flash), continuing from crc
+ * @param crc Result for the data so far, 0 to start (as crc32_update)
+ * @return Same value crc32_update() would return
+ */
+uint32_t crc32_region(uint32_t crc, const void *data, size_t len);
+
+#endif // CRC32_DMA_H
@@ -0,0 +1,83 @@
+/**
+ * @file flash_io.c
+ * @brief Safe flash program/erase helpers (Core 0 only)
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "flash_io.h"
+#include "power.h"
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+static volatile uint32_t g_lockout_count = 0;
+
+// Pause Core 1 only once it can honour the request; before launch (boot)
+// there is nothing executing from flash on the other core.
+static bool flash_io_begin(uint32_t *irq_state) {
+    bool lockout = multicore_lockout_victim_is_initialized(1);
+    if (lockout) {
+        multicore_lockout_start_blocking();
+    }
+    *irq_state = save_and_disable_interrupts();
+    return lockout;
+}
+
+static void flash_io_end(uint32_t irq_state, bool lockout) {
+    restore_interrupts(irq_state);
+    if (lockout) {
+        multicore_lockout_end_blocking();
+    }
+    g_lockout_count++;
+    __dmb();  // Publish the counter before Core 1 resumes sampling
+}
+
+void flash_io_program(uint32_t offset, const uint8_t *data, size_t len) {
+    if (len == 0) return;
+
+    uint8_t page[FLASH_PAGE_SIZE];
+    uint32_t page_off = offset & ~(uint32_t)(FLASH_PAGE_SIZE - 1);
+    uint32_t end = offset + len;
+
+    uint32_t irq_state;
+    bool lockout = flash_io_begin(&irq_state);
+    for (; page_off < end; page_off += FLASH_PAGE_SIZE) {
+        uint32_t from = (offset > page_off) ? offset : page_off;
+        uint32_t to = (end < page_off + FLASH_PAGE_SIZE) ? end : page_off + FLASH_PAGE_SIZE;
+        memset(page, 0xFF, sizeof(page));
+        memcpy(&page[from - page_off], &data[from - offset], to - from);
+        flash_range_program(page_off, page, FLASH_PAGE_SIZE);
+    }
+    flash_io_end(irq_state, lockout);
+}
+
+void flash_io_erase_sector(uint32_t offset) {
+    // Only an erase is long enough to be worth two clock changes
+    power_profile_t power_token = power_enter(POWER_PROFILE_FLASH);
+    uint32_t irq_state;
+    bool lockout = flash_io_begin(&irq_state);
+    flash_range_erase(offset & ~(uint32_t)(FLASH_SECTOR_SIZE - 1), FLASH_SECTOR_SIZE);
+    flash_io_end(irq_state, lockout);
+    power_leave(power_token);
+}
+
+const uint8_t* flash_io_read_ptr(uint32_t offset) {
+    return (const uint8_t*)(XIP_BASE + offset);
+}
+
+bool flash_io_is_blank(uint32_t offset, size_t len) {
+    const uint8_t *p = flash_io_read_ptr(offset);
+    for (size_t i = 0; i < len; i++) {
+        if (p[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+uint32_t flash_io_lockout_count(void) {
+    return g_lockout_count;
+}
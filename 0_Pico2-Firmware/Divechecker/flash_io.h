@@ -0,0 +1,57 @@
+/**
+ * @file flash_io.h
+ * @brief Safe flash program/erase helpers (Core 0 only)
+ *
+ * Core 1 executes from XIP flash, so every program/erase pauses it via
+ * multicore lockout (once it has registered as a lockout victim) and runs
+ * with interrupts disabled. Each operation bumps a lockout counter that
+ * Core 1 watches to excuse transient I2C errors after it resumes. Erases
+ * run under the flash clock profile (power.h): both cores only wait on the
+ * chip meanwhile. A program (~1 ms a page) stays at the current clock,
+ * which is cheaper than re-timing the buses twice around it.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef FLASH_IO_H
+#define FLASH_IO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Program bytes at any offset (NOR semantics: can only clear bits)
+ * @details Touched pages are padded with 0xFF, which leaves already
+ *          programmed bytes unchanged, so appends smaller than a page work.
+ * @param offset Flash offset (from start of flash, not XIP address)
+ * @param data Source bytes (must not reside in flash)
+ * @param len Number of bytes
+ */
+void flash_io_program(uint32_t offset, const uint8_t *data, size_t len);
+
+/**
+ * @brief Erase one 4KB sector (~100-400ms, blocks both cores)
+ * @param offset Sector-aligned flash offset
+ */
+void flash_io_erase_sector(uint32_t offset);
+
+/**
+ * @brief Memory-mapped (XIP) read pointer for a flash offset
+ */
+const uint8_t* flash_io_read_ptr(uint32_t offset);
+
+/**
+ * @brief Check whether a flash range reads as erased (all 0xFF)
+ */
+bool flash_io_is_blank(uint32_t offset, size_t len);
+
+/**
+ * @brief Number of flash operations that paused Core 1 so far
+ * @details Core 1 compares against its last seen value to detect lockouts.
+ */
+uint32_t flash_io_lockout_count(void);
+
+#endif // FLASH_IO_H
@@ -0,0 +1,196 @@
+/**
+ * @file flash_maint.c
+ * @brief Background flash maintenance: pre-erased sectors and wear tracking
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "flash_maint.h"
+#include "flash_io.h"
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include <string.h>
+
+#define FLASH_MAINT_TOTAL_SECTORS   (PICO_FLASH_SIZE_BYTES / FLASH_SECTOR_SIZE)
+
+typedef enum {
+    SECTOR_UNMANAGED = 0,
+    SECTOR_ERASED,      // Stamped header, data area blank
+    SECTOR_BLANK,       // Fully blank but never stamped (fresh chip)
+    SECTOR_IN_USE,      // Owned by a client
+    SECTOR_DIRTY,       // Needs erase before reuse
+} sector_state_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t erase_count;
+} sector_header_t;
+
+_Static_assert(sizeof(sector_header_t) == FLASH_MAINT_DATA_OFFSET, "sector header size");
+
+typedef struct {
+    uint16_t first;     // Global sector index
+    uint16_t count;
+} maint_region_t;
+
+// Indexed by global sector number (offset / FLASH_SECTOR_SIZE)
+static uint8_t g_state[FLASH_MAINT_TOTAL_SECTORS];
+static uint32_t g_erase_count[FLASH_MAINT_TOTAL_SECTORS];
+
+static maint_region_t g_regions[FLASH_MAINT_MAX_REGIONS];
+static int g_num_regions = 0;
+static uint16_t g_next_scan = 0;    // Round-robin position for idle erases
+static uint64_t g_last_erase_ms = 0;
+static uint32_t g_idle_erases = 0;
+static uint32_t g_forced_erases = 0;
+
+static inline uint32_t sector_index(uint32_t offset) {
+    return offset / FLASH_SECTOR_SIZE;
+}
+
+static inline bool sector_managed(uint32_t idx) {
+    return idx < FLASH_MAINT_TOTAL_SECTORS && g_state[idx] != SECTOR_UNMANAGED;
+}
+
+static void stamp_header(uint32_t idx) {
+    sector_header_t hdr = { .magic = FLASH_MAINT_MAGIC, .erase_count = g_erase_count[idx] };
+    flash_io_program(idx * FLASH_SECTOR_SIZE, (const uint8_t*)&hdr, sizeof(hdr));
+}
+
+static void erase_and_stamp(uint32_t idx) {
+    flash_io_erase_sector(idx * FLASH_SECTOR_SIZE);
+    g_erase_count[idx]++;
+    stamp_header(idx);
+    g_state[idx] = SECTOR_ERASED;
+}
+
+int flash_maint_add_region(uint32_t offset, uint16_t num_sectors) {
+    if (g_num_regions >= FLASH_MAINT_MAX_REGIONS) return -1;
+    uint32_t first = sector_index(offset);
+    if (first + num_sectors > FLASH_MAINT_TOTAL_SECTORS) return -1;
+
+    for (uint32_t idx = first; idx < first + num_sectors; idx++) {
+        uint32_t off = idx * FLASH_SECTOR_SIZE;
+        const sector_header_t *hdr = (const sector_header_t*)flash_io_read_ptr(off);
+        if (hdr->magic == FLASH_MAINT_MAGIC) {
+            g_erase_count[idx] = hdr->erase_count;
+            bool page_blank = flash_io_is_blank(off + FLASH_MAINT_DATA_OFFSET,
+                                                FLASH_PAGE_SIZE - FLASH_MAINT_DATA_OFFSET);
+            g_state[idx] = page_blank ? SECTOR_ERASED : SECTOR_IN_USE;
+        } else {
+            // Unknown content (older layout, fresh chip): wear history unknown
+            g_erase_count[idx] = 0;
+            g_state[idx] = flash_io_is_blank(off, FLASH_SECTOR_SIZE) ? SECTOR_BLANK : SECTOR_DIRTY;
+        }
+    }
+
+    g_regions[g_num_regions].first = (uint16_t)first;
+    g_regions[g_num_regions].count = num_sectors;
+    return g_num_regions++;
+}
+
+bool flash_maint_is_erased(uint32_t sector_offset) {
+    uint32_t idx = sector_index(sector_offset);
+    return sector_managed(idx) &&
+           (g_state[idx] == SECTOR_ERASED || g_state[idx] == SECTOR_BLANK);
+}
+
+bool flash_maint_take(uint32_t sector_offset) {
+    if (!flash_maint_is_erased(sector_offset)) return false;
+    uint32_t idx = sector_index(sector_offset);
+    if (g_state[idx] == SECTOR_BLANK) {
+        stamp_header(idx);  // Program-only: the sector is already blank
+    }
+    g_state[idx] = SECTOR_IN_USE;
+    return true;
+}
+
+void flash_maint_claim(uint32_t sector_offset) {
+    uint32_t idx = sector_index(sector_offset);
+    if (sector_managed(idx)) g_state[idx] = SECTOR_IN_USE;
+}
+
+void flash_maint_release(uint32_t sector_offset) {
+    uint32_t idx = sector_index(sector_offset);
+    if (sector_managed(idx) && g_state[idx] == SECTOR_IN_USE) {
+        g_state[idx] = SECTOR_DIRTY;
+    }
+}
+
+void flash_maint_erase_now(uint32_t sector_offset) {
+    uint32_t idx = sector_index(sector_offset);
+    if (!sector_managed(idx)) return;
+    erase_and_stamp(idx);
+    g_forced_erases++;
+}
+
+void flash_maint_erase_region(int region) {
+    if (region < 0 || region >= g_num_regions) return;
+    const maint_region_t *r = &g_regions[region];
+    for (uint32_t idx = r->first; idx < (uint32_t)r->first + r->count; idx++) {
+        if (g_state[idx] == SECTOR_DIRTY) {
+            erase_and_stamp(idx);
+        }
+    }
+}
+
+bool flash_maint_task(bool idle) {
+    if (!idle || g_num_regions == 0) return false;
+
+    uint64_t now_ms = time_us_64() / 1000;
+    if (now_ms - g_last_erase_ms < FLASH_MAINT_ERASE_SPACING_MS) return false;
+
+    // Round-robin over all managed sectors, at most one erase per call
+    uint32_t total = 0;
+    for (int r = 0; r < g_num_regions; r++) total += g_regions[r].count;
+    for (uint32_t n = 0; n < total; n++) {
+        uint32_t pos = (g_next_scan + n) % total;
+        uint32_t idx = 0;
+        for (int r = 0; r < g_num_regions; r++) {
+            if (pos < g_regions[r].count) {
+                idx = g_regions[r].first + pos;
+                break;
+            }
+            pos -= g_regions[r].count;
+        }
+        if (g_state[idx] == SECTOR_DIRTY) {
+            erase_and_stamp(idx);
+            g_idle_erases++;
+            g_next_scan = (uint16_t)((g_next_scan + n + 1) % total);
+            g_last_erase_ms = time_us_64() / 1000;
+            return true;
+        }
+        if (g_state[idx] == SECTOR_BLANK) {
+            // Program-only: stamping lets later boots skip the full blank check
+            stamp_header(idx);
+            g_state[idx] = SECTOR_ERASED;
+            g_next_scan = (uint16_t)((g_next_scan + n + 1) % total);
+            return false;
+        }
+    }
+    return false;
+}
+
+uint32_t flash_maint_erase_count(uint32_t sector_offset) {
+    uint32_t idx = sector_index(sector_offset);
+    return sector_managed(idx) ? g_erase_count[idx] : 0;
+}
+
+void flash_maint_get_stats(flash_maint_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->idle_erases = g_idle_erases;
+    stats->forced_erases = g_forced_erases;
+    stats->min_erase_count = UINT32_MAX;
+    for (int r = 0; r < g_num_regions; r++) {
+        for (uint32_t idx = g_regions[r].first; idx < (uint32_t)g_regions[r].first + g_regions[r].count; idx++) {
+            stats->managed++;
+            if (g_state[idx] == SECTOR_ERASED || g_state[idx] == SECTOR_BLANK) stats->erased++;
+            if (g_state[idx] == SECTOR_DIRTY) stats->dirty++;
+            if (g_erase_count[idx] > stats->max_erase_count) stats->max_erase_count = g_erase_count[idx];
+            if (g_erase_count[idx] < stats->min_erase_count) stats->min_erase_count = g_erase_count[idx];
+        }
+    }
+    if (stats->managed == 0) stats->min_erase_count = 0;
+}
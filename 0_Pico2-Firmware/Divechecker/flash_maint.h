@@ -0,0 +1,100 @@
+/**
+ * @file flash_maint.h
+ * @brief Background flash maintenance: pre-erased sectors and wear tracking
+ *
+ * Clients (settings journal, recorder, ...) register sector ranges and
+ * only ever program into sectors that were erased ahead of time. Sectors
+ * a client no longer needs are released and erased later by
+ * flash_maint_task() when the device is idle, so runtime writes never pay
+ * the ~100-400ms erase that locks out both cores.
+ *
+ * Every managed sector starts with an 8-byte header stamped right after
+ * erase: [magic 'DVSE'][erase count]. Client data begins at
+ * FLASH_MAINT_DATA_OFFSET. Clients must write into the first page as soon
+ * as they take a sector; at boot a sector whose first page is blank past
+ * the header is considered pre-erased.
+ *
+ * Core 0 only.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef FLASH_MAINT_H
+#define FLASH_MAINT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLASH_MAINT_MAGIC           0x45535644  // "DVSE"
+#define FLASH_MAINT_DATA_OFFSET     8           // Client data after the header
+#define FLASH_MAINT_MAX_REGIONS     4
+#define FLASH_MAINT_ERASE_SPACING_MS 50         // Give USB a turn between erases
+
+/**
+ * @brief Register a range of sectors and classify them from their headers
+ * @param offset Sector-aligned flash offset
+ * @param num_sectors Number of 4KB sectors
+ * @return Region id, or -1 if the table is full
+ */
+int flash_maint_add_region(uint32_t offset, uint16_t num_sectors);
+
+/**
+ * @brief Whether a sector is pre-erased and can be taken program-only
+ */
+bool flash_maint_is_erased(uint32_t sector_offset);
+
+/**
+ * @brief Take a pre-erased sector for writing
+ * @return false if the sector is not pre-erased
+ */
+bool flash_maint_take(uint32_t sector_offset);
+
+/**
+ * @brief Mark a sector as holding live client data (found at boot)
+ */
+void flash_maint_claim(uint32_t sector_offset);
+
+/**
+ * @brief Hand a sector back; it is erased at the next idle opportunity
+ */
+void flash_maint_release(uint32_t sector_offset);
+
+/**
+ * @brief Erase a sector synchronously (blocks both cores)
+ * @details Fallback when a client needs space that was not pre-erased.
+ */
+void flash_maint_erase_now(uint32_t sector_offset);
+
+/**
+ * @brief Erase released sectors of one region right away (boot time)
+ */
+void flash_maint_erase_region(int region);
+
+/**
+ * @brief Maintenance step; call from the Core 0 main loop
+ * @param idle true when a multi-100ms lockout is acceptable
+ *             (USB suspended, no app connected, nothing recording)
+ * @return true if a sector was erased
+ */
+bool flash_maint_task(bool idle);
+
+/**
+ * @brief Erase count of a sector (from its header, +1 per erase since)
+ */
+uint32_t flash_maint_erase_count(uint32_t sector_offset);
+
+typedef struct {
+    uint16_t managed;           // Sectors under maintenance
+    uint16_t erased;            // Pre-erased, ready to hand out
+    uint16_t dirty;             // Released, waiting for an idle erase
+    uint32_t idle_erases;       // Erases done by flash_maint_task()
+    uint32_t forced_erases;     // Erases that could not be deferred
+    uint32_t max_erase_count;   // Most worn managed sector
+    uint32_t min_erase_count;   // Least worn managed sector
+} flash_maint_stats_t;
+
+void flash_maint_get_stats(flash_maint_stats_t *stats);
+
+#endif // FLASH_MAINT_H
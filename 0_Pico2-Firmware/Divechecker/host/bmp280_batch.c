@@ -0,0 +1,479 @@
+/**
+ * @file bmp280_batch.c
+ * @brief Batch BMP280 compensation for hosts (scalar, AVX2, AVX-512, NEON)
+ *
+ * The vector kernels follow the scalar formula step by step in 64-bit
+ * lanes. No SIMD set has an integer divide, and AVX2/NEON lack a 64-bit
+ * multiply:
+ *   - products use the low 64 bits of a 32x32 partial-product sum, which
+ *     equals the C int64 product whenever the scalar code does not overflow
+ *     (AVX512DQ has vpmullq)
+ *   - the one division is done in double precision (|quotient| < 2^40, so
+ *     the estimate is within one of the truncated result) and then fixed
+ *     up exactly from the integer remainder
+ * Lanes with a non-positive divisor or an out-of-range quotient take the
+ * scalar path, so results are bit-exact for every input.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "bmp280_batch.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_AVX2_KERNEL 1
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#define HAVE_NEON_KERNEL 1
+#endif
+
+// Quotients beyond this go scalar (double -> int64 trick and error bound)
+#define QUOTIENT_LIMIT  1099511627776.0     // 2^40
+
+/* ============================================================================
+ * Scalar
+ * ========================================================================== */
+
+static void compensate_scalar(const bmp280_calib_t *calib,
+                              const int32_t *adc_P, const int32_t *adc_T,
+                              uint32_t *pressure, int32_t *temperature, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int32_t t_fine = bmp280_compensate_t_fine(calib, adc_T[i]);
+        pressure[i] = bmp280_compensate_p_q24_8(calib, adc_P[i], t_fine);
+        if (temperature != NULL) {
+            temperature[i] = bmp280_t_fine_to_x100(t_fine);
+        }
+    }
+}
+
+/* ============================================================================
+ * AVX2 (4 x int64 lanes)
+ * ========================================================================== */
+
+#ifdef HAVE_AVX2_KERNEL
+
+#define AVX2 __attribute__((target("avx2")))
+
+// Low 64 bits of x * k for a 32-bit constant k (sign-extended in each lane,
+// k_neg all ones when negative): two partial products instead of three
+static inline AVX2 __m256i mul64_k(__m256i x, __m256i k, __m256i k_neg) {
+    __m256i lo = _mm256_mul_epu32(x, k);
+    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), k);
+    hi = _mm256_sub_epi64(hi, _mm256_and_si256(x, k_neg));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+}
+
+// Arithmetic shift right (AVX2 only has the logical one for 64-bit lanes)
+static inline AVX2 __m256i srai64(__m256i x, int n) {
+    __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+    return _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(sign, 64 - n));
+}
+
+// Exact-to-nearest int64 -> double for the full range
+static inline AVX2 __m256d i64_to_pd(__m256i x) {
+    __m256i hi = _mm256_srai_epi32(x, 16);
+    hi = _mm256_blend_epi16(hi, _mm256_setzero_si256(), 0x33);
+    hi = _mm256_add_epi64(hi, _mm256_castpd_si256(_mm256_set1_pd(442721857769029238784.0)));
+    __m256i lo = _mm256_blend_epi16(x, _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0)),
+                                    0x88);
+    __m256d f = _mm256_sub_pd(_mm256_castsi256_pd(hi), _mm256_set1_pd(442726361368656609280.0));
+    return _mm256_add_pd(f, _mm256_castsi256_pd(lo));
+}
+
+// Integral double -> int64, valid for |x| < 2^51
+static inline AVX2 __m256i pd_to_i64(__m256d x) {
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);  // 2^52 + 2^51
+    return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x, magic)),
+                            _mm256_castpd_si256(magic));
+}
+
+// Low dword of each 64-bit lane, as 4 x int32
+static inline AVX2 __m128i lo32(__m256i x) {
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(x,
+                                  _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+}
+
+typedef struct {
+    __m256i p1, p2, p3, p3_neg, p5, p6, p6_neg, p8, p8_neg, p9, p9_neg;
+    __m256i p4_35, p7_4, none;
+} avx2_calib_t;
+
+#define AVX2_K(v)       _mm256_set1_epi64x(v)
+#define AVX2_K_NEG(v)   _mm256_set1_epi64x((v) < 0 ? -1 : 0)
+
+/**
+ * Pressure for 4 lanes. Beyond the scalar formula's own limits, the fast
+ * path needs t_fine - 128000 to fit in int32 (single 32x32 products for the
+ * temperature terms), a positive divisor (always < 2^31 after the >> 33)
+ * and |quotient| < 2^40 (so p >> 13 fits in int32); other lanes set *bad.
+ */
+static inline AVX2 __m256i pressure4_avx2(const avx2_calib_t *k, __m128i t_fine,
+                                          __m128i adc_P, __m256i *bad) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi64x(1);
+
+    __m256i pv1 = _mm256_sub_epi64(_mm256_cvtepi32_epi64(t_fine), _mm256_set1_epi64x(128000));
+    __m256i oob = _mm256_cmpgt_epi64(_mm256_set1_epi64x(INT32_MIN), pv1);
+    __m256i sq = _mm256_mul_epi32(pv1, pv1);
+    __m256i pv2 = mul64_k(sq, k->p6, k->p6_neg);
+    pv2 = _mm256_add_epi64(pv2, _mm256_slli_epi64(_mm256_mul_epi32(pv1, k->p5), 17));
+    pv2 = _mm256_add_epi64(pv2, k->p4_35);
+    __m256i a = srai64(mul64_k(sq, k->p3, k->p3_neg), 8);
+    __m256i b = _mm256_slli_epi64(_mm256_mul_epi32(pv1, k->p2), 12);
+    pv1 = _mm256_add_epi64(_mm256_set1_epi64x((int64_t)1 << 47), _mm256_add_epi64(a, b));
+    pv1 = srai64(mul64_k(pv1, k->p1, k->none), 33);
+    oob = _mm256_or_si256(oob, _mm256_cmpgt_epi64(one, pv1));
+
+    __m256i p = _mm256_sub_epi64(_mm256_set1_epi64x(1048576), _mm256_cvtepi32_epi64(adc_P));
+    __m256i num = mul64_k(_mm256_sub_epi64(_mm256_slli_epi64(p, 31), pv2),
+                          _mm256_set1_epi64x(3125), k->none);
+
+    // Division: double estimate, then exact remainder fix-up
+    __m256d qd = _mm256_round_pd(_mm256_div_pd(i64_to_pd(num), _mm256_cvtepi32_pd(lo32(pv1))),
+                                 _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256d qabs = _mm256_and_pd(qd, _mm256_castsi256_pd(_mm256_set1_epi64x(INT64_MAX)));
+    oob = _mm256_or_si256(oob, _mm256_castpd_si256(
+        _mm256_cmp_pd(qabs, _mm256_set1_pd(QUOTIENT_LIMIT), _CMP_NLT_UQ)));
+    *bad = oob;
+
+    __m256i q = pd_to_i64(qd);
+    __m256i r = _mm256_sub_epi64(num, mul64_k(q, pv1, k->none));
+    __m256i num_neg = _mm256_cmpgt_epi64(zero, num);
+    // num >= 0: want 0 <= r < d; num < 0: want -d < r <= 0
+    __m256i dec = _mm256_andnot_si256(num_neg, _mm256_cmpgt_epi64(zero, r));
+    __m256i inc = _mm256_andnot_si256(num_neg, _mm256_cmpgt_epi64(r, _mm256_sub_epi64(pv1, one)));
+    inc = _mm256_or_si256(inc, _mm256_and_si256(num_neg, _mm256_cmpgt_epi64(r, zero)));
+    dec = _mm256_or_si256(dec, _mm256_and_si256(num_neg,
+                          _mm256_cmpgt_epi64(_mm256_sub_epi64(one, pv1), r)));
+    // Masks are -1 where set
+    q = _mm256_sub_epi64(_mm256_add_epi64(q, dec), inc);
+
+    __m256i qs = srai64(q, 13);
+    a = srai64(mul64_k(_mm256_mul_epi32(qs, qs), k->p9, k->p9_neg), 25);
+    b = srai64(mul64_k(q, k->p8, k->p8_neg), 19);
+    return _mm256_add_epi64(srai64(_mm256_add_epi64(q, _mm256_add_epi64(a, b)), 8), k->p7_4);
+}
+
+static AVX2 void compensate_avx2(const bmp280_calib_t *calib,
+                                 const int32_t *adc_P, const int32_t *adc_T,
+                                 uint32_t *pressure, int32_t *temperature, size_t n) {
+    const __m256i t1 = _mm256_set1_epi32(calib->dig_T1);
+    const __m256i t1x2 = _mm256_set1_epi32((int32_t)calib->dig_T1 << 1);
+    const __m256i t2 = _mm256_set1_epi32(calib->dig_T2);
+    const __m256i t3 = _mm256_set1_epi32(calib->dig_T3);
+    const avx2_calib_t k = {
+        .p1 = AVX2_K(calib->dig_P1),
+        .p2 = AVX2_K(calib->dig_P2),
+        .p3 = AVX2_K(calib->dig_P3), .p3_neg = AVX2_K_NEG(calib->dig_P3),
+        .p5 = AVX2_K(calib->dig_P5),
+        .p6 = AVX2_K(calib->dig_P6), .p6_neg = AVX2_K_NEG(calib->dig_P6),
+        .p8 = AVX2_K(calib->dig_P8), .p8_neg = AVX2_K_NEG(calib->dig_P8),
+        .p9 = AVX2_K(calib->dig_P9), .p9_neg = AVX2_K_NEG(calib->dig_P9),
+        .p4_35 = AVX2_K((int64_t)calib->dig_P4 * ((int64_t)1 << 35)),
+        .p7_4 = AVX2_K((int64_t)calib->dig_P7 * 16),
+        .none = _mm256_setzero_si256(),
+    };
+
+    // 8 samples per pass: two independent 4-lane chains keep the multiplier busy
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // Temperature: int32 lanes, exactly the scalar expression
+        __m256i at = _mm256_loadu_si256((const __m256i *)&adc_T[i]);
+        __m256i v1 = _mm256_srai_epi32(_mm256_mullo_epi32(
+            _mm256_sub_epi32(_mm256_srai_epi32(at, 3), t1x2), t2), 11);
+        __m256i d = _mm256_sub_epi32(_mm256_srai_epi32(at, 4), t1);
+        __m256i v2 = _mm256_srai_epi32(_mm256_mullo_epi32(
+            _mm256_srai_epi32(_mm256_mullo_epi32(d, d), 12), t3), 14);
+        __m256i t_fine = _mm256_add_epi32(v1, v2);
+
+        __m256i ap = _mm256_loadu_si256((const __m256i *)&adc_P[i]);
+        __m256i bad_lo, bad_hi;
+        __m256i p_lo = pressure4_avx2(&k, _mm256_castsi256_si128(t_fine),
+                                      _mm256_castsi256_si128(ap), &bad_lo);
+        __m256i p_hi = pressure4_avx2(&k, _mm256_extracti128_si256(t_fine, 1),
+                                      _mm256_extracti128_si256(ap, 1), &bad_hi);
+        __m256i bad = _mm256_or_si256(bad_lo, bad_hi);
+        if (!_mm256_testz_si256(bad, bad)) {
+            compensate_scalar(calib, &adc_P[i], &adc_T[i], &pressure[i],
+                              temperature != NULL ? &temperature[i] : NULL, 8);
+            continue;
+        }
+        _mm_storeu_si128((__m128i *)&pressure[i], lo32(p_lo));
+        _mm_storeu_si128((__m128i *)&pressure[i + 4], lo32(p_hi));
+        if (temperature != NULL) {
+            __m256i t = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(t_fine,
+                                          _mm256_set1_epi32(5)), _mm256_set1_epi32(128)), 8);
+            _mm256_storeu_si256((__m256i *)&temperature[i], t);
+        }
+    }
+    compensate_scalar(calib, &adc_P[i], &adc_T[i], &pressure[i],
+                      temperature != NULL ? &temperature[i] : NULL, n - i);
+}
+
+static int avx2_supported(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif // HAVE_AVX2_KERNEL
+
+/* ============================================================================
+ * AVX-512 (8 x int64 lanes)
+ * ========================================================================== */
+
+#ifdef HAVE_AVX2_KERNEL
+
+// AVX512DQ has what AVX2 lacks: 64-bit mullo, arithmetic shift, int64 <-> double
+#define AVX512 __attribute__((target("avx512f,avx512dq,avx512vl")))
+
+static AVX512 void compensate_avx512(const bmp280_calib_t *calib,
+                                     const int32_t *adc_P, const int32_t *adc_T,
+                                     uint32_t *pressure, int32_t *temperature, size_t n) {
+    const __m256i t1 = _mm256_set1_epi32(calib->dig_T1);
+    const __m256i t1x2 = _mm256_set1_epi32((int32_t)calib->dig_T1 << 1);
+    const __m256i t2 = _mm256_set1_epi32(calib->dig_T2);
+    const __m256i t3 = _mm256_set1_epi32(calib->dig_T3);
+    const __m512i p1 = _mm512_set1_epi64(calib->dig_P1);
+    const __m512i p2 = _mm512_set1_epi64(calib->dig_P2);
+    const __m512i p3 = _mm512_set1_epi64(calib->dig_P3);
+    const __m512i p4_35 = _mm512_set1_epi64((int64_t)calib->dig_P4 * ((int64_t)1 << 35));
+    const __m512i p5 = _mm512_set1_epi64(calib->dig_P5);
+    const __m512i p6 = _mm512_set1_epi64(calib->dig_P6);
+    const __m512i p7_4 = _mm512_set1_epi64((int64_t)calib->dig_P7 * 16);
+    const __m512i p8 = _mm512_set1_epi64(calib->dig_P8);
+    const __m512i p9 = _mm512_set1_epi64(calib->dig_P9);
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512d limit = _mm512_set1_pd(QUOTIENT_LIMIT);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i at = _mm256_loadu_si256((const __m256i *)&adc_T[i]);
+        __m256i v1 = _mm256_srai_epi32(_mm256_mullo_epi32(
+            _mm256_sub_epi32(_mm256_srai_epi32(at, 3), t1x2), t2), 11);
+        __m256i d = _mm256_sub_epi32(_mm256_srai_epi32(at, 4), t1);
+        __m256i v2 = _mm256_srai_epi32(_mm256_mullo_epi32(
+            _mm256_srai_epi32(_mm256_mullo_epi32(d, d), 12), t3), 14);
+        __m256i t_fine = _mm256_add_epi32(v1, v2);
+
+        __m512i pv1 = _mm512_sub_epi64(_mm512_cvtepi32_epi64(t_fine), _mm512_set1_epi64(128000));
+        __m512i sq = _mm512_mullo_epi64(pv1, pv1);
+        __m512i pv2 = _mm512_mullo_epi64(sq, p6);
+        pv2 = _mm512_add_epi64(pv2, _mm512_slli_epi64(_mm512_mullo_epi64(pv1, p5), 17));
+        pv2 = _mm512_add_epi64(pv2, p4_35);
+        __m512i a = _mm512_srai_epi64(_mm512_mullo_epi64(sq, p3), 8);
+        __m512i b = _mm512_slli_epi64(_mm512_mullo_epi64(pv1, p2), 12);
+        pv1 = _mm512_add_epi64(_mm512_set1_epi64((int64_t)1 << 47), _mm512_add_epi64(a, b));
+        pv1 = _mm512_srai_epi64(_mm512_mullo_epi64(pv1, p1), 33);
+
+        __m512i p = _mm512_sub_epi64(_mm512_set1_epi64(1048576), _mm512_cvtepi32_epi64(
+                                     _mm256_loadu_si256((const __m256i *)&adc_P[i])));
+        __m512i num = _mm512_mullo_epi64(_mm512_sub_epi64(_mm512_slli_epi64(p, 31), pv2),
+                                         _mm512_set1_epi64(3125));
+
+        // Division: double estimate (cvtt truncates like C), exact fix-up
+        __m512d qd = _mm512_div_pd(_mm512_cvtepi64_pd(num), _mm512_cvtepi64_pd(pv1));
+        __mmask8 bad = _mm512_cmple_epi64_mask(pv1, zero) |
+                       _mm512_cmp_pd_mask(_mm512_abs_pd(qd), limit, _CMP_NLT_UQ);
+        if (bad) {
+            compensate_scalar(calib, &adc_P[i], &adc_T[i], &pressure[i],
+                              temperature != NULL ? &temperature[i] : NULL, 8);
+            continue;
+        }
+        __m512i q = _mm512_cvttpd_epi64(qd);
+        __m512i r = _mm512_sub_epi64(num, _mm512_mullo_epi64(q, pv1));
+        __mmask8 num_neg = _mm512_cmplt_epi64_mask(num, zero);
+        // num >= 0: want 0 <= r < d; num < 0: want -d < r <= 0
+        __mmask8 dec = (~num_neg & _mm512_cmplt_epi64_mask(r, zero)) |
+                       (num_neg & _mm512_cmple_epi64_mask(r, _mm512_sub_epi64(zero, pv1)));
+        __mmask8 inc = (~num_neg & _mm512_cmpge_epi64_mask(r, pv1)) |
+                       (num_neg & _mm512_cmpgt_epi64_mask(r, zero));
+        q = _mm512_mask_sub_epi64(q, dec, q, one);
+        q = _mm512_mask_add_epi64(q, inc, q, one);
+
+        __m512i qs = _mm512_srai_epi64(q, 13);
+        a = _mm512_srai_epi64(_mm512_mullo_epi64(_mm512_mullo_epi64(p9, qs), qs), 25);
+        b = _mm512_srai_epi64(_mm512_mullo_epi64(p8, q), 19);
+        p = _mm512_add_epi64(_mm512_srai_epi64(_mm512_add_epi64(q, _mm512_add_epi64(a, b)), 8),
+                             p7_4);
+
+        _mm256_storeu_si256((__m256i *)&pressure[i], _mm512_cvtepi64_epi32(p));
+        if (temperature != NULL) {
+            __m256i t = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(t_fine,
+                                          _mm256_set1_epi32(5)), _mm256_set1_epi32(128)), 8);
+            _mm256_storeu_si256((__m256i *)&temperature[i], t);
+        }
+    }
+    compensate_scalar(calib, &adc_P[i], &adc_T[i], &pressure[i],
+                      temperature != NULL ? &temperature[i] : NULL, n - i);
+}
+
+static int avx512_supported(void) {
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+           __builtin_cpu_supports("avx512vl");
+}
+
+#endif // HAVE_AVX2_KERNEL
+
+/* ============================================================================
+ * NEON (AArch64, 2 x int64 lanes)
+ * ========================================================================== */
+
+#ifdef HAVE_NEON_KERNEL
+
+static inline int64x2_t mullo64_neon(int64x2_t a, int64x2_t b) {
+    uint64x2_t ua = vreinterpretq_u64_s64(a);
+    uint64x2_t ub = vreinterpretq_u64_s64(b);
+    uint32x2_t a_lo = vmovn_u64(ua);
+    uint32x2_t b_lo = vmovn_u64(ub);
+    uint32x2_t a_hi = vshrn_n_u64(ua, 32);
+    uint32x2_t b_hi = vshrn_n_u64(ub, 32);
+    uint64x2_t cross = vmlal_u32(vmull_u32(a_hi, b_lo), a_lo, b_hi);
+    return vreinterpretq_s64_u64(vaddq_u64(vmull_u32(a_lo, b_lo), vshlq_n_u64(cross, 32)));
+}
+
+static void compensate_neon(const bmp280_calib_t *calib,
+                            const int32_t *adc_P, const int32_t *adc_T,
+                            uint32_t *pressure, int32_t *temperature, size_t n) {
+    const int32x2_t t1 = vdup_n_s32(calib->dig_T1);
+    const int32x2_t t1x2 = vdup_n_s32((int32_t)calib->dig_T1 << 1);
+    const int32x2_t t2 = vdup_n_s32(calib->dig_T2);
+    const int32x2_t t3 = vdup_n_s32(calib->dig_T3);
+    const int64x2_t p1 = vdupq_n_s64(calib->dig_P1);
+    const int64x2_t p2 = vdupq_n_s64(calib->dig_P2);
+    const int64x2_t p3 = vdupq_n_s64(calib->dig_P3);
+    const int64x2_t p4_35 = vdupq_n_s64((int64_t)calib->dig_P4 * ((int64_t)1 << 35));
+    const int64x2_t p5 = vdupq_n_s64(calib->dig_P5);
+    const int64x2_t p6 = vdupq_n_s64(calib->dig_P6);
+    const int64x2_t p7_4 = vdupq_n_s64((int64_t)calib->dig_P7 * 16);
+    const int64x2_t p8 = vdupq_n_s64(calib->dig_P8);
+    const int64x2_t p9 = vdupq_n_s64(calib->dig_P9);
+    const int64x2_t k128000 = vdupq_n_s64(128000);
+    const int64x2_t k2_47 = vdupq_n_s64((int64_t)1 << 47);
+    const int64x2_t k3125 = vdupq_n_s64(3125);
+    const int64x2_t zero = vdupq_n_s64(0);
+    const int64x2_t one = vdupq_n_s64(1);
+
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        int32x2_t at = vld1_s32(&adc_T[i]);
+        int32x2_t v1 = vshr_n_s32(vmul_s32(vsub_s32(vshr_n_s32(at, 3), t1x2), t2), 11);
+        int32x2_t d = vsub_s32(vshr_n_s32(at, 4), t1);
+        int32x2_t v2 = vshr_n_s32(vmul_s32(vshr_n_s32(vmul_s32(d, d), 12), t3), 14);
+        int32x2_t t_fine = vadd_s32(v1, v2);
+        if (temperature != NULL) {
+            vst1_s32(&temperature[i], vshr_n_s32(vadd_s32(vmul_n_s32(t_fine, 5),
+                                                          vdup_n_s32(128)), 8));
+        }
+
+        int64x2_t pv1 = vsubq_s64(vmovl_s32(t_fine), k128000);
+        int64x2_t sq = mullo64_neon(pv1, pv1);
+        int64x2_t pv2 = mullo64_neon(sq, p6);
+        pv2 = vaddq_s64(pv2, vshlq_n_s64(mullo64_neon(pv1, p5), 17));
+        pv2 = vaddq_s64(pv2, p4_35);
+        int64x2_t a = vshrq_n_s64(mullo64_neon(sq, p3), 8);
+        int64x2_t b = vshlq_n_s64(mullo64_neon(pv1, p2), 12);
+        pv1 = vshrq_n_s64(mullo64_neon(vaddq_s64(k2_47, vaddq_s64(a, b)), p1), 33);
+
+        int64x2_t p = vsubq_s64(vdupq_n_s64(1048576), vmovl_s32(vld1_s32(&adc_P[i])));
+        int64x2_t num = mullo64_neon(vsubq_s64(vshlq_n_s64(p, 31), pv2), k3125);
+
+        // vcvtq_s64_f64 truncates toward zero, like C division
+        float64x2_t qd = vdivq_f64(vcvtq_f64_s64(num), vcvtq_f64_s64(pv1));
+        uint64x2_t bad = vorrq_u64(vcleq_s64(pv1, zero),
+                                   vcgeq_f64(vabsq_f64(qd), vdupq_n_f64(QUOTIENT_LIMIT)));
+        if (vmaxvq_u32(vreinterpretq_u32_u64(bad)) != 0) {
+            compensate_scalar(calib, &adc_P[i], &adc_T[i], &pressure[i],
+                              temperature != NULL ? &temperature[i] : NULL, 2);
+            continue;
+        }
+        int64x2_t q = vcvtq_s64_f64(qd);
+        int64x2_t r = vsubq_s64(num, mullo64_neon(q, pv1));
+        uint64x2_t num_neg = vcltq_s64(num, zero);
+        uint64x2_t dec = vbicq_u64(vcltq_s64(r, zero), num_neg);
+        uint64x2_t inc = vbicq_u64(vcgeq_s64(r, pv1), num_neg);
+        inc = vorrq_u64(inc, vandq_u64(num_neg, vcgtq_s64(r, zero)));
+        dec = vorrq_u64(dec, vandq_u64(num_neg, vcleq_s64(r, vnegq_s64(pv1))));
+        q = vsubq_s64(q, vandq_s64(vreinterpretq_s64_u64(dec), one));
+        q = vaddq_s64(q, vandq_s64(vreinterpretq_s64_u64(inc), one));
+
+        int64x2_t qs = vshrq_n_s64(q, 13);
+        a = vshrq_n_s64(mullo64_neon(mullo64_neon(p9, qs), qs), 25);
+        b = vshrq_n_s64(mullo64_neon(p8, q), 19);
+        p = vaddq_s64(vshrq_n_s64(vaddq_s64(q, vaddq_s64(a, b)), 8), p7_4);
+
+        vst1_u32(&pressure[i], vmovn_u64(vreinterpretq_u64_s64(p)));
+    }
+    compensate_scalar(calib, &adc_P[i], &adc_T[i], &pressure[i],
+                      temperature != NULL ? &temperature[i] : NULL, n - i);
+}
+
+#endif // HAVE_NEON_KERNEL
+
+/* ============================================================================
+ * Dispatch
+ * ========================================================================== */
+
+bmp280_kernel_t bmp280_batch_best_kernel(void) {
+#if defined(HAVE_NEON_KERNEL)
+    return BMP280_KERNEL_NEON;
+#elif defined(HAVE_AVX2_KERNEL)
+    if (avx512_supported()) return BMP280_KERNEL_AVX512;
+    return avx2_supported() ? BMP280_KERNEL_AVX2 : BMP280_KERNEL_SCALAR;
+#else
+    return BMP280_KERNEL_SCALAR;
+#endif
+}
+
+const char *bmp280_batch_kernel_name(bmp280_kernel_t kernel) {
+    switch (kernel) {
+        case BMP280_KERNEL_AUTO:   return "auto";
+        case BMP280_KERNEL_SCALAR: return "scalar";
+        case BMP280_KERNEL_AVX2:   return "avx2";
+        case BMP280_KERNEL_AVX512: return "avx512";
+        case BMP280_KERNEL_NEON:   return "neon";
+    }
+    return "?";
+}
+
+int bmp280_batch_compensate_with(bmp280_kernel_t kernel, const bmp280_calib_t *calib,
+                                 const int32_t *adc_P, const int32_t *adc_T,
+                                 uint32_t *pressure_q24_8, int32_t *temperature_x100,
+                                 size_t n) {
+    if (kernel == BMP280_KERNEL_AUTO) {
+        kernel = bmp280_batch_best_kernel();
+    }
+    switch (kernel) {
+        case BMP280_KERNEL_SCALAR:
+            compensate_scalar(calib, adc_P, adc_T, pressure_q24_8, temperature_x100, n);
+            return 0;
+#ifdef HAVE_AVX2_KERNEL
+        case BMP280_KERNEL_AVX2:
+            if (!avx2_supported()) return -1;
+            compensate_avx2(calib, adc_P, adc_T, pressure_q24_8, temperature_x100, n);
+            return 0;
+        case BMP280_KERNEL_AVX512:
+            if (!avx512_supported()) return -1;
+            compensate_avx512(calib, adc_P, adc_T, pressure_q24_8, temperature_x100, n);
+            return 0;
+#endif
+#ifdef HAVE_NEON_KERNEL
+        case BMP280_KERNEL_NEON:
+            compensate_neon(calib, adc_P, adc_T, pressure_q24_8, temperature_x100, n);
+            return 0;
+#endif
+        default:
+            return -1;
+    }
+}
+
+void bmp280_batch_compensate(const bmp280_calib_t *calib,
+                             const int32_t *adc_P, const int32_t *adc_T,
+                             uint32_t *pressure_q24_8, int32_t *temperature_x100,
+                             size_t n) {
+    bmp280_batch_compensate_with(BMP280_KERNEL_AUTO, calib, adc_P, adc_T,
+                                 pressure_q24_8, temperature_x100, n);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file bmp280_batch.h
+ * @brief Batch BMP280 compensation for hosts (raw ADC captures)
+ *
+ * Compensates arrays of (adc_P, adc_T) pairs from raw ADC mode with the
+ * firmware's own integer formula (bmp280_compensate.h), bit-exact with the
+ * device. x86-64 picks AVX-512 (F/DQ/VL) or AVX2 at run time, whichever the
+ * CPU has, AArch64 always uses NEON; all fall back to the scalar formula for lanes
+ * outside the fast path (corrupt calibration, absurd inputs).
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef BMP280_BATCH_H
+#define BMP280_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bmp280_compensate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    BMP280_KERNEL_AUTO = 0,     // Best available
+    BMP280_KERNEL_SCALAR,
+    BMP280_KERNEL_AVX2,
+    BMP280_KERNEL_AVX512,
+    BMP280_KERNEL_NEON,
+} bmp280_kernel_t;
+
+/**
+ * @brief Compensate n samples
+ * @param calib Parsed calibration (bmp280_parse_calib on the CMD_CALIBRATION block)
+ * @param adc_P Raw 20-bit pressure codes
+ * @param adc_T Raw 20-bit temperature codes
+ * @param pressure_q24_8 Out: Pa x256 (0 = corrupt calibration)
+ * @param temperature_x100 Out: °C x100, may be NULL
+ * @param n Number of samples
+ */
+void bmp280_batch_compensate(const bmp280_calib_t *calib,
+                             const int32_t *adc_P, const int32_t *adc_T,
+                             uint32_t *pressure_q24_8, int32_t *temperature_x100,
+                             size_t n);
+
+/**
+ * @brief Same with an explicit kernel (benchmarks, cross-checks)
+ * @return 0 on success, -1 if the kernel is not available here
+ */
+int bmp280_batch_compensate_with(bmp280_kernel_t kernel, const bmp280_calib_t *calib,
+                                 const int32_t *adc_P, const int32_t *adc_T,
+                                 uint32_t *pressure_q24_8, int32_t *temperature_x100,
+                                 size_t n);
+
+/**
+ * @brief Kernel BMP280_KERNEL_AUTO resolves to on this machine
+ */
+bmp280_kernel_t bmp280_batch_best_kernel(void);
+
+const char *bmp280_batch_kernel_name(bmp280_kernel_t kernel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BMP280_BATCH_H
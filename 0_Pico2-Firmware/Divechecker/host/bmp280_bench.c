@@ -0,0 +1,178 @@
+/**
+ * @file bmp280_bench.c
+ * @brief Correctness and throughput harness for the batch compensation
+ *
+ *   - golden vectors (bmp280_golden.h) through every available kernel
+ *   - random full-range 20-bit inputs: every kernel against the scalar
+ *     firmware formula, sample by sample
+ *   - throughput on a realistic raw capture (slow temperature drift,
+ *     breathing-sized pressure swings), best of several runs
+ *
+ * Exits non-zero on any mismatch.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "bmp280_batch.h"
+#include "bmp280_golden.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RUNS            5
+#define RANDOM_SAMPLES  (1u << 20)
+
+static const bmp280_kernel_t kernels[] = {
+    BMP280_KERNEL_SCALAR, BMP280_KERNEL_AVX2, BMP280_KERNEL_AVX512, BMP280_KERNEL_NEON,
+};
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int check_golden(bmp280_kernel_t kernel) {
+    enum { N = sizeof(golden_vectors) / sizeof(golden_vectors[0]) };
+    int failures = 0;
+    // One call per calibration set, as a host would process a capture
+    for (size_t c = 0; c < sizeof(golden_calibs) / sizeof(golden_calibs[0]); c++) {
+        int32_t adc_P[N], adc_T[N], temp[N];
+        uint32_t press[N];
+        size_t n = 0;
+        for (size_t i = 0; i < N; i++) {
+            if (golden_vectors[i].calib != c) continue;
+            adc_P[n] = golden_vectors[i].adc_P;
+            adc_T[n] = golden_vectors[i].adc_T;
+            n++;
+        }
+        if (bmp280_batch_compensate_with(kernel, &golden_calibs[c], adc_P, adc_T,
+                                         press, temp, n) != 0) {
+            return -1;
+        }
+        n = 0;
+        for (size_t i = 0; i < N; i++) {
+            if (golden_vectors[i].calib != c) continue;
+            if (press[n] != golden_vectors[i].pressure_q24_8 ||
+                temp[n] != golden_vectors[i].temperature_x100) {
+                if (failures++ < 5) {
+                    printf("  golden %zu: got %u / %d, want %u / %d\n", i, press[n], temp[n],
+                           golden_vectors[i].pressure_q24_8, golden_vectors[i].temperature_x100);
+                }
+            }
+            n++;
+        }
+    }
+    return failures;
+}
+
+static int check_random(bmp280_kernel_t kernel, const bmp280_calib_t *calib,
+                        const int32_t *adc_P, const int32_t *adc_T, size_t n) {
+    uint32_t *p_ref = malloc(n * sizeof(uint32_t));
+    uint32_t *p_out = malloc(n * sizeof(uint32_t));
+    int32_t *t_ref = malloc(n * sizeof(int32_t));
+    int32_t *t_out = malloc(n * sizeof(int32_t));
+    int failures = 0;
+
+    bmp280_batch_compensate_with(BMP280_KERNEL_SCALAR, calib, adc_P, adc_T, p_ref, t_ref, n);
+    bmp280_batch_compensate_with(kernel, calib, adc_P, adc_T, p_out, t_out, n);
+    for (size_t i = 0; i < n; i++) {
+        if (p_out[i] != p_ref[i] || t_out[i] != t_ref[i]) {
+            if (failures++ < 5) {
+                printf("  sample %zu (P %d, T %d): got %u / %d, want %u / %d\n", i,
+                       adc_P[i], adc_T[i], p_out[i], t_out[i], p_ref[i], t_ref[i]);
+            }
+        }
+    }
+    free(p_ref);
+    free(p_out);
+    free(t_ref);
+    free(t_out);
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    size_t n = (argc > 1) ? strtoul(argv[1], NULL, 0) : (16u << 20);
+    if (n == 0) {
+        fprintf(stderr, "usage: %s [samples]\n", argv[0]);
+        return 2;
+    }
+
+    int32_t *adc_P = malloc(n * sizeof(int32_t));
+    int32_t *adc_T = malloc(n * sizeof(int32_t));
+    uint32_t *press = malloc(n * sizeof(uint32_t));
+    int32_t *temp = malloc(n * sizeof(int32_t));
+    if (!adc_P || !adc_T || !press || !temp) return 1;
+
+    printf("best kernel: %s\n", bmp280_batch_kernel_name(bmp280_batch_best_kernel()));
+
+    // Full-range random codes (exercises the scalar fallback lanes too)
+    srand(42);
+    size_t nr = (n < RANDOM_SAMPLES) ? n : RANDOM_SAMPLES;
+    for (size_t i = 0; i < nr; i++) {
+        adc_P[i] = ((rand() << 8) ^ rand()) & 0xFFFFF;
+        adc_T[i] = ((rand() << 8) ^ rand()) & 0xFFFFF;
+    }
+
+    int failures = 0;
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        int g = check_golden(kernels[k]);
+        if (g < 0) continue;  // Not available on this machine
+        int r = 0;
+        for (size_t c = 0; c < sizeof(golden_calibs) / sizeof(golden_calibs[0]); c++) {
+            r += check_random(kernels[k], &golden_calibs[c], adc_P, adc_T, nr);
+        }
+        printf("%-7s golden %s, random %s\n", bmp280_batch_kernel_name(kernels[k]),
+               g ? "MISMATCH" : "ok", r ? "MISMATCH" : "ok");
+        failures += g + r;
+    }
+
+    // Realistic capture: ~25 degC drifting, pressure swinging around 1 atm
+    int32_t t = 519888, p = 415148;
+    for (size_t i = 0; i < n; i++) {
+        t += (rand() % 5) - 2;
+        p += (rand() % 201) - 100;
+        if (p < 250000) p = 250000;
+        if (p > 650000) p = 650000;
+        adc_P[i] = p;
+        adc_T[i] = t;
+    }
+
+    printf("\n%zu samples, best of %d:\n", n, RUNS);
+    printf("%-7s %12s %10s\n", "kernel", "Msamples/s", "ns/sample");
+    double scalar_rate = 0;
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        double best = 1e30;
+        int ok = 1;
+        for (int run = 0; run < RUNS && ok; run++) {
+            double t0 = now_s();
+            ok = bmp280_batch_compensate_with(kernels[k], &golden_calibs[0], adc_P, adc_T,
+                                              press, temp, n) == 0;
+            double dt = now_s() - t0;
+            if (dt < best) best = dt;
+        }
+        if (!ok) continue;
+        if (kernels[k] != BMP280_KERNEL_SCALAR &&
+            check_random(kernels[k], &golden_calibs[0], adc_P, adc_T, n) != 0) {
+            printf("%-7s capture MISMATCH\n", bmp280_batch_kernel_name(kernels[k]));
+            failures++;
+        }
+        double rate = n / best / 1e6;
+        if (kernels[k] == BMP280_KERNEL_SCALAR) scalar_rate = rate;
+        printf("%-7s %12.1f %10.2f", bmp280_batch_kernel_name(kernels[k]), rate,
+               best * 1e9 / n);
+        if (kernels[k] != BMP280_KERNEL_SCALAR && scalar_rate > 0) {
+            printf("   (%.1fx scalar)", rate / scalar_rate);
+        }
+        printf("\n");
+    }
+
+    free(adc_P);
+    free(adc_T);
+    free(press);
+    free(temp);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file bmp280_golden.h
+ * @brief Golden vectors for the BMP280 compensation (generated)
+ *
+ * Produced by bmp280_golden_gen from bmp280_compensate.h; do not edit.
+ * Vector 0 is the datasheet example (25.08 degC, ~100653 Pa).
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef BMP280_GOLDEN_H
+#define BMP280_GOLDEN_H
+
+#include "bmp280_compensate.h"
+
+static const bmp280_calib_t golden_calibs[] = {
+    { 27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000 },
+    { 28190, 26478, 50, 37829, -10551, 3024, 5389, -50, -7, 9900, -10230, 4285 },
+    { 27296, 26773, 50, 36669, -10667, 3024, 7104, -241, -7, 15500, -14600, 6000 },
+};
+
+static const struct {
+    uint8_t calib;
+    int32_t adc_P, adc_T;
+    uint32_t pressure_q24_8;
+    int32_t temperature_x100;
+} golden_vectors[] = {
+    { 0, 415148, 519888, 25767233, 2508 },
+    { 0, 1048575, 0, 4294055124, -14088 },
+    { 0, 0, 1048575, 55536661, 18755 },
+    { 0, 1048575, 1048575, 4292524766, 18755 },
+    { 0, 411731, 436206, 24883529, -122 },
+    { 0, 347238, 551375, 29212482, 3493 },
+    { 0, 621237, 451766, 16192615, 368 },
+    { 0, 689227, 382271, 12908813, -1825 },
+    { 0, 275882, 461774, 31046315, 683 },
+    { 0, 688294, 616617, 14398878, 5528 },
+    { 0, 350342, 484859, 28152909, 1409 },
+    { 0, 618569, 564529, 17179796, 3905 },
+    { 0, 373886, 420416, 26279087, -620 },
+    { 0, 657290, 552860, 15372013, 3540 },
+    { 0, 626309, 541569, 16659361, 3187 },
+    { 0, 638108, 441805, 15409668, 55 },
+    { 0, 537615, 549378, 20657892, 3431 },
+    { 0, 381299, 577416, 28020988, 4307 },
+    { 0, 612272, 597576, 17723437, 4935 },
+    { 0, 508739, 596593, 22429500, 4905 },
+    { 0, 432445, 666134, 26756310, 7066 },
+    { 0, 291393, 563788, 31923970, 3881 },
+    { 0, 221801, 504336, 34099286, 2021 },
+    { 0, 657440, 467390, 14775706, 860 },
+    { 0, 690120, 657082, 14566879, 6785 },
+    { 0, 297396, 420842, 29507732, -606 },
+    { 0, 316238, 468537, 29402566, 896 },
+    { 0, 442450, 581268, 25283146, 4427 },
+    { 0, 613616, 442672, 16442906, 82 },
+    { 0, 640972, 540801, 16007143, 3163 },
+    { 0, 479104, 426947, 21939329, -414 },
+    { 0, 492984, 488180, 22000458, 1513 },
+    { 0, 627413, 649334, 17429725, 6545 },
+    { 0, 447274, 466705, 23732790, 839 },
+    { 0, 362496, 659726, 29997745, 6867 },
+    { 0, 405748, 481820, 25705368, 1314 },
+    { 0, 250390, 448974, 31943924, 280 },
+    { 0, 286572, 560346, 32090726, 3774 },
+    { 0, 338380, 471290, 28483666, 983 },
+    { 0, 570405, 457677, 18389679, 554 },
+    { 0, 309077, 441974, 29323056, 60 },
+    { 0, 597747, 552955, 18014507, 3543 },
+    { 0, 444678, 623559, 25677403, 5744 },
+    { 0, 520202, 636104, 22301501, 6134 },
+    { 0, 450737, 402704, 22854381, -1179 },
+    { 0, 240735, 424214, 31958567, -500 },
+    { 0, 462828, 468405, 23084776, 892 },
+    { 0, 352069, 485867, 28091528, 1441 },
+    { 0, 342378, 428026, 27709931, -380 },
+    { 0, 569072, 450090, 18379470, 316 },
+    { 0, 409120, 514756, 25969539, 2347 },
+    { 0, 508565, 462103, 21061075, 694 },
+    { 0, 283520, 457174, 30646142, 539 },
+    { 0, 636454, 487863, 15816132, 1503 },
+    { 0, 261312, 621492, 34214725, 5680 },
+    { 0, 520441, 395372, 19898421, -1411 },
+    { 0, 499827, 494626, 21771458, 1716 },
+    { 0, 423394, 389468, 23830956, -1597 },
+    { 0, 272429, 530053, 32259624, 2826 },
+    { 0, 437651, 626763, 26042137, 5844 },
+    { 0, 632771, 449920, 15693143, 310 },
+    { 0, 415618, 483675, 25300441, 1372 },
+    { 0, 628712, 454487, 15898023, 454 },
+    { 0, 226018, 439666, 32838421, -13 },
+    { 1, 0, 0, 30742553, -14225 },
+    { 1, 1048575, 0, 4292422778, -14225 },
+    { 1, 0, 1048575, 51471658, 18881 },
+    { 1, 1048575, 1048575, 4290924474, 18881 },
+    { 1, 519024, 380462, 17319014, -2228 },
+    { 1, 207623, 509363, 31615336, 1841 },
+    { 1, 466895, 433994, 19908690, -538 },
+    { 1, 684005, 460386, 11353907, 295 },
+    { 1, 274746, 651278, 30889430, 6322 },
+    { 1, 457969, 649284, 22596705, 6260 },
+    { 1, 245764, 528990, 30303786, 2461 },
+    { 1, 270718, 559228, 29689539, 3415 },
+    { 1, 288577, 561055, 28942911, 3473 },
+    { 1, 419104, 506062, 22663353, 1737 },
+    { 1, 580837, 607507, 16744452, 4940 },
+    { 1, 231212, 630526, 32533552, 5667 },
+    { 1, 232197, 390176, 28739026, -1921 },
+    { 1, 215124, 664752, 33814751, 6748 },
+    { 1, 656115, 447273, 12399307, -119 },
+    { 1, 241902, 613673, 31788957, 5135 },
+    { 1, 539077, 437843, 17038937, -417 },
+    { 1, 580141, 579916, 16545772, 4069 },
+    { 1, 381231, 396480, 22911544, -1722 },
+    { 1, 581126, 533597, 16122107, 2606 },
+    { 1, 237507, 393846, 28583247, -1805 },
+    { 1, 676236, 666977, 12951034, 6818 },
+    { 1, 397815, 432504, 22677847, -585 },
+    { 1, 200819, 632859, 33939330, 5741 },
+    { 1, 692318, 677899, 12295192, 7163 },
+    { 1, 317583, 486447, 26655983, 1117 },
+    { 1, 667981, 637553, 13130393, 5889 },
+    { 1, 496756, 509281, 19447083, 1838 },
+    { 1, 200886, 654128, 34289593, 6413 },
+    { 1, 442519, 555222, 22230625, 3289 },
+    { 1, 412015, 414027, 21892625, -1168 },
+    { 1, 311563, 654064, 29261787, 6411 },
+    { 1, 220619, 408071, 29475204, -1356 },
+    { 1, 268996, 527957, 29297066, 2428 },
+    { 1, 682622, 597830, 12238255, 4634 },
+    { 1, 299575, 500489, 27604655, 1561 },
+    { 1, 396285, 503886, 23593589, 1668 },
+    { 1, 584054, 405518, 14975608, -1437 },
+    { 1, 565595, 407586, 15722175, -1372 },
+    { 1, 252311, 536394, 30137448, 2694 },
+    { 1, 441612, 526855, 21952191, 2393 },
+    { 1, 385037, 513504, 24183497, 1972 },
+    { 1, 685380, 409535, 11003334, -1310 },
+    { 1, 280749, 581684, 29586239, 4124 },
+    { 1, 538456, 383312, 16584606, -2138 },
+    { 1, 268746, 630635, 30849510, 5670 },
+    { 1, 337083, 641117, 27929761, 6002 },
+    { 1, 349336, 466311, 25072699, 482 },
+    { 1, 540865, 435243, 16944048, -499 },
+    { 1, 612843, 518862, 14673800, 2141 },
+    { 1, 309438, 386941, 25631537, -2023 },
+    { 1, 221239, 404932, 29401847, -1455 },
+    { 1, 691655, 556854, 11604203, 3340 },
+    { 1, 673553, 640043, 12899649, 5968 },
+    { 1, 616494, 571677, 14914864, 3808 },
+    { 1, 260396, 449257, 28487038, -56 },
+    { 1, 480586, 380243, 18820437, -2234 },
+    { 1, 698396, 446497, 10694070, -143 },
+    { 1, 415212, 529374, 23099207, 2473 },
+    { 1, 357461, 582647, 26245602, 4155 },
+    { 2, 0, 0, 30593823, -13928 },
+    { 2, 1048575, 0, 4291252147, -13928 },
+    { 2, 0, 1048575, 52944424, 19548 },
+    { 2, 1048575, 1048575, 4289974717, 19548 },
+    { 2, 569481, 452928, 15364157, 517 },
+    { 2, 395724, 431536, 22421712, -166 },
+    { 2, 391254, 488448, 23344564, 1651 },
+    { 2, 554324, 492399, 16367241, 1776 },
+    { 2, 522246, 562943, 18463430, 4029 },
+    { 2, 538273, 417176, 16335153, -624 },
+    { 2, 276270, 438147, 27547416, 45 },
+    { 2, 678600, 515919, 11211374, 2527 },
+    { 2, 220800, 430223, 29767832, -208 },
+    { 2, 581755, 565112, 15834813, 4098 },
+    { 2, 491602, 415751, 18248115, -670 },
+    { 2, 508336, 487384, 18290619, 1617 },
+    { 2, 466935, 387087, 18954084, -1585 },
+    { 2, 645307, 675506, 13856706, 7624 },
+    { 2, 601955, 642348, 15599671, 6565 },
+    { 2, 560622, 494986, 16121016, 1859 },
+    { 2, 552363, 562977, 17122442, 4030 },
+    { 2, 338623, 663461, 28169436, 7239 },
+    { 2, 553730, 398322, 15526751, -1226 },
+    { 2, 296481, 601958, 29205250, 5275 },
+    { 2, 623548, 593731, 14208752, 5012 },
+    { 2, 559816, 549905, 16667707, 3613 },
+    { 2, 391661, 601849, 24827792, 5271 },
+    { 2, 563592, 518698, 16211468, 2616 },
+    { 2, 460298, 466775, 20118805, 959 },
+    { 2, 699446, 563061, 10607420, 4033 },
+    { 2, 319622, 535969, 27149712, 3168 },
+    { 2, 286949, 494359, 27957595, 1839 },
+    { 2, 271925, 478171, 28357771, 1322 },
+    { 2, 424137, 666995, 24169379, 7352 },
+    { 2, 343531, 424234, 24511309, -399 },
+    { 2, 397335, 594989, 24476682, 5052 },
+    { 2, 238813, 647121, 32639234, 6717 },
+    { 2, 643585, 428586, 12085032, -260 },
+    { 2, 322973, 577716, 27621580, 4500 },
+    { 2, 507741, 532781, 18791168, 3066 },
+    { 2, 239906, 461303, 29467420, 784 },
+    { 2, 448287, 411578, 19992977, -803 },
+    { 2, 208733, 645023, 34027272, 6650 },
+    { 2, 441529, 646421, 23093557, 6695 },
+    { 2, 380035, 479663, 23712829, 1370 },
+    { 2, 285089, 658435, 30632557, 7078 },
+    { 2, 634601, 624811, 13955628, 6004 },
+    { 2, 335114, 527494, 26337582, 2897 },
+    { 2, 480386, 438199, 18953699, 46 },
+    { 2, 543976, 463812, 16538571, 864 },
+    { 2, 645731, 667384, 13774207, 7364 },
+    { 2, 434159, 438497, 20894972, 56 },
+    { 2, 482718, 595473, 20593523, 5068 },
+    { 2, 224436, 407999, 29246642, -917 },
+    { 2, 271145, 493222, 28629301, 1803 },
+    { 2, 290890, 650308, 30228138, 6819 },
+    { 2, 480023, 481115, 19437222, 1416 },
+    { 2, 508005, 581971, 19301179, 4636 },
+    { 2, 574557, 596789, 16444744, 5110 },
+    { 2, 214394, 502928, 31276509, 2113 },
+    { 2, 606509, 492919, 14136419, 1793 },
+    { 2, 350907, 563552, 26150484, 4048 },
+    { 2, 603773, 648293, 15567004, 6754 },
+    { 2, 230910, 626181, 32651904, 6048 },
+};
+
+#endif // BMP280_GOLDEN_H
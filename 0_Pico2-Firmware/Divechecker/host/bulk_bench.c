@@ -0,0 +1,359 @@
+/**
+ * @file bulk_bench.c
+ * @brief Host-side throughput benchmark for the SysEx bulk transfer
+ *
+ * Runs the firmware's bulk_transfer.c unchanged as a device stand-in and
+ * connects it to a host receiver through a simulated USB-MIDI link on a
+ * virtual clock:
+ *   - device TX FIFO of CFG_TUD_MIDI_TX_BUFSIZE bytes (USB-MIDI events,
+ *     4 bytes per 3 SysEx bytes), send fails when full
+ *   - the FIFO drains in 1ms USB frames of N 64-byte packets
+ *   - fixed one-way latency in both directions, optional chunk loss
+ *   - the device main loop calls bulk_task() once per loop period
+ *
+ * The host side decodes, CRC-checks and acknowledges exactly as an app
+ * would, and the received object is compared with the source. Reports
+ * payload KB/s and retransmits; exits non-zero on any data mismatch.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "bulk_transfer.h"
+#include "crc32.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CMD_BULK_INFO       0x0E
+#define CMD_BULK_DATA       0x0F
+#define SYSEX_OVERHEAD      5       // F0 7D 01 cmd ... F7
+#define TX_FIFO_BYTES       512     // CFG_TUD_MIDI_TX_BUFSIZE
+#define USB_PACKET_BYTES    64
+#define TICK_US             10
+#define MAX_MSGS            4096
+
+typedef struct {
+    int packets_per_frame;  // 64-byte packets the host pulls per 1ms frame
+    int latency_ms;         // One-way latency after the USB transfer
+    double loss;            // Probability a chunk arrives corrupted
+    int loop_us;            // Device main loop period
+    int ack_every;          // Host ACK cadence in chunks
+    uint32_t size;          // Object size in bytes
+} link_cfg_t;
+
+typedef struct {
+    uint8_t cmd;
+    uint16_t len;
+    uint16_t wire_left;     // Event bytes still to cross the bus
+    uint64_t arrive_us;     // Host delivery time once on the wire
+    uint8_t data[256];
+} msg_t;
+
+// Device -> host queue (FIFO + in-flight)
+static msg_t g_msgs[MAX_MSGS];
+static int g_head = 0, g_tail = 0;
+static uint32_t g_fifo_bytes = 0;
+
+// Host -> device ACKs in flight
+typedef struct { uint64_t arrive_us; uint32_t seq; bool retx; } ack_t;
+static ack_t g_acks[MAX_MSGS];
+static int g_ack_head = 0, g_ack_tail = 0;
+
+static link_cfg_t g_cfg;
+static uint64_t g_now_us = 0;
+static uint8_t *g_src = NULL;
+static uint8_t *g_dst = NULL;
+
+static uint32_t wire_bytes(uint16_t len) {
+    return (uint32_t)((len + SYSEX_OVERHEAD + 2) / 3) * 4;
+}
+
+// ---------------------------------------------------------------- device I/O
+
+static uint32_t dev_size(uint8_t object) {
+    (void)object;
+    return g_cfg.size;
+}
+
+static uint32_t dev_read(uint8_t object, uint32_t offset, uint8_t *dst, uint32_t len) {
+    (void)object;
+    if (offset >= g_cfg.size) return 0;
+    if (len > g_cfg.size - offset) len = g_cfg.size - offset;
+    memcpy(dst, &g_src[offset], len);
+    return len;
+}
+
+static bool dev_send(uint8_t command, const uint8_t *data, uint16_t len) {
+    uint32_t wire = wire_bytes(len);
+    if (g_fifo_bytes + wire > TX_FIFO_BYTES) return false;
+    if ((g_tail + 1) % MAX_MSGS == g_head) return false;
+    msg_t *m = &g_msgs[g_tail];
+    m->cmd = command;
+    m->len = len;
+    m->wire_left = (uint16_t)wire;
+    m->arrive_us = 0;
+    memcpy(m->data, data, len);
+    g_tail = (g_tail + 1) % MAX_MSGS;
+    g_fifo_bytes += wire;
+    return true;
+}
+
+static uint32_t dev_now_ms(void) {
+    return (uint32_t)(g_now_us / 1000);
+}
+
+static const bulk_io_t g_io = {
+    .size = dev_size,
+    .read = dev_read,
+    .send = dev_send,
+    .now_ms = dev_now_ms,
+    .available = NULL,
+    .cmd_info = CMD_BULK_INFO,
+    .cmd_data = CMD_BULK_DATA,
+};
+
+// ---------------------------------------------------------------- host side
+
+typedef struct {
+    uint32_t expected;      // Next seq wanted
+    uint32_t num_chunks;
+    uint32_t offset;
+    uint16_t chunk;
+    uint32_t ack_every;     // Never more than half the window
+    uint32_t since_ack;
+    uint32_t retx_requested_at;  // expected value of the last retransmit request, +1
+    uint64_t last_rx_us;
+    uint32_t crc_errors;
+    bool info_ok;
+} host_t;
+
+static void host_send_ack(uint32_t seq, bool retx) {
+    ack_t *a = &g_acks[g_ack_tail];
+    a->arrive_us = g_now_us + (uint64_t)g_cfg.latency_ms * 1000 + 1000;  // + OUT frame
+    a->seq = seq;
+    a->retx = retx;
+    g_ack_tail = (g_ack_tail + 1) % MAX_MSGS;
+}
+
+static uint32_t get_u32_7bit(const uint8_t *p) {
+    return ((uint32_t)p[0] << 28) | ((uint32_t)p[1] << 21) | ((uint32_t)p[2] << 14) |
+           ((uint32_t)p[3] << 7) | p[4];
+}
+
+static void host_receive(host_t *h, msg_t *m) {
+    h->last_rx_us = g_now_us;
+    if (m->cmd == CMD_BULK_INFO) {
+        uint32_t total = get_u32_7bit(&m->data[2]);
+        h->info_ok = (m->data[1] == BULK_STATUS_OK);
+        h->offset = get_u32_7bit(&m->data[7]);
+        h->chunk = (uint16_t)((m->data[12] << 7) | m->data[13]);
+        h->ack_every = (uint32_t)g_cfg.ack_every;
+        if (h->ack_every > (uint32_t)(m->data[14] + 1) / 2) h->ack_every = (uint32_t)(m->data[14] + 1) / 2;
+        h->num_chunks = (total - h->offset + h->chunk - 1) / h->chunk;
+        h->expected = 0;
+        return;
+    }
+
+    uint32_t seq = ((uint32_t)m->data[0] << 14) | ((uint32_t)m->data[1] << 7) | m->data[2];
+    uint32_t crc = get_u32_7bit(&m->data[3]);
+    uint8_t raw[BULK_CHUNK_MAX];
+    uint16_t n = bulk_unpack_7to8(&m->data[BULK_DATA_HEADER], m->len - BULK_DATA_HEADER, raw);
+    bool corrupt = ((double)rand() / RAND_MAX) < g_cfg.loss;
+    if (corrupt) raw[0] ^= 0x01;
+
+    if (seq != h->expected || crc32_compute(raw, n) != crc) {
+        if (crc32_compute(raw, n) != crc) h->crc_errors++;
+        if (seq >= h->expected && h->retx_requested_at != h->expected + 1) {
+            h->retx_requested_at = h->expected + 1;
+            host_send_ack(h->expected, true);
+        }
+        return;
+    }
+    memcpy(&g_dst[h->offset + seq * h->chunk], raw, n);
+    h->expected++;
+    h->since_ack++;
+    if (h->since_ack >= h->ack_every || h->expected == h->num_chunks) {
+        h->since_ack = 0;
+        host_send_ack(h->expected, false);
+    }
+}
+
+// ---------------------------------------------------------------- simulation
+
+typedef struct {
+    double seconds;
+    bulk_stats_t stats;
+    uint32_t crc_errors;
+    bool ok;
+} result_t;
+
+/// Drain the USB link for one tick, deliver arrived messages and ACKs
+static void link_step(host_t *h, uint32_t *frame_budget) {
+    if (g_now_us % 1000 == 0) {
+        *frame_budget = (uint32_t)g_cfg.packets_per_frame * USB_PACKET_BYTES;
+    }
+    for (int i = g_head; i != g_tail && *frame_budget > 0; i = (i + 1) % MAX_MSGS) {
+        msg_t *m = &g_msgs[i];
+        if (m->wire_left == 0) continue;
+        uint32_t n = (m->wire_left < *frame_budget) ? m->wire_left : *frame_budget;
+        m->wire_left -= (uint16_t)n;
+        *frame_budget -= n;
+        g_fifo_bytes -= n;
+        if (m->wire_left == 0) {
+            m->arrive_us = g_now_us + (uint64_t)g_cfg.latency_ms * 1000;
+        }
+    }
+    while (g_head != g_tail && g_msgs[g_head].wire_left == 0 &&
+           g_msgs[g_head].arrive_us <= g_now_us) {
+        host_receive(h, &g_msgs[g_head]);
+        g_head = (g_head + 1) % MAX_MSGS;
+    }
+    while (g_ack_head != g_ack_tail && g_acks[g_ack_head].arrive_us <= g_now_us) {
+        bulk_ack(g_acks[g_ack_head].seq, g_acks[g_ack_head].retx);
+        g_ack_head = (g_ack_head + 1) % MAX_MSGS;
+    }
+}
+
+static result_t run(uint16_t chunk, uint8_t window, uint32_t resume_at) {
+    result_t r = {0};
+    host_t h = {0};
+    uint32_t frame_budget = 0;
+    g_head = g_tail = g_ack_head = g_ack_tail = 0;
+    g_fifo_bytes = 0;
+    g_now_us = 0;
+    memset(g_dst, 0, g_cfg.size);
+    srand(1234);
+
+    bulk_init(&g_io);
+    uint32_t offset = 0;
+    // Optional interruption: abort after resume_at bytes, restart there
+    for (int pass = 0; pass < 2; pass++) {
+        if (bulk_start(0, offset, chunk, window) != BULK_STATUS_OK) return r;
+        uint64_t next_loop_us = g_now_us;
+        while (g_now_us < 600ull * 1000 * 1000) {
+            link_step(&h, &frame_budget);
+            if (g_now_us >= next_loop_us) {
+                bulk_task();
+                next_loop_us = g_now_us + (uint64_t)g_cfg.loop_us;
+            }
+            // Host watchdog: re-request if the stream stalls
+            if (h.info_ok && h.expected < h.num_chunks && g_now_us - h.last_rx_us > 100000) {
+                h.last_rx_us = g_now_us;
+                host_send_ack(h.expected, true);
+            }
+            g_now_us += TICK_US;
+            bool done = h.info_ok && h.expected == h.num_chunks && !bulk_active() &&
+                        g_head == g_tail;
+            if (done) break;
+            if (pass == 0 && resume_at > 0 && h.info_ok &&
+                (uint64_t)h.expected * h.chunk >= resume_at) {
+                bulk_abort();
+                break;
+            }
+        }
+        if (pass == 0 && resume_at > 0) {
+            // Resume from the last byte known good on the host
+            offset = h.offset + h.expected * h.chunk;
+            while (g_head != g_tail) link_step(&h, &frame_budget), g_now_us += TICK_US;
+            continue;
+        }
+        break;
+    }
+
+    r.seconds = (double)g_now_us / 1e6;
+    bulk_get_stats(&r.stats);
+    r.crc_errors = h.crc_errors;
+    r.ok = memcmp(g_src, g_dst, g_cfg.size) == 0;
+    return r;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s [--size N] [--chunk N] [--window N] [--packets N]\n"
+            "          [--latency-ms N] [--loss P] [--loop-us N] [--ack-every N]\n"
+            "Without --chunk/--window a sweep over both is printed.\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    g_cfg.packets_per_frame = 4;
+    g_cfg.latency_ms = 2;
+    g_cfg.loss = 0.0;
+    g_cfg.loop_us = 110;
+    g_cfg.ack_every = 4;
+    g_cfg.size = 512 * 1024;
+    int chunk = 0, window = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *v = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (v == NULL) { usage(argv[0]); return 2; }
+        if (!strcmp(a, "--size")) g_cfg.size = (uint32_t)strtoul(v, NULL, 0);
+        else if (!strcmp(a, "--chunk")) chunk = atoi(v);
+        else if (!strcmp(a, "--window")) window = atoi(v);
+        else if (!strcmp(a, "--packets")) g_cfg.packets_per_frame = atoi(v);
+        else if (!strcmp(a, "--latency-ms")) g_cfg.latency_ms = atoi(v);
+        else if (!strcmp(a, "--loss")) g_cfg.loss = atof(v);
+        else if (!strcmp(a, "--loop-us")) g_cfg.loop_us = atoi(v);
+        else if (!strcmp(a, "--ack-every")) g_cfg.ack_every = atoi(v);
+        else { usage(argv[0]); return 2; }
+        i++;
+    }
+
+    g_src = malloc(g_cfg.size);
+    g_dst = malloc(g_cfg.size);
+    if (!g_src || !g_dst) return 1;
+    srand(42);
+    for (uint32_t i = 0; i < g_cfg.size; i++) g_src[i] = (uint8_t)rand();
+
+    static const uint16_t chunks[] = {49, 98, 147, 196, 210};
+    static const uint8_t windows[] = {1, 2, 4, 8, 16, 32};
+    uint16_t c_list[8];
+    uint8_t w_list[8];
+    int nc = 0, nw = 0;
+    if (chunk) c_list[nc++] = (uint16_t)chunk;
+    else for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++) c_list[nc++] = chunks[i];
+    if (window) w_list[nw++] = (uint8_t)window;
+    else for (size_t i = 0; i < sizeof(windows); i++) w_list[nw++] = windows[i];
+
+    double link_kbs = g_cfg.packets_per_frame * USB_PACKET_BYTES * 1000.0 / 1024.0;
+    printf("link: %d x 64B packets/ms (%.0f KB/s raw), latency %d ms, loss %.3f, %u bytes\n",
+           g_cfg.packets_per_frame, link_kbs, g_cfg.latency_ms, g_cfg.loss, g_cfg.size);
+    printf("%6s %6s %10s %8s %8s %8s %s\n",
+           "chunk", "window", "KB/s", "eff%", "retx", "crcerr", "result");
+
+    int failures = 0;
+    for (int ci = 0; ci < nc; ci++) {
+        for (int wi = 0; wi < nw; wi++) {
+            result_t r = run(c_list[ci], w_list[wi], 0);
+            double kbs = (r.seconds > 0) ? g_cfg.size / 1024.0 / r.seconds : 0;
+            printf("%6u %6u %10.1f %8.1f %8u %8u %s\n", c_list[ci], w_list[wi], kbs,
+                   100.0 * kbs / link_kbs, r.stats.retransmits, r.crc_errors,
+                   r.ok ? "ok" : "MISMATCH");
+            if (!r.ok) failures++;
+        }
+    }
+
+    // Resume check: interrupt halfway, restart at the host's offset
+    result_t r = run(c_list[nc - 1], w_list[nw - 1], g_cfg.size / 2);
+    printf("resume at %u: %s\n", g_cfg.size / 2, r.ok ? "ok" : "MISMATCH");
+    if (!r.ok) failures++;
+
+    // Per-chunk device work (CRC + packing) on this CPU, for reference
+    uint8_t packed[BULK_PACKED_SIZE(BULK_CHUNK_MAX)];
+    volatile uint32_t sink = 0;
+    clock_t c0 = clock();
+    for (uint32_t off = 0; off + BULK_CHUNK_MAX <= g_cfg.size; off += BULK_CHUNK_MAX) {
+        sink += crc32_compute(&g_src[off], BULK_CHUNK_MAX);
+        sink += bulk_pack_8to7(&g_src[off], BULK_CHUNK_MAX, packed);
+    }
+    double cpu_s = (double)(clock() - c0) / CLOCKS_PER_SEC;
+    printf("device-side crc+pack: %.1f MB/s (host CPU)\n",
+           cpu_s > 0 ? g_cfg.size / 1e6 / cpu_s : 0.0);
+
+    free(g_src);
+    free(g_dst);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,515 @@
+/**
+ * @file divechecker_sim.c
+ * @brief Runs the whole firmware on the host against simulated hardware
+ *
+ * Divechecker.c and every module it links are compiled unchanged against
+ * the SDK stand-ins in sim/ (virtual clock, BMP280 register model, fake
+ * flash, USB-MIDI host). The bench boots the firmware once and walks it
+ * through a fixed scenario as an app would, checking the SysEx stream:
+ *
+ *   boot          first pressure frame within 300 ms, no watchdog; device
+ *                 info sensor status and the diagnostics boot phases
+ *   ping          PONG round trip
+ *   rate          frame count at the default output rate
+ *   baseline      frames centred on zero at constant pressure
+ *   step          +25 hPa step: settling time and level
+ *   set rate      CONFIG reply and the new frame rate
+ *   over-range    OVERRANGE_ALERT, then frames back near zero; the
+ *                 diagnostics recovery time under 100 ms
+ *   get config    FULL_CONFIG reflects the new rate
+ *   stats         PRESSURE_STATS frames: one per output period, the value
+ *                 inside [min, max], a plausible spread, and the window
+ *                 holding a +5 hPa edge spans it; then plain frames again
+ *   governor      clk_sys per profile: idle before the app connects,
+ *                 streaming at 20 Hz, full at the top rate, back after a signing
+ *                 request; time-in-state covers the run and the flash
+ *                 profile is entered for sector erases only
+ *   suspend       3 s of bus suspend with a +10 hPa change meanwhile:
+ *                 clk_sys lowered and keep-warm conversions only, then
+ *                 the new level within one output period of resume; the
+ *                 diagnostics power block
+ *   recorder dl   a recorder download in progress is aborted when a
+ *                 session starts, by command or by the pressure trigger
+ *
+ * Everything runs on simulated time, so results are identical on every
+ * machine; the wall-clock speed is reported for reference. Exits non-zero
+ * on any failed check.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim.h"
+#include "sim_app.h"
+#include "midi_sysex.h"
+#include "recorder.h"
+#include "bulk_transfer.h"
+#include "divechecker_config.h"
+#include "hardware/clocks.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SENSOR_ADDR         0x76
+#define AMBIENT_HPA         1013.25f
+#define BOOT_BUDGET_US      300000  // Reset to first pressure frame
+#define SUSPEND_US          3000000
+#define SLOW_SYS_HZ         50000000    // Governor: idle, flash, suspend
+#define STREAMING_SYS_HZ    75000000
+#define FULL_SYS_HZ         150000000
+#define KEEP_WARM_US        250000      // KEEP_WARM_INTERVAL_US
+#define STREAMING_RATE_HZ   20          // FAST_OUTPUT_HZ: fastest on the streaming clock
+#define STATS_SAMPLES       (INTERNAL_SAMPLE_RATE_HZ / STREAMING_RATE_HZ)  // Per frame
+
+// Rates come from the build profile (divechecker_config.h), so every
+// profile runs the same scenario
+_Static_assert(MIN_OUTPUT_RATE_HZ <= STREAMING_RATE_HZ && STREAMING_RATE_HZ < MAX_OUTPUT_RATE_HZ,
+               "profile must offer the streaming rate and a faster one");
+#define RECOVERY_BUDGET_MS  100         // Over-range: last bad reading -> frame
+
+#define FLASH_SAVE_US       3500000     // FLASH_SAVE_DEBOUNCE_MS and the write
+#define BULK_CHUNK          64
+#define BULK_QUIET_US       (4 * BULK_RETX_TIMEOUT_MS * 1000)  // Retransmits would show
+#define TRIGGER_X1000       5000        // Recorder trigger, +10 hPa crosses it
+
+int divechecker_main(void);         // Firmware main(), renamed at compile time
+
+static const char *const k_profile_names[POWER_PROFILE_COUNT] = {
+    "idle", "streaming", "full", "crypto", "flash", "suspend",
+};
+
+static int g_failures = 0;
+
+static void check(bool ok, const char *what) {
+    printf("  %-44s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) g_failures++;
+}
+
+static double frames_mean(int first) {
+    const sim_frame_t *f = sim_app_frames();
+    int n = sim_app_frame_count();
+    double sum = 0;
+    for (int i = first; i < n; i++) sum += f[i].value_x1000;
+    return (n > first) ? sum / (n - first) : NAN;
+}
+
+static double frames_rms(int first, double mean) {
+    const sim_frame_t *f = sim_app_frames();
+    int n = sim_app_frame_count();
+    double sum = 0;
+    for (int i = first; i < n; i++) {
+        double d = f[i].value_x1000 - mean;
+        sum += d * d;
+    }
+    return (n > first) ? sqrt(sum / (n - first)) : NAN;
+}
+
+static int frames_tail(int n) {
+    return sim_app_frame_count() > n ? sim_app_frame_count() - n : 0;
+}
+
+static bool last_msg_byte_is(uint8_t cmd, size_t index, uint8_t value) {
+    size_t len;
+    const uint8_t *msg = sim_app_last_msg(cmd, &len);
+    return index < len && msg[index] == value;
+}
+
+/**
+ * @brief Boot phases from the last CMD_DIAGNOSTICS (after the health block)
+ * @return false if the message is missing or short
+ */
+static bool diag_boot_times(uint32_t out[4]) {
+    size_t len;
+    const uint8_t *msg = sim_app_last_msg(CMD_DIAGNOSTICS, &len);
+    if (len < 4 + 15) return false;
+    size_t idx = 4 + 15 + (size_t)msg[4 + 14] * 6;
+    if (len < idx + 4 * 3 + 1) return false;
+    for (int i = 0; i < 4; i++, idx += 3) {
+        out[i] = ((uint32_t)msg[idx] << 14) | ((uint32_t)msg[idx + 1] << 7) | msg[idx + 2];
+    }
+    return true;
+}
+
+/**
+ * @brief Power block from the last CMD_DIAGNOSTICS (after the boot phases)
+ * @return false if the message is missing or short
+ */
+static bool diag_power(power_stats_t *out) {
+    size_t len;
+    const uint8_t *msg = sim_app_last_msg(CMD_DIAGNOSTICS, &len);
+    if (len < 4 + 15) return false;
+    size_t idx = 4 + 15 + (size_t)msg[4 + 14] * 6 + 4 * 3;
+    if (len < idx + 9 + 1) return false;
+    const uint8_t *d = &msg[idx];
+    out->active_permille[0] = (uint16_t)((d[0] << 7) | d[1]);
+    out->active_permille[1] = (uint16_t)((d[2] << 7) | d[3]);
+    out->profile = d[4];
+    out->sys_khz = ((uint32_t)d[5] << 14) | ((uint32_t)d[6] << 7) | d[7];
+    if (d[8] != POWER_PROFILE_COUNT || len < idx + 9 + 7 * POWER_PROFILE_COUNT + 1) return false;
+    d += 9;
+    for (int p = 0; p < POWER_PROFILE_COUNT; p++, d += 7) {
+        out->state_ms[p] = midi_sysex_decode_u32(d);
+        out->entries[p] = (uint16_t)((d[5] << 7) | d[6]);
+    }
+    return true;
+}
+
+/**
+ * @brief Over-range recovery block from the last CMD_DIAGNOSTICS (after
+ *        the power block)
+ * @return false if the message is missing or short
+ */
+static bool diag_overrange(overrange_stats_t *out) {
+    size_t len;
+    const uint8_t *msg = sim_app_last_msg(CMD_DIAGNOSTICS, &len);
+    if (len < 4 + 15) return false;
+    size_t idx = 4 + 15 + (size_t)msg[4 + 14] * 6 + 4 * 3 + 9 + 7 * POWER_PROFILE_COUNT;
+    if (len < idx + 3 * 2 + 1) return false;
+    const uint8_t *d = &msg[idx];
+    out->last_ms = (uint16_t)((d[0] << 7) | d[1]);
+    out->max_ms = (uint16_t)((d[2] << 7) | d[3]);
+    out->predicted = (uint16_t)((d[4] << 7) | d[5]);
+    return true;
+}
+
+/**
+ * @brief Ask for the recorder state (CMD_GET_RECORDER_STATUS)
+ */
+static bool recorder_state_is(uint8_t state) {
+    sim_app_send(CMD_GET_RECORDER_STATUS, NULL, 0);
+    return sim_app_run_until(CMD_RECORDER_STATUS, 100000) != SIM_APP_TIMEOUT &&
+           last_msg_byte_is(CMD_RECORDER_STATUS, 4, state);
+}
+
+static void recorder_control(uint8_t op, uint32_t arg) {
+    // u32 arguments go as 4+7+7+7+7 bits, high first (midi_sysex_decode_u32)
+    uint8_t data[6] = { op, (arg >> 28) & 0x0F, (arg >> 21) & 0x7F, (arg >> 14) & 0x7F,
+                        (arg >> 7) & 0x7F, arg & 0x7F };
+    sim_app_send(CMD_RECORDER_CONTROL, data, (op == RECORDER_OP_SET_TRIGGER) ? 6 : 1);
+    sim_app_run_until(CMD_ACK, 100000);
+}
+
+/**
+ * @brief Start a recorder download and never acknowledge it, so an
+ *        active transfer keeps retransmitting its window
+ * @return true once the first chunk arrived
+ */
+static bool recorder_download_start(void) {
+    uint8_t start[9] = { BULK_OBJECT_RECORDER, 0, 0, 0, 0, 0,
+                         (BULK_CHUNK >> 7) & 0x7F, BULK_CHUNK & 0x7F, 1 };
+    sim_app_reset();
+    sim_app_send(CMD_BULK_START, start, sizeof(start));
+    return sim_app_run_until(CMD_BULK_INFO, 100000) != SIM_APP_TIMEOUT &&
+           last_msg_byte_is(CMD_BULK_INFO, 5, BULK_STATUS_OK) &&
+           (sim_app_msg_count(CMD_BULK_DATA) > 0 ||
+            sim_app_run_until(CMD_BULK_DATA, 100000) != SIM_APP_TIMEOUT);
+}
+
+/**
+ * @brief Request diagnostics and decode the power block
+ */
+static bool get_power(power_stats_t *out) {
+    sim_app_send(CMD_GET_DIAGNOSTICS, NULL, 0);
+    return sim_app_run_until(CMD_DIAGNOSTICS, 100000) != SIM_APP_TIMEOUT && diag_power(out);
+}
+
+int main(void) {
+    sim_flash_init();
+    sim_bmp280_add(SENSOR_ADDR);
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA);
+
+    clock_t wall0 = clock();
+    sim_boot(divechecker_main);
+
+    printf("boot\n");
+    uint64_t boot_us = sim_app_run_until(CMD_PRESSURE, 5000000);
+    printf("  first frame after %.1f ms\n", boot_us / 1000.0);
+    check(boot_us != SIM_APP_TIMEOUT, "pressure frames flowing");
+    check(boot_us < BOOT_BUDGET_US, "first frame within 300 ms");
+    sim_app_send(CMD_REQUEST_INFO, NULL, 0);
+    size_t info_len = 0;
+    check(sim_app_run_until(CMD_DEVICE_INFO, 100000) != SIM_APP_TIMEOUT &&
+          sim_app_last_msg(CMD_DEVICE_INFO, &info_len) && info_len >= 2 &&
+          last_msg_byte_is(CMD_DEVICE_INFO, info_len - 2, SENSOR_STATUS_READY),
+          "device info: sensor ready");
+    sim_app_send(CMD_GET_DIAGNOSTICS, NULL, 0);
+    uint32_t phases[4];
+    bool have_phases = sim_app_run_until(CMD_DIAGNOSTICS, 100000) != SIM_APP_TIMEOUT &&
+                       diag_boot_times(phases);
+    if (have_phases) {
+        printf("  usb init %u ms, mounted %u ms, sensor %u ms, first frame %u ms\n",
+               phases[0], phases[1], phases[2], phases[3]);
+    }
+    check(have_phases && phases[0] <= phases[1] && phases[2] <= phases[3] &&
+          phases[3] < BOOT_BUDGET_US / 1000, "diagnostics boot phases");
+
+    check(clock_get_hz(clk_sys) == SLOW_SYS_HZ, "idle clock until the app connects");
+
+    printf("ping\n");
+    sim_app_send(CMD_PING, NULL, 0);
+    uint64_t pong_us = sim_app_run_until(CMD_PONG, 100000);
+    printf("  round trip %.1f ms\n", pong_us / 1000.0);
+    check(pong_us <= 5000, "PONG within 5 ms");
+
+    printf("rate (default %d Hz)\n", DEFAULT_OUTPUT_RATE_HZ);
+    sim_app_reset();
+    sim_app_run(5000000);
+    printf("  %d frames in 5 s\n", sim_app_frame_count());
+    check(abs(sim_app_frame_count() - 5 * DEFAULT_OUTPUT_RATE_HZ) <= 1, "frame rate matches");
+
+    printf("baseline\n");
+    double mean = frames_mean(0);
+    double rms = frames_rms(0, mean);
+    printf("  mean %.1f, rms %.1f (x0.001 hPa)\n", mean, rms);
+    check(fabs(mean) < 20.0, "centred on zero");
+
+    printf("step +25 hPa\n");
+    sim_app_reset();
+    uint64_t step_us = sim_now_us();
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA + 25.0f);
+    sim_app_run(3000000);
+    const sim_frame_t *frames = sim_app_frames();
+    uint64_t settle_us = SIM_APP_TIMEOUT;
+    for (int i = 0; i < sim_app_frame_count(); i++) {
+        if (fabs(frames[i].value_x1000 - 25000.0) < 250.0) {
+            settle_us = frames[i].t_us - step_us;
+            break;
+        }
+    }
+    int tail = frames_tail(8);
+    mean = frames_mean(tail);
+    printf("  within 1%% after %.1f ms, settled at %.1f\n", settle_us / 1000.0, mean);
+    check(settle_us < 500000, "settles within 500 ms");
+    check(fabs(mean - 25000.0) < 50.0, "settled level");
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA);
+    sim_app_run(1000000);
+
+    printf("set rate %d Hz\n", STREAMING_RATE_HZ);
+    uint8_t rate = STREAMING_RATE_HZ;
+    sim_app_send(CMD_SET_OUTPUT_RATE, &rate, 1);
+    check(sim_app_run_until(CMD_CONFIG, 100000) != SIM_APP_TIMEOUT &&
+          last_msg_byte_is(CMD_CONFIG, 4, rate), "CONFIG reply");
+    sim_app_run(500000);
+    sim_app_reset();
+    sim_app_run(5000000);
+    printf("  %d frames in 5 s\n", sim_app_frame_count());
+    check(abs(sim_app_frame_count() - 5 * rate) <= 1, "frame rate matches");
+
+    printf("over-range\n");
+    sim_app_reset();
+    sim_bmp280_set_pressure(SENSOR_ADDR, 1300.0f);
+    uint64_t alert_us = sim_app_run_until(CMD_OVERRANGE_ALERT, 2000000);
+    printf("  alert after %.1f ms\n", alert_us / 1000.0);
+    check(alert_us != SIM_APP_TIMEOUT, "OVERRANGE_ALERT sent");
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA);
+    sim_app_reset();
+    uint64_t back_us = sim_app_run_until(CMD_PRESSURE, 3000000);
+    sim_app_run(2000000);
+    tail = frames_tail(8);
+    mean = frames_mean(tail);
+    printf("  frames again after %.1f ms, level %.1f\n", back_us / 1000.0, mean);
+    check(back_us != SIM_APP_TIMEOUT && fabs(mean) < 50.0, "recovered to baseline");
+    overrange_stats_t recovery = { 0 };
+    sim_app_send(CMD_GET_DIAGNOSTICS, NULL, 0);
+    bool have_recovery = sim_app_run_until(CMD_DIAGNOSTICS, 100000) != SIM_APP_TIMEOUT &&
+                         diag_overrange(&recovery);
+    printf("  recovery %u ms (worst %u ms)\n", recovery.last_ms, recovery.max_ms);
+    check(have_recovery && recovery.last_ms < RECOVERY_BUDGET_MS &&
+          recovery.max_ms >= recovery.last_ms, "diagnostics recovery time");
+
+    printf("get config\n");
+    sim_app_send(CMD_GET_CONFIG, NULL, 0);
+    check(sim_app_run_until(CMD_FULL_CONFIG, 100000) != SIM_APP_TIMEOUT &&
+          last_msg_byte_is(CMD_FULL_CONFIG, 4, rate), "FULL_CONFIG rate");
+
+    printf("pressure stats\n");
+    uint8_t stats_on = 1;
+    sim_app_send(CMD_SET_PRESSURE_STATS, &stats_on, 1);
+    check(sim_app_run_until(CMD_ACK, 100000) != SIM_APP_TIMEOUT &&
+          last_msg_byte_is(CMD_ACK, 4, CMD_SET_PRESSURE_STATS) &&
+          last_msg_byte_is(CMD_ACK, 5, 0x00), "ACK");
+    sim_app_run(100000);
+    sim_app_reset();
+    sim_app_run(1000000);
+    frames = sim_app_frames();
+    int stats_frames = 0, inside = 0;
+    uint32_t stddev_max = 0;
+    for (int i = 0; i < sim_app_frame_count(); i++) {
+        if (frames[i].count != STATS_SAMPLES) continue;
+        stats_frames++;
+        // The mean is noise-floored (1 mhPa), the extremes are not
+        if (frames[i].min_x1000 - 1 <= frames[i].value_x1000 &&
+            frames[i].value_x1000 <= frames[i].max_x1000 + 1) {
+            inside++;
+        }
+        if (frames[i].stddev_x1e6 > stddev_max) stddev_max = frames[i].stddev_x1e6;
+    }
+    printf("  %d stats frames in 1 s, %d with the value in range, stddev up to %u x1e-6 hPa\n",
+           stats_frames, inside, stddev_max);
+    check(abs(stats_frames - rate) <= 1 && stats_frames == sim_app_frame_count(),
+          "one stats frame per period");
+    check(stats_frames > 0 && inside == stats_frames, "value within [min, max]");
+    check(stddev_max > 0 && stddev_max < 20000, "spread of the sensor noise");
+    sim_app_reset();
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA + 5.0f);
+    sim_app_run(300000);
+    frames = sim_app_frames();
+    const sim_frame_t *edge = NULL;
+    for (int i = 0; i < sim_app_frame_count(); i++) {
+        if (edge == NULL || frames[i].max_x1000 - frames[i].min_x1000 >
+                            edge->max_x1000 - edge->min_x1000) {
+            edge = &frames[i];
+        }
+    }
+    if (edge != NULL) {
+        printf("  +5 hPa edge: window %.3f..%.3f hPa, mean %.3f, stddev %.3f\n",
+               edge->min_x1000 / 1000.0, edge->max_x1000 / 1000.0, edge->value_x1000 / 1000.0,
+               edge->stddev_x1e6 / 1e6);
+    }
+    check(edge != NULL && edge->max_x1000 - edge->min_x1000 >= 1000 &&
+          edge->min_x1000 < edge->value_x1000 && edge->value_x1000 < edge->max_x1000 &&
+          edge->stddev_x1e6 >= 300000, "edge spans its window");
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA);
+    sim_app_run(1000000);
+    stats_on = 0;
+    sim_app_send(CMD_SET_PRESSURE_STATS, &stats_on, 1);
+    sim_app_run(100000);
+    sim_app_reset();
+    sim_app_run(500000);
+    check(sim_app_msg_count(CMD_PRESSURE_STATS) == 0 && sim_app_msg_count(CMD_PRESSURE) > 0,
+          "plain frames when off");
+
+    printf("governor\n");
+    power_stats_t power;
+    bool have_power = get_power(&power);
+    printf("  %u Hz output: profile %u, clk_sys %.0f MHz\n", rate, have_power ? power.profile : 0,
+           clock_get_hz(clk_sys) / 1e6);
+    check(have_power && power.profile == POWER_PROFILE_STREAMING &&
+          power.sys_khz == STREAMING_SYS_HZ / 1000, "streaming clock");
+    uint8_t fast_rate = MAX_OUTPUT_RATE_HZ;
+    sim_app_send(CMD_SET_OUTPUT_RATE, &fast_rate, 1);
+    sim_app_run(500000);
+    sim_app_reset();
+    sim_app_run(2000000);
+    printf("  %u Hz output: %d frames in 2 s, clk_sys %.0f MHz\n", fast_rate,
+           sim_app_frame_count(), clock_get_hz(clk_sys) / 1e6);
+    check(clock_get_hz(clk_sys) == FULL_SYS_HZ &&
+          abs(sim_app_frame_count() - 2 * fast_rate) <= 1, "full clock above 20 Hz");
+    sim_app_send(CMD_SET_OUTPUT_RATE, &rate, 1);
+    sim_app_run(FLASH_SAVE_US);                 // Settings write: no clock change
+    uint8_t nonce[64];
+    memset(nonce, 'a', sizeof(nonce));
+    power_stats_t before = {0};
+    get_power(&before);
+    sim_app_send(CMD_AUTH_CHALLENGE, nonce, sizeof(nonce));
+    check(sim_app_run_until(CMD_ACK, 100000) != SIM_APP_TIMEOUT && get_power(&power) &&
+          power.entries[POWER_PROFILE_CRYPTO] == before.entries[POWER_PROFILE_CRYPTO] + 1 &&
+          power.sys_khz == STREAMING_SYS_HZ / 1000, "crypto job, then streaming again");
+    uint32_t total_ms = 0;
+    for (int p = 0; p < POWER_PROFILE_COUNT; p++) {
+        printf("  %-10s %8u ms %5u entries\n", k_profile_names[p], power.state_ms[p],
+               power.entries[p]);
+        total_ms += power.state_ms[p];
+    }
+    sim_flash_stats_t erases;
+    sim_flash_get_stats(&erases);
+    check(total_ms + 200 >= sim_now_us() / 1000 && total_ms <= sim_now_us() / 1000,
+          "time-in-state covers the run");
+    check(power.entries[POWER_PROFILE_FLASH] == erases.sector_erases,
+          "flash profile for erases only");
+
+    printf("suspend %.0f s\n", SUSPEND_US / 1e6);
+    get_power(&before);
+    uint64_t suspend_us = sim_now_us();
+    sim_usb_suspend(false);
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA + 10.0f);
+    sim_app_run(SUSPEND_US / 2);
+    uint32_t low_sys_hz = clock_get_hz(clk_sys);
+    uint32_t conv0 = sim_bmp280_conversions(SENSOR_ADDR);
+    uint64_t half_us = sim_now_us();
+    sim_app_run(SUSPEND_US / 2);
+    uint32_t conversions = sim_bmp280_conversions(SENSOR_ADDR) - conv0;
+    printf("  clk_sys %.0f MHz, %u conversions in %.0f ms\n", low_sys_hz / 1e6, conversions,
+           (sim_now_us() - half_us) / 1000.0);
+    check(low_sys_hz == SLOW_SYS_HZ, "clk_sys lowered");
+    check(conversions <= (sim_now_us() - half_us) / KEEP_WARM_US + 1, "keep-warm rate only");
+    sim_app_reset();
+    uint64_t resume_us = sim_now_us();
+    uint64_t suspended_ms = (resume_us - suspend_us) / 1000;
+    sim_usb_resume();
+    sim_app_run(1000000);
+    frames = sim_app_frames();
+    uint64_t level_us = SIM_APP_TIMEOUT;
+    for (int i = 0; i < sim_app_frame_count(); i++) {
+        if (fabs(frames[i].value_x1000 - 10000.0) < 100.0) {
+            level_us = frames[i].t_us - resume_us;
+            break;
+        }
+    }
+    printf("  new level after %.1f ms, %d frames in 1 s, clk_sys %.0f MHz\n",
+           level_us / 1000.0, sim_app_frame_count(), clock_get_hz(clk_sys) / 1e6);
+    check(level_us <= 1000000u / rate + 10000, "level within one output period");
+    check(abs(sim_app_frame_count() - rate) <= 1, "full frame rate again");
+    have_power = get_power(&power);
+    // Idle flash maintenance runs meanwhile and is accounted to its own profile
+    uint32_t suspend_ms = power.state_ms[POWER_PROFILE_SUSPEND] -
+                          before.state_ms[POWER_PROFILE_SUSPEND];
+    uint32_t flash_ms = power.state_ms[POWER_PROFILE_FLASH] -
+                        before.state_ms[POWER_PROFILE_FLASH];
+    if (have_power) {
+        printf("  active core0 %.1f%%, core1 %.1f%%; suspended %u ms, flash %u ms\n",
+               power.active_permille[0] / 10.0, power.active_permille[1] / 10.0,
+               suspend_ms, flash_ms);
+    }
+    check(have_power && power.entries[POWER_PROFILE_SUSPEND] ==
+                        before.entries[POWER_PROFILE_SUSPEND] + 1 &&
+          suspend_ms + flash_ms + 100 >= suspended_ms &&
+          suspend_ms + flash_ms <= suspended_ms &&
+          power.sys_khz == clock_get_hz(clk_sys) / 1000, "diagnostics power block");
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA);
+
+    printf("recorder download\n");
+    recorder_control(RECORDER_OP_START, 0);
+    sim_app_run(3000000);
+    recorder_control(RECORDER_OP_STOP, 0);
+    check(recorder_download_start(), "download running");
+    recorder_control(RECORDER_OP_START, 0);
+    sim_app_reset();
+    sim_app_run(BULK_QUIET_US);
+    printf("  command start: %u chunks afterwards\n", sim_app_msg_count(CMD_BULK_DATA));
+    check(sim_app_msg_count(CMD_BULK_DATA) == 0 && recorder_state_is(RECORDER_STATE_RECORDING),
+          "command start aborts it");
+    recorder_control(RECORDER_OP_STOP, 0);
+    recorder_control(RECORDER_OP_SET_TRIGGER, TRIGGER_X1000);
+    bool downloading = recorder_download_start();
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA + 10.0f);
+    sim_app_run(1000000);
+    sim_app_reset();
+    sim_app_run(BULK_QUIET_US);
+    printf("  trigger start: %u chunks afterwards\n", sim_app_msg_count(CMD_BULK_DATA));
+    check(downloading && sim_app_msg_count(CMD_BULK_DATA) == 0 &&
+          recorder_state_is(RECORDER_STATE_TRIGGERED), "trigger start aborts it");
+    sim_bmp280_set_pressure(SENSOR_ADDR, AMBIENT_HPA);
+    recorder_control(RECORDER_OP_STOP, 0);
+    recorder_control(RECORDER_OP_SET_TRIGGER, 0);
+    sim_app_run(FLASH_SAVE_US);
+
+    printf("health\n");
+    sim_flash_stats_t flash;
+    sim_flash_get_stats(&flash);
+    printf("  flash: %u sector erases, %u page programs, %.1f ms stalled\n",
+           flash.sector_erases, flash.page_programs, flash.busy_us / 1000.0);
+    printf("  sensor: %u conversions\n", sim_bmp280_conversions(SENSOR_ADDR));
+    check(sim_halted() == SIM_RUNNING, sim_halted() == SIM_RUNNING
+          ? "no watchdog / reset" : sim_halt_name(sim_halted()));
+
+    double wall_s = (double)(clock() - wall0) / CLOCKS_PER_SEC;
+    printf("simulated %.1f s in %.2f s CPU (%.0fx), %llu context switches\n",
+           sim_now_us() / 1e6, wall_s, wall_s > 0 ? sim_now_us() / 1e6 / wall_s : 0.0,
+           (unsigned long long)sim_context_switches());
+    printf("%s\n", g_failures ? "FAILED" : "all checks passed");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file microbench.c
+ * @brief Runs the firmware hot-path microbenchmarks and prints them as JSON
+ *
+ * Sends CMD_RUN_MICROBENCH and collects one CMD_MICROBENCH_RESULT per case
+ * (see microbench.h for the cases). Two targets:
+ *
+ *   default            the firmware on the host simulator, timed in ns
+ *   --device <rawmidi> a board flashed with a DIVECHECKER_MICROBENCH image,
+ *                      timed in DWT cycles (Linux ALSA raw MIDI node,
+ *                      e.g. /dev/snd/midiC1D0)
+ *
+ * Output is one JSON object keyed by case name, cost per operation in the
+ * target's unit, so two runs (or two releases) diff line by line:
+ *
+ *   {
+ *     "target": "sim",
+ *     "unit": "ns",
+ *     "iterations": 10000,
+ *     "results": {
+ *       "bmp280_compensate": 12.34,
+ *       ...
+ *
+ * Host numbers measure this machine, not the RP2350; compare like with
+ * like. Exits non-zero if no results arrive.
+ *
+ * Usage: microbench [--iterations n] [--device path]
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim.h"
+#include "sim_app.h"
+#include "midi_sysex.h"
+#include "microbench.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SENSOR_ADDR         0x76
+#define BOOT_US             1000000     // USB enumerated, first frames out
+#define SIM_TIMEOUT_US      5000000
+#define DEVICE_TIMEOUT_MS   30000
+
+int divechecker_main(void);             // Firmware main(), renamed at compile time
+
+typedef struct {
+    char name[MICROBENCH_NAME_MAX + 1];
+    uint32_t iterations;
+    uint32_t best_ticks;
+} result_t;
+
+static result_t g_results[MICROBENCH_MAX_CASES];
+static int g_expected = -1;             // Count from the first result
+static int g_received = 0;
+static uint8_t g_unit = MICROBENCH_UNIT_CYCLES;
+static bool g_not_compiled = false;
+
+/**
+ * @brief Take one complete SysEx message (F0 ... F7) from either target
+ */
+static void on_message(const uint8_t *msg, size_t len) {
+    if (len < 5 || msg[1] != SYSEX_MANUFACTURER_ID || msg[2] != SYSEX_DEVICE_ID) return;
+    const uint8_t *d = &msg[4];
+    size_t n = len - 5;
+
+    if (msg[3] == CMD_ACK && n >= 2 && d[0] == CMD_RUN_MICROBENCH && d[1] == 0x03) {
+        g_not_compiled = true;
+    } else if (msg[3] == CMD_MICROBENCH_RESULT && n >= 14) {
+        uint8_t index = d[0];
+        uint8_t name_len = d[13];
+        if (index >= MICROBENCH_MAX_CASES || name_len > MICROBENCH_NAME_MAX ||
+            n < 14u + name_len) {
+            return;
+        }
+        result_t *r = &g_results[index];
+        memcpy(r->name, &d[14], name_len);
+        r->name[name_len] = '\0';
+        r->iterations = midi_sysex_decode_u32(&d[3]);
+        r->best_ticks = midi_sysex_decode_u32(&d[8]);
+        g_unit = d[2];
+        g_expected = d[1];
+        g_received++;
+    }
+}
+
+static bool done(void) {
+    return g_not_compiled || (g_expected >= 0 && g_received >= g_expected);
+}
+
+static size_t build_request(uint8_t *msg, uint32_t iterations) {
+    uint8_t data[5] = {
+        (iterations >> 28) & 0x0F, (iterations >> 21) & 0x7F, (iterations >> 14) & 0x7F,
+        (iterations >> 7) & 0x7F, iterations & 0x7F,
+    };
+    return midi_sysex_frame(msg, CMD_RUN_MICROBENCH, data, sizeof(data));
+}
+
+static bool run_sim(uint32_t iterations) {
+    sim_flash_init();
+    sim_bmp280_add(SENSOR_ADDR);
+    sim_boot(divechecker_main);
+    sim_app_run(BOOT_US);
+
+    uint8_t msg[SYSEX_MAX_SIZE];
+    size_t len = build_request(msg, iterations);
+    sim_app_set_listener(on_message);
+    sim_app_send(msg[3], &msg[4], len - 5);
+    uint64_t start = sim_now_us();
+    while (!done() && sim_now_us() - start < SIM_TIMEOUT_US && sim_halted() == SIM_RUNNING) {
+        sim_app_run(1000);
+    }
+    if (sim_halted() != SIM_RUNNING) {
+        fprintf(stderr, "firmware stopped: %s\n", sim_halt_name(sim_halted()));
+        return false;
+    }
+    return true;
+}
+
+static bool run_device(const char *path, uint32_t iterations) {
+    int fd = open(path, O_RDWR);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    uint8_t msg[SYSEX_MAX_SIZE];
+    size_t len = build_request(msg, iterations);
+    if (write(fd, msg, len) != (ssize_t)len) {
+        perror("write");
+        close(fd);
+        return false;
+    }
+
+    // Reassemble SysEx from the byte stream; everything else is ignored
+    uint8_t rx[SYSEX_MAX_SIZE];
+    size_t rx_len = 0;
+    bool in_sysex = false;
+    while (!done()) {
+        struct pollfd pfd = { .fd = fd, .events = POLLIN };
+        if (poll(&pfd, 1, DEVICE_TIMEOUT_MS) <= 0) break;
+        uint8_t buf[256];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        for (ssize_t i = 0; i < n; i++) {
+            uint8_t b = buf[i];
+            if (b >= 0xF8) continue;                // Real-time
+            if (b == SYSEX_START) {
+                in_sysex = true;
+                rx_len = 0;
+            } else if (!in_sysex) {
+                continue;
+            } else if (b & 0x80 && b != SYSEX_END) {
+                in_sysex = false;                   // Interrupted
+                continue;
+            }
+            if (rx_len < sizeof(rx)) rx[rx_len++] = b;
+            if (b == SYSEX_END) {
+                in_sysex = false;
+                on_message(rx, rx_len);
+            }
+        }
+    }
+    close(fd);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    uint32_t iterations = MICROBENCH_MAX_ITERS;
+    const char *device = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--device") == 0 && i + 1 < argc) {
+            device = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--iterations n] [--device path]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (!(device ? run_device(device, iterations) : run_sim(iterations))) return 1;
+    if (g_not_compiled) {
+        fprintf(stderr, "firmware built without DIVECHECKER_MICROBENCH\n");
+        return 1;
+    }
+    if (!done() || g_received == 0) {
+        fprintf(stderr, "got %d of %d results\n", g_received, g_expected);
+        return 1;
+    }
+
+    printf("{\n");
+    printf("  \"target\": \"%s\",\n", device ? "device" : "sim");
+    printf("  \"unit\": \"%s\",\n", g_unit == MICROBENCH_UNIT_NS ? "ns" : "cycles");
+    printf("  \"iterations\": %u,\n", g_results[0].iterations);
+    printf("  \"results\": {\n");
+    for (int i = 0; i < g_expected; i++) {
+        const result_t *r = &g_results[i];
+        printf("    \"%s\": %.2f%s\n", r->name,
+               r->iterations ? (double)r->best_ticks / r->iterations : 0.0,
+               i + 1 < g_expected ? "," : "");
+    }
+    printf("  }\n}\n");
+    return 0;
+}
@@ -0,0 +1,361 @@
+/**
+ * @file sensor_fault_bench.c
+ * @brief Scripted sensor faults against the simulated firmware, timing how
+ *        long each one keeps valid data away
+ *
+ * Boots the firmware on the host simulator (see divechecker_sim.c) with the
+ * BMP280 register model and replays a scenario script against it. Each
+ * scenario drives the pressure (steps, ramps, sine waves), injects a fault
+ * at the register or bus level and measures, from the SysEx stream the app
+ * would see:
+ *
+ *   recovery   fault cleared (or injected, for self-clearing faults) ->
+ *              first Pressure frame back within tolerance of the truth
+ *   gap        last frame before the fault -> that same frame, i.e. how
+ *              long the app had nothing usable to draw
+ *
+ * and compares the recovery with the scenario's budget. Simulated time
+ * makes every number exact and repeatable, so the CSV output (--csv) can be
+ * diffed release over release. Exits non-zero when a budget is exceeded.
+ *
+ * Script (one command per line, '#' starts a comment, times in ms):
+ *
+ *   scenario <name>            Start a scenario (name is reported)
+ *   pressure <hPa>             Set the ambient pressure
+ *   ramp <hPa> <ms>            Linear ramp to hPa
+ *   sine <amp hPa> <Hz> <ms>   Sine around the current pressure
+ *   wait <ms>                  Let the firmware run
+ *   fault <kind> [arg]         skip | saturate | nak | stuck_sda [pulses]
+ *   clear                      End the fault
+ *   mark                       Recovery reference without a fault (e.g.
+ *                              after driving the pressure out of range)
+ *   expect <ms>                Run until valid data, fail past ms from the
+ *                              last fault / clear / mark
+ *   expect_reset <ms>          Run until the firmware soft-resets the
+ *                              sensor, same reference and budget rule
+ *
+ * Usage: sensor_fault_bench [--script file] [--csv] [--tolerance hPa]
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim.h"
+#include "sim_app.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SENSOR_ADDR         0x76
+#define AMBIENT_HPA         1013.25f
+#define SETTLE_MS           3000    // Boot, baseline and sensor IIR settle
+#define EXPECT_SLACK_MS     10000   // Keep looking this long past a budget
+#define MAX_LINE            256
+
+int divechecker_main(void);         // Firmware main(), renamed at compile time
+
+// Built-in scenarios: every fault kind the recovery paths handle
+static const char k_default_script[] =
+    "scenario saturated_adc\n"          // Over-range via the ADC code:
+    "fault saturate\n"                  // IIR bypass, re-seeded frame
+    "wait 1000\n"
+    "clear\n"
+    "expect 100\n"
+    "\n"
+    "scenario overrange_pressure\n"     // Over-range via the pressure itself,
+    "ramp 1400 200\n"                   // seen coming from the trend
+    "wait 800\n"
+    "pressure 1013.25\n"
+    "mark\n"
+    "expect 100\n"
+    "\n"
+    "scenario skipped_burst\n"          // Shorter than the over-range threshold
+    "fault skip\n"
+    "wait 50\n"
+    "clear\n"
+    "expect 500\n"
+    "\n"
+    "scenario saturated_then_skipped\n" // Brown-out while bypassed: the
+    "fault saturate\n"                  // skips still take the reset path
+    "wait 300\n"
+    "fault skip\n"
+    "expect_reset 500\n"
+    "clear\n"
+    "expect 1500\n"
+    "\n"
+    "scenario skipped_long\n"           // Soft reset path
+    "fault skip\n"
+    "wait 1000\n"
+    "clear\n"
+    "expect 1500\n"
+    "\n"
+    "scenario breath_then_skipped\n"    // Fault in the middle of a waveform
+    "sine 30 0.5 3000\n"
+    "fault skip\n"
+    "sine 30 0.5 500\n"
+    "clear\n"
+    "pressure 1013.25\n"
+    "expect 1500\n"
+    "\n"
+    "scenario nak_short\n"              // Re-init fails, periodic retry
+    "fault nak\n"
+    "wait 200\n"
+    "clear\n"
+    "expect 6000\n"
+    "\n"
+    "scenario nak_long\n"
+    "fault nak\n"
+    "wait 3000\n"
+    "clear\n"
+    "expect 6000\n"
+    "\n"
+    "scenario stuck_sda_released\n"     // Bus recovery's clock pulses free it
+    "fault stuck_sda 5\n"
+    "expect 1000\n"
+    "\n"
+    "scenario stuck_sda_held\n"         // Held until the bench lets go
+    "fault stuck_sda\n"
+    "wait 1000\n"
+    "clear\n"
+    "expect 6000\n";
+
+typedef struct {
+    char name[48];
+    char fault[16];
+    uint64_t ref_us;            // Recovery reference (fault / clear / mark)
+    uint64_t fault_us;
+    uint64_t last_good_us;      // Last frame before the fault
+    uint32_t resets_at_ref;     // Sensor soft resets at ref_us
+} scenario_t;
+
+static float g_truth_hpa = AMBIENT_HPA;
+static double g_baseline_hpa = AMBIENT_HPA;
+static double g_tolerance_hpa = 0.5;
+static bool g_csv = false;
+static int g_failures = 0;
+
+static void set_pressure(float hpa) {
+    g_truth_hpa = hpa;
+    sim_bmp280_set_pressure(SENSOR_ADDR, hpa);
+}
+
+static bool frame_valid(const sim_frame_t *f) {
+    double expected = (g_truth_hpa - g_baseline_hpa) * 1000.0;
+    return fabs(f->value_x1000 - expected) <= g_tolerance_hpa * 1000.0;
+}
+
+static uint64_t last_frame_us(bool valid_only) {
+    const sim_frame_t *frames = sim_app_frames();
+    for (int i = sim_app_frame_count() - 1; i >= 0; i--) {
+        if (!valid_only || frame_valid(&frames[i])) return frames[i].t_us;
+    }
+    return 0;
+}
+
+/**
+ * @brief Print one result row and count a missed budget
+ * @param found_us When the awaited event happened, SIM_APP_TIMEOUT if never
+ * @param with_gap Whether the event ends the gap (valid data again)
+ */
+static void report(const scenario_t *sc, uint64_t found_us, uint32_t budget_ms,
+                   bool with_gap) {
+    bool ok = found_us != SIM_APP_TIMEOUT && found_us - sc->ref_us <= (uint64_t)budget_ms * 1000;
+    double recovery_ms = found_us != SIM_APP_TIMEOUT ? (found_us - sc->ref_us) / 1000.0 : NAN;
+    double gap_ms = (with_gap && found_us != SIM_APP_TIMEOUT && sc->last_good_us > 0)
+                    ? (found_us - sc->last_good_us) / 1000.0 : NAN;
+    if (g_csv) {
+        printf("%s,%s,%.1f,%.1f,%u,%s\n", sc->name, sc->fault, recovery_ms, gap_ms,
+               budget_ms, ok ? "ok" : "FAIL");
+    } else {
+        printf("%-24s %-10s %10.1f %10.1f %8u  %s\n", sc->name, sc->fault, recovery_ms,
+               gap_ms, budget_ms, ok ? "ok" : "FAIL");
+    }
+    if (!ok) g_failures++;
+}
+
+/**
+ * @brief Run until a valid frame arrives after the reference point
+ */
+static void expect(const scenario_t *sc, uint32_t budget_ms) {
+    uint64_t limit_us = ((uint64_t)budget_ms + EXPECT_SLACK_MS) * 1000;
+    int scanned = 0;
+    uint64_t found_us = SIM_APP_TIMEOUT;
+    while (found_us == SIM_APP_TIMEOUT && sim_now_us() - sc->ref_us < limit_us &&
+           sim_halted() == SIM_RUNNING) {
+        sim_app_run(1000);
+        const sim_frame_t *frames = sim_app_frames();
+        for (; scanned < sim_app_frame_count(); scanned++) {
+            if (frames[scanned].t_us > sc->ref_us && frame_valid(&frames[scanned])) {
+                found_us = frames[scanned].t_us;
+                break;
+            }
+        }
+    }
+    report(sc, found_us, budget_ms, true);
+}
+
+/**
+ * @brief Run until the sensor has been soft-reset since the reference point
+ */
+static void expect_reset(const scenario_t *sc, uint32_t budget_ms) {
+    uint64_t limit_us = ((uint64_t)budget_ms + EXPECT_SLACK_MS) * 1000;
+    uint64_t found_us = SIM_APP_TIMEOUT;
+    while (found_us == SIM_APP_TIMEOUT && sim_now_us() - sc->ref_us < limit_us &&
+           sim_halted() == SIM_RUNNING) {
+        sim_app_run(1000);
+        if (sim_bmp280_soft_resets(SENSOR_ADDR) != sc->resets_at_ref) found_us = sim_now_us();
+    }
+    report(sc, found_us, budget_ms, false);
+}
+
+static bool parse_fault(const char *kind, sim_bmp280_fault_t *fault) {
+    static const struct { const char *name; sim_bmp280_fault_t fault; } k_faults[] = {
+        { "skip", SIM_BMP280_FAULT_SKIPPED },
+        { "saturate", SIM_BMP280_FAULT_SATURATED },
+        { "nak", SIM_BMP280_FAULT_NAK },
+        { "stuck_sda", SIM_BMP280_FAULT_STUCK_SDA },
+    };
+    for (size_t i = 0; i < sizeof(k_faults) / sizeof(k_faults[0]); i++) {
+        if (strcmp(kind, k_faults[i].name) == 0) {
+            *fault = k_faults[i].fault;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Execute one script line
+ * @return false on a syntax error
+ */
+static bool run_line(char *line, scenario_t *sc) {
+    char *hash = strchr(line, '#');
+    if (hash != NULL) *hash = '\0';
+    char cmd[32] = "", arg1[48] = "";
+    double a = 0, b = 0, c = 0;
+    int n = sscanf(line, "%31s %47s", cmd, arg1);
+    if (n <= 0) return true;
+    sscanf(line, "%*s %lf %lf %lf", &a, &b, &c);
+
+    if (strcmp(cmd, "scenario") == 0 && n == 2) {
+        memset(sc, 0, sizeof(*sc));
+        snprintf(sc->name, sizeof(sc->name), "%s", arg1);
+        snprintf(sc->fault, sizeof(sc->fault), "-");
+        if (sim_app_frame_count() > SIM_APP_MAX_FRAMES / 2) sim_app_reset();
+    } else if (strcmp(cmd, "pressure") == 0 && n == 2) {
+        set_pressure((float)a);
+    } else if (strcmp(cmd, "ramp") == 0 && b > 0) {
+        float from = g_truth_hpa;
+        for (uint32_t ms = 1; ms <= (uint32_t)b; ms++) {
+            set_pressure(from + (float)((a - from) * ms / b));
+            sim_app_run(1000);
+        }
+    } else if (strcmp(cmd, "sine") == 0 && c > 0) {
+        float centre = g_truth_hpa;
+        for (uint32_t ms = 1; ms <= (uint32_t)c; ms++) {
+            set_pressure(centre + (float)(a * sin(2.0 * M_PI * b * ms / 1000.0)));
+            sim_app_run(1000);
+        }
+        set_pressure(centre);
+    } else if (strcmp(cmd, "wait") == 0 && n == 2) {
+        sim_app_run((uint64_t)(a * 1000));
+    } else if (strcmp(cmd, "fault") == 0 && n == 2) {
+        sim_bmp280_fault_t fault;
+        if (!parse_fault(arg1, &fault)) return false;
+        uint32_t pulses = 0;
+        sscanf(line, "%*s %*s %u", &pulses);
+        sc->last_good_us = last_frame_us(false);
+        sc->fault_us = sc->ref_us = sim_now_us();
+        sc->resets_at_ref = sim_bmp280_soft_resets(SENSOR_ADDR);
+        snprintf(sc->fault, sizeof(sc->fault), "%s", arg1);
+        sim_bmp280_set_fault(SENSOR_ADDR, fault, pulses);
+    } else if (strcmp(cmd, "clear") == 0) {
+        sim_bmp280_set_fault(SENSOR_ADDR, SIM_BMP280_FAULT_NONE, 0);
+        sc->ref_us = sim_now_us();
+        sc->resets_at_ref = sim_bmp280_soft_resets(SENSOR_ADDR);
+    } else if (strcmp(cmd, "mark") == 0) {
+        // No fault: the gap starts at the last frame that matched the truth
+        if (sc->fault_us == 0) sc->last_good_us = last_frame_us(true);
+        sc->ref_us = sim_now_us();
+        sc->resets_at_ref = sim_bmp280_soft_resets(SENSOR_ADDR);
+    } else if (strcmp(cmd, "expect") == 0 && n == 2) {
+        expect(sc, (uint32_t)a);
+    } else if (strcmp(cmd, "expect_reset") == 0 && n == 2) {
+        expect_reset(sc, (uint32_t)a);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *script_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            script_path = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            g_tolerance_hpa = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            g_csv = true;
+        } else {
+            fprintf(stderr, "usage: %s [--script file] [--csv] [--tolerance hPa]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *script = script_path ? fopen(script_path, "r")
+                               : fmemopen((void *)k_default_script, strlen(k_default_script), "r");
+    if (script == NULL) {
+        perror(script_path);
+        return 2;
+    }
+
+    sim_flash_init();
+    sim_bmp280_add(SENSOR_ADDR);
+    set_pressure(AMBIENT_HPA);
+    sim_boot(divechecker_main);
+
+    // The firmware zeroes on its first frame; learn where that landed
+    sim_app_run((uint64_t)SETTLE_MS * 1000);
+    int count = sim_app_frame_count();
+    if (count < 4) {
+        fprintf(stderr, "no pressure frames after boot\n");
+        return 1;
+    }
+    double sum = 0;
+    for (int i = count - 4; i < count; i++) sum += sim_app_frames()[i].value_x1000;
+    g_baseline_hpa = g_truth_hpa - sum / 4 / 1000.0;
+
+    if (g_csv) {
+        printf("scenario,fault,recovery_ms,gap_ms,budget_ms,result\n");
+    } else {
+        printf("%-24s %-10s %10s %10s %8s\n", "scenario", "fault", "recovery", "gap", "budget");
+    }
+
+    char line[MAX_LINE];
+    int line_no = 0;
+    scenario_t sc = { .name = "-", .fault = "-" };
+    while (fgets(line, sizeof(line), script) != NULL) {
+        line_no++;
+        if (!run_line(line, &sc)) {
+            fprintf(stderr, "%s:%d: bad command: %s", script_path ? script_path : "built-in",
+                    line_no, line);
+            fclose(script);
+            return 2;
+        }
+        if (sim_halted() != SIM_RUNNING) {
+            printf("firmware stopped: %s\n", sim_halt_name(sim_halted()));
+            g_failures++;
+            break;
+        }
+    }
+    fclose(script);
+
+    if (!g_csv) {
+        printf("simulated %.1f s, %s\n", sim_now_us() / 1e6,
+               g_failures ? "FAILED" : "all within budget");
+    }
+    return g_failures ? 1 : 0;
+}
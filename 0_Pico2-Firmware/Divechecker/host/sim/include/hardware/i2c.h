@@ -0,0 +1,3 @@
+// Host simulator stand-in (see sim_sdk.h)
+#pragma once
+#include "sim_sdk.h"
@@ -0,0 +1,4 @@
+// Host simulator stand-in (see sim_sdk.h)
+#pragma once
+#include "sim_sdk.h"
+#include "tusb_config.h"
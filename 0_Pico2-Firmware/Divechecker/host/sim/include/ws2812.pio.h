@@ -0,0 +1,20 @@
+// Host simulator stand-in for the pioasm output of ws2812.pio (the LED
+// has nothing to simulate)
+#pragma once
+#include "sim_sdk.h"
+
+#define ws2812_T1 2
+#define ws2812_T2 5
+#define ws2812_T3 3
+
+static const uint16_t ws2812_program_instructions[] = { 0x6221, 0x1123, 0x1400, 0xa442 };
+
+static const pio_program_t ws2812_program = {
+    .instructions = ws2812_program_instructions,
+    .length = 4,
+    .origin = -1,
+};
+
+static inline void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw) {
+    (void)pio; (void)sm; (void)offset; (void)pin; (void)freq; (void)rgbw;
+}
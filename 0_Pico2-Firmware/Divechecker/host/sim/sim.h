@@ -0,0 +1,148 @@
+/**
+ * @file sim.h
+ * @brief Host simulator control: virtual clock, fake flash, USB-MIDI host
+ *        side and the BMP280 register model
+ *
+ * The firmware runs unchanged on two host threads (core 0 = main(),
+ * core 1 = core1_sensor_task) plus the bench thread that calls this API.
+ * Exactly one of the three executes at a time; every SDK call that waits
+ * (sleep_us, I2C transfers, FIFO/mutex waits) hands over to whichever
+ * participant has the earliest wake time, so the simulated time is
+ * deterministic and independent of the host's speed. Bench calls are only
+ * made while the bench holds the clock, so no locking is needed around
+ * the device models.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* ============================================================================
+ * Run control (sim_sdk.c)
+ * ========================================================================== */
+
+typedef enum {
+    SIM_RUNNING = 0,
+    SIM_HALT_WATCHDOG,          // Watchdog expired: a core stopped feeding it
+    SIM_HALT_REBOOT,            // watchdog_reboot() (soft reboot command)
+    SIM_HALT_BOOTSEL,           // reset_usb_boot()
+} sim_halt_t;
+
+/**
+ * @brief Start core 0 at firmware_main; the bench keeps the clock until it
+ *        calls sim_run_us
+ */
+void sim_boot(int (*firmware_main)(void));
+
+/**
+ * @brief Let the firmware run for us microseconds of simulated time
+ */
+void sim_run_us(uint64_t us);
+
+uint64_t sim_now_us(void);
+sim_halt_t sim_halted(void);
+const char *sim_halt_name(sim_halt_t halt);
+uint64_t sim_context_switches(void);
+
+/**
+ * @brief Device models: advance the clock without handing it over (a
+ *        flash operation stalls both cores)
+ */
+void sim_stall_us(uint64_t us);
+
+/* ============================================================================
+ * Flash (sim_flash.c): 4MB mapped at XIP_BASE, erased at start
+ * ========================================================================== */
+
+typedef struct {
+    uint32_t sector_erases;
+    uint32_t page_programs;
+    uint64_t busy_us;           // Time both cores spent stalled on flash
+} sim_flash_stats_t;
+
+void sim_flash_init(void);
+void sim_flash_get_stats(sim_flash_stats_t *stats);
+
+/* ============================================================================
+ * USB-MIDI host side (sim_usb.c)
+ * ========================================================================== */
+
+/**
+ * @brief Plug (enumerate) or unplug the device
+ */
+void sim_usb_plug(bool plugged);
+
+/**
+ * @brief Bus suspend / resume as the host's selective suspend does it
+ */
+void sim_usb_suspend(bool remote_wakeup_en);
+void sim_usb_resume(void);
+
+/**
+ * @brief MIDI events (4-byte USB-MIDI packets) the host takes per 1ms frame
+ */
+void sim_usb_set_host_rate(uint32_t events_per_frame);
+
+/**
+ * @brief Queue one host->device SysEx message (F0 ... F7)
+ */
+bool sim_usb_send(const uint8_t *sysex, size_t len);
+
+/**
+ * @brief Next complete device->host SysEx message (F0 ... F7)
+ * @return Message length, 0 if none has arrived yet
+ */
+size_t sim_usb_recv(uint8_t *buf, size_t max);
+
+/* ============================================================================
+ * BMP280 register model (sim_bmp280.c)
+ * ========================================================================== */
+
+/**
+ * @brief Put a BMP280 at addr (0x76 or 0x77) with datasheet trimming
+ */
+void sim_bmp280_add(uint8_t addr);
+
+/**
+ * @brief Remove the part from the bus (every transfer NAKs) or put it back
+ */
+void sim_bmp280_set_present(uint8_t addr, bool present);
+
+/**
+ * @brief Ambient pressure / temperature the next conversions measure
+ */
+void sim_bmp280_set_pressure(uint8_t addr, float hpa);
+void sim_bmp280_set_temperature(uint8_t addr, float celsius);
+
+/**
+ * @brief RMS pressure noise at oversampling x1 (scales with 1/sqrt(os))
+ */
+void sim_bmp280_set_noise(uint8_t addr, float pa_rms);
+
+uint32_t sim_bmp280_conversions(uint8_t addr);
+uint32_t sim_bmp280_soft_resets(uint8_t addr);     // Since sim_bmp280_add
+
+typedef enum {
+    SIM_BMP280_FAULT_NONE = 0,
+    SIM_BMP280_FAULT_SKIPPED,   // Data registers read 0x80000 (as after a brown-out)
+    SIM_BMP280_FAULT_SATURATED, // Pressure code pinned at full scale (adc_P = 0)
+    SIM_BMP280_FAULT_NAK,       // Part does not acknowledge its address
+    SIM_BMP280_FAULT_STUCK_SDA, // Part holds SDA low: every transfer times out
+} sim_bmp280_fault_t;
+
+/**
+ * @brief Inject a fault (NONE clears it)
+ * @param arg STUCK_SDA: SCL pulses that release the bus (0 = only clearing
+ *            the fault does); the fault then clears itself
+ */
+void sim_bmp280_set_fault(uint8_t addr, sim_bmp280_fault_t fault, uint32_t arg);
+sim_bmp280_fault_t sim_bmp280_fault(uint8_t addr);
+
+#endif // SIM_H
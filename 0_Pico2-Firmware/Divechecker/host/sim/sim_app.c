@@ -0,0 +1,97 @@
+/**
+ * @file sim_app.c
+ * @brief App side of the simulated USB-MIDI link for the host benches
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim_app.h"
+#include "sim.h"
+#include "midi_sysex.h"
+#include <string.h>
+
+static sim_frame_t g_frames[SIM_APP_MAX_FRAMES];
+static int g_frame_count = 0;
+static uint32_t g_msg_count[128];
+static uint8_t g_last_msg[128][SIM_APP_MSG_KEEP];
+static size_t g_last_len[128];
+static void (*g_listener)(const uint8_t *msg, size_t len);
+
+static int32_t decode_s32(const uint8_t *d) {
+    uint32_t mag = ((uint32_t)(d[0] & 0x0F) << 28) | ((uint32_t)d[1] << 21) |
+                   ((uint32_t)d[2] << 14) | ((uint32_t)d[3] << 7) | d[4];
+    return (d[0] & 0x40) ? -(int32_t)mag : (int32_t)mag;
+}
+
+void sim_app_reset(void) {
+    g_frame_count = 0;
+    memset(g_msg_count, 0, sizeof(g_msg_count));
+}
+
+void sim_app_run(uint64_t us) {
+    uint8_t msg[1024];
+    for (uint64_t t = 0; t < us && sim_halted() == SIM_RUNNING; t += 1000) {
+        sim_run_us(1000);
+        size_t len;
+        while ((len = sim_usb_recv(msg, sizeof(msg))) > 0) {
+            if (len < 5 || msg[1] != SYSEX_MANUFACTURER_ID || msg[2] != SYSEX_DEVICE_ID) continue;
+            uint8_t cmd = msg[3] & 0x7F;
+            if (g_listener != NULL) g_listener(msg, len);
+            g_msg_count[cmd]++;
+            g_last_len[cmd] = len < SIM_APP_MSG_KEEP ? len : SIM_APP_MSG_KEEP;
+            memcpy(g_last_msg[cmd], msg, g_last_len[cmd]);
+            if (g_frame_count >= SIM_APP_MAX_FRAMES) continue;
+            if (cmd == CMD_PRESSURE && len >= 10) {
+                g_frames[g_frame_count++] = (sim_frame_t){
+                    .t_us = sim_now_us(), .value_x1000 = decode_s32(&msg[4]),
+                };
+            } else if (cmd == CMD_PRESSURE_STATS && len >= 26) {
+                g_frames[g_frame_count++] = (sim_frame_t){
+                    sim_now_us(), decode_s32(&msg[4]), decode_s32(&msg[9]), decode_s32(&msg[14]),
+                    midi_sysex_decode_u32(&msg[19]), msg[24],
+                };
+            }
+        }
+    }
+}
+
+uint64_t sim_app_run_until(uint8_t cmd, uint64_t timeout_us) {
+    uint64_t start = sim_now_us();
+    uint32_t seen = g_msg_count[cmd];
+    while (g_msg_count[cmd] == seen && sim_now_us() - start < timeout_us &&
+           sim_halted() == SIM_RUNNING) {
+        sim_app_run(1000);
+    }
+    return g_msg_count[cmd] != seen ? sim_now_us() - start : SIM_APP_TIMEOUT;
+}
+
+void sim_app_send(uint8_t cmd, const uint8_t *data, size_t len) {
+    uint8_t msg[SIM_APP_MSG_KEEP + 5] = { SYSEX_START, SYSEX_MANUFACTURER_ID, SYSEX_DEVICE_ID, cmd };
+    if (len > SIM_APP_MSG_KEEP) len = SIM_APP_MSG_KEEP;
+    if (len > 0) memcpy(&msg[4], data, len);
+    msg[4 + len] = SYSEX_END;
+    sim_usb_send(msg, len + 5);
+}
+
+void sim_app_set_listener(void (*fn)(const uint8_t *msg, size_t len)) {
+    g_listener = fn;
+}
+
+int sim_app_frame_count(void) {
+    return g_frame_count;
+}
+
+const sim_frame_t *sim_app_frames(void) {
+    return g_frames;
+}
+
+uint32_t sim_app_msg_count(uint8_t cmd) {
+    return g_msg_count[cmd & 0x7F];
+}
+
+const uint8_t *sim_app_last_msg(uint8_t cmd, size_t *len) {
+    *len = g_last_len[cmd & 0x7F];
+    return g_last_msg[cmd & 0x7F];
+}
@@ -0,0 +1,70 @@
+/**
+ * @file sim_app.h
+ * @brief App side of the simulated USB-MIDI link for the host benches
+ *
+ * Runs the firmware in 1ms slices and collects what arrives the way the
+ * app sees it: every SysEx message is counted per command (the last one of
+ * each is kept) and Pressure frames are logged with their arrival time.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef SIM_APP_H
+#define SIM_APP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SIM_APP_MAX_FRAMES      65536
+#define SIM_APP_MSG_KEEP        128     // Bytes kept of the last message per command
+#define SIM_APP_TIMEOUT         UINT64_MAX
+
+typedef struct {
+    uint64_t t_us;              // Arrival at the host
+    int32_t value_x1000;        // Pressure delta, hPa x1000
+    // CMD_PRESSURE_STATS only (count 0 for CMD_PRESSURE)
+    int32_t min_x1000;
+    int32_t max_x1000;
+    uint32_t stddev_x1e6;       // hPa x1000000
+    uint8_t count;
+} sim_frame_t;
+
+/**
+ * @brief Forget collected frames and message counts
+ */
+void sim_app_reset(void);
+
+/**
+ * @brief Run the firmware for us, collecting what arrives
+ */
+void sim_app_run(uint64_t us);
+
+/**
+ * @brief Run until a message of cmd arrives
+ * @return Simulated microseconds it took, SIM_APP_TIMEOUT if none came
+ */
+uint64_t sim_app_run_until(uint8_t cmd, uint64_t timeout_us);
+
+/**
+ * @brief Send one command (F0 7D 01 cmd data F7)
+ */
+void sim_app_send(uint8_t cmd, const uint8_t *data, size_t len);
+
+/**
+ * @brief Also hand every arriving message (F0 ... F7) to fn, NULL to stop
+ */
+void sim_app_set_listener(void (*fn)(const uint8_t *msg, size_t len));
+
+int sim_app_frame_count(void);
+const sim_frame_t *sim_app_frames(void);
+uint32_t sim_app_msg_count(uint8_t cmd);
+
+/**
+ * @brief Last message of cmd (F0 ... F7, at most SIM_APP_MSG_KEEP bytes)
+ */
+const uint8_t *sim_app_last_msg(uint8_t cmd, size_t *len);
+
+#endif // SIM_APP_H
@@ -0,0 +1,441 @@
+/**
+ * @file sim_bmp280.c
+ * @brief Register-level BMP280 model on the simulated I2C bus
+ *
+ * Registers: chip ID (0xD0), soft reset (0xE0), status (0xF3), ctrl_meas
+ * (0xF4), config (0xF5), data (0xF7-0xFC) and the datasheet trimming block
+ * (0x88-0x9F). Writes are (register, value) pairs, reads auto-increment.
+ * Sleep, forced and normal modes run on the virtual clock with the
+ * datasheet typical measurement time plus t_sb; conversions are computed
+ * lazily when the part is accessed. Each conversion adds Gaussian noise
+ * (RMS / sqrt(oversampling)), runs the IIR filter on pressure, and is
+ * turned back into ADC codes by inverting the firmware's own compensation
+ * (bmp280_compensate.h), so the firmware reads back exactly the pressure
+ * the bench set, plus noise. Until the first conversion after reset the
+ * data registers hold 0x80000 (skipped), as on the part.
+ *
+ * Injected faults (sim_bmp280_set_fault): skipped conversions, a pressure
+ * code pinned at full scale, address NAK, and SDA held low until enough
+ * SCL pulses from the firmware's bus recovery (or the bench) release it.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim_sdk.h"
+#include "sim.h"
+#include "bmp280_compensate.h"
+#include "sensor_bus.h"         // I2C pin numbers
+#include <math.h>
+#include <string.h>
+
+#define SIM_BMP280_MAX          2
+#define ADC_SKIPPED             0x80000
+#define ADC_MAX                 0xFFFFF
+#define CATCH_UP_MAX            64      // Conversions replayed after a long gap
+
+// Trimming from the BMP280 datasheet example (section 8.2)
+static const int32_t k_trimming[12] = {
+    27504, 26435, -1000,                                        // T1..T3
+    36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,    // P1..P9
+};
+
+// t_sb (config[7:5]) in microseconds
+static const uint32_t k_standby_us[8] = {
+    500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000
+};
+
+static const uint8_t k_oversampling[8] = { 0, 1, 2, 4, 8, 16, 16, 16 };
+
+typedef struct {
+    bool attached;
+    bool present;
+    uint8_t addr;
+    uint8_t calib_raw[BMP280_CALIB_LEN];
+    bmp280_calib_t calib;
+
+    // Registers
+    uint8_t reg_ptr;
+    uint8_t ctrl_meas;
+    uint8_t config;
+    int32_t adc_P;
+    int32_t adc_T;
+
+    // Measurement engine
+    uint64_t next_done_us;      // Completion of the conversion in progress
+    bool filter_primed;
+    double filter_pa;
+    uint32_t conversions;
+    uint32_t soft_resets;       // 0xB6 written to the reset register
+
+    // Injected fault
+    sim_bmp280_fault_t fault;
+    uint32_t release_pulses;    // STUCK_SDA: SCL pulses still needed, 0 = never
+
+    // Environment
+    float pressure_hpa;
+    float temperature_c;
+    float noise_pa;
+    uint64_t rng;
+} bmp280_model_t;
+
+static bmp280_model_t g_dev[SIM_BMP280_MAX];
+static uint32_t g_baudrate = 400000;
+static uint32_t g_baud_peri_hz = 150000000;    // clk_peri the divider was set for
+static bool g_scl_bitbang = false;      // SCL under GPIO control (bus recovery)
+
+i2c_inst_t sim_i2c0 = { 0 };
+i2c_inst_t sim_i2c1 = { 1 };
+
+static bmp280_model_t *find(uint8_t addr) {
+    for (int i = 0; i < SIM_BMP280_MAX; i++) {
+        if (g_dev[i].attached && g_dev[i].addr == addr) return &g_dev[i];
+    }
+    return NULL;
+}
+
+static double gaussian(bmp280_model_t *d) {
+    // Box-Muller on a per-part xorshift stream: runs repeat exactly
+    double u[2];
+    for (int i = 0; i < 2; i++) {
+        d->rng ^= d->rng << 13;
+        d->rng ^= d->rng >> 7;
+        d->rng ^= d->rng << 17;
+        u[i] = ((double)(d->rng >> 11) + 1.0) / 9007199254740993.0;
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(6.283185307179586 * u[1]);
+}
+
+/* ============================================================================
+ * Compensation inverse (bisection on the firmware formula)
+ * ========================================================================== */
+
+static int32_t adc_t_for(const bmp280_model_t *d, float celsius) {
+    int32_t target = (int32_t)lroundf(celsius * 100.0f);
+    int32_t lo = 0, hi = ADC_MAX;   // t_fine rises with adc_T
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        if (bmp280_t_fine_to_x100(bmp280_compensate_t_fine(&d->calib, mid)) < target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int32_t adc_p_for(const bmp280_model_t *d, double pa, int32_t t_fine) {
+    double target = pa * 256.0;
+    int32_t lo = 0, hi = ADC_MAX;   // Pressure falls as adc_P rises
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        if ((double)bmp280_compensate_p_q24_8(&d->calib, mid, t_fine) > target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* ============================================================================
+ * Measurement engine
+ * ========================================================================== */
+
+static inline uint8_t mode(const bmp280_model_t *d) {
+    return d->ctrl_meas & 0x03;     // 0 sleep, 1/2 forced, 3 normal
+}
+
+/**
+ * @brief Datasheet typical measurement time (section 3.8.1)
+ */
+static uint32_t t_meas_us(const bmp280_model_t *d) {
+    uint32_t os_t = k_oversampling[(d->ctrl_meas >> 5) & 0x07];
+    uint32_t os_p = k_oversampling[(d->ctrl_meas >> 2) & 0x07];
+    uint32_t t_us = 1000 + 2000 * os_t;
+    if (os_p > 0) t_us += 2000 * os_p + 500;
+    return t_us;
+}
+
+static uint32_t period_us(const bmp280_model_t *d) {
+    return t_meas_us(d) + k_standby_us[(d->config >> 5) & 0x07];
+}
+
+static void convert(bmp280_model_t *d) {
+    uint32_t os_t = k_oversampling[(d->ctrl_meas >> 5) & 0x07];
+    uint32_t os_p = k_oversampling[(d->ctrl_meas >> 2) & 0x07];
+    d->conversions++;
+
+    d->adc_T = os_t ? adc_t_for(d, d->temperature_c) : ADC_SKIPPED;
+    if (os_p == 0 || os_t == 0) {
+        d->adc_P = ADC_SKIPPED;
+        return;
+    }
+
+    double pa = d->pressure_hpa * 100.0 + gaussian(d) * d->noise_pa / sqrt((double)os_p);
+    uint8_t filter = (d->config >> 2) & 0x07;
+    if (filter > 4) filter = 4;
+    if (filter == 0 || !d->filter_primed) {
+        d->filter_pa = pa;
+        d->filter_primed = true;
+    } else {
+        double c = (double)(1u << filter);
+        d->filter_pa += (pa - d->filter_pa) / c;
+    }
+
+    int32_t adc_P = adc_p_for(d, d->filter_pa, bmp280_compensate_t_fine(&d->calib, d->adc_T));
+    // Resolution: 16 bits at x1, one more per oversampling step, 20 with the filter
+    uint32_t osrs = (d->ctrl_meas >> 2) & 0x07;
+    uint32_t drop = (filter == 0 && osrs < 5) ? 5 - osrs : 0;
+    d->adc_P = adc_P & ~((1 << drop) - 1);
+}
+
+/**
+ * @brief Run every conversion that has completed by now
+ */
+static void advance(bmp280_model_t *d) {
+    uint64_t now = time_us_64();
+    if (mode(d) == 0 || now < d->next_done_us) return;
+
+    if (mode(d) != 3) {             // Forced: one conversion, then sleep
+        convert(d);
+        d->ctrl_meas &= (uint8_t)~0x03;
+        return;
+    }
+    uint32_t period = period_us(d);
+    uint64_t pending = (now - d->next_done_us) / period + 1;
+    if (pending > CATCH_UP_MAX) {   // Only the filter's memory matters
+        d->conversions += (uint32_t)(pending - CATCH_UP_MAX);
+        d->next_done_us += (pending - CATCH_UP_MAX) * period;
+    }
+    while (now >= d->next_done_us) {
+        convert(d);
+        d->next_done_us += period;
+    }
+}
+
+static void soft_reset(bmp280_model_t *d) {
+    d->ctrl_meas = 0;
+    d->config = 0;
+    d->adc_P = ADC_SKIPPED;
+    d->adc_T = ADC_SKIPPED;
+    d->filter_primed = false;
+}
+
+static void write_reg(bmp280_model_t *d, uint8_t reg, uint8_t value) {
+    switch (reg) {
+        case 0xE0:
+            if (value == 0xB6) {
+                soft_reset(d);
+                d->soft_resets++;
+            }
+            break;
+        case 0xF4:
+            d->ctrl_meas = value;
+            if (mode(d) != 0) {
+                d->next_done_us = time_us_64() + t_meas_us(d);
+            }
+            break;
+        case 0xF5:
+            // Writes in normal mode may be ignored (datasheet 5.4.6)
+            if (mode(d) == 0) d->config = value;
+            break;
+        default:
+            break;
+    }
+}
+
+static uint8_t read_reg(const bmp280_model_t *d, uint8_t reg) {
+    if (reg >= 0x88 && reg < 0x88 + BMP280_CALIB_LEN) return d->calib_raw[reg - 0x88];
+    int32_t adc_P = d->adc_P;
+    int32_t adc_T = d->adc_T;
+    if (d->fault == SIM_BMP280_FAULT_SKIPPED) {
+        adc_P = ADC_SKIPPED;
+        adc_T = ADC_SKIPPED;
+    } else if (d->fault == SIM_BMP280_FAULT_SATURATED && adc_P != ADC_SKIPPED) {
+        adc_P = 0;
+    }
+    switch (reg) {
+        case 0xD0: return 0x58;
+        case 0xF3: return (mode(d) != 0 && d->next_done_us - time_us_64() < t_meas_us(d)) ? 0x08 : 0x00;
+        case 0xF4: return d->ctrl_meas;
+        case 0xF5: return d->config;
+        case 0xF7: return (uint8_t)(adc_P >> 12);
+        case 0xF8: return (uint8_t)(adc_P >> 4);
+        case 0xF9: return (uint8_t)((adc_P & 0x0F) << 4);
+        case 0xFA: return (uint8_t)(adc_T >> 12);
+        case 0xFB: return (uint8_t)(adc_T >> 4);
+        case 0xFC: return (uint8_t)((adc_T & 0x0F) << 4);
+        default:   return 0x00;
+    }
+}
+
+/* ============================================================================
+ * I2C bus
+ * ========================================================================== */
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    (void)i2c;
+    g_baudrate = baudrate;
+    g_baud_peri_hz = clock_get_hz(clk_peri);
+    return baudrate;
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    return i2c_init(i2c, baudrate);
+}
+
+static bmp280_model_t *stuck_device(void) {
+    for (int i = 0; i < SIM_BMP280_MAX; i++) {
+        if (g_dev[i].attached && g_dev[i].fault == SIM_BMP280_FAULT_STUCK_SDA) return &g_dev[i];
+    }
+    return NULL;
+}
+
+static inline bool acks(const bmp280_model_t *d) {
+    return d != NULL && d->present && d->fault != SIM_BMP280_FAULT_NAK;
+}
+
+void gpio_set_function(uint gpio, int fn) {
+    if (gpio == I2C_SCL_PIN) g_scl_bitbang = (fn == GPIO_FUNC_SIO);
+}
+
+bool gpio_get(uint gpio) {
+    if (gpio == I2C_SDA_PIN && stuck_device() != NULL) return false;
+    return true;                    // Pulled up
+}
+
+void gpio_put(uint gpio, bool value) {
+    if (gpio != I2C_SCL_PIN || !value || !g_scl_bitbang) return;
+    // Each clock lets the part shift out one more bit of the byte it is stuck in
+    bmp280_model_t *d = stuck_device();
+    if (d != NULL && d->release_pulses > 0 && --d->release_pulses == 0) {
+        d->fault = SIM_BMP280_FAULT_NONE;
+    }
+}
+
+/**
+ * @brief Bus time for the address byte plus len data bytes (9 clocks each)
+ */
+static void bus_time(size_t len) {
+    // The divider was set for clk_peri at the time: stale after a clock change
+    uint64_t baud = (uint64_t)g_baudrate * clock_get_hz(clk_peri) / g_baud_peri_hz;
+    sleep_us(((uint64_t)(len + 1) * 9 * 1000000 + baud - 1) / baud);
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len,
+                         bool nostop, uint timeout_us) {
+    (void)i2c; (void)nostop;
+    if (stuck_device() != NULL) {
+        sleep_us(timeout_us);       // No START condition with SDA held low
+        return PICO_ERROR_TIMEOUT;
+    }
+    bmp280_model_t *d = find(addr);
+    if (!acks(d)) {
+        bus_time(0);                // Address NAK
+        return PICO_ERROR_GENERIC;
+    }
+    bus_time(len);
+    advance(d);
+    if (len == 1) d->reg_ptr = src[0];     // Pointer for the following read
+    for (size_t i = 0; i + 1 < len; i += 2) {
+        write_reg(d, src[i], src[i + 1]);
+    }
+    return (int)len;
+}
+
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len,
+                        bool nostop, uint timeout_us) {
+    (void)i2c; (void)nostop;
+    if (stuck_device() != NULL) {
+        sleep_us(timeout_us);
+        return PICO_ERROR_TIMEOUT;
+    }
+    bmp280_model_t *d = find(addr);
+    if (!acks(d)) {
+        bus_time(0);
+        return PICO_ERROR_GENERIC;
+    }
+    advance(d);                     // Data is latched at the start of a burst
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = read_reg(d, (uint8_t)(d->reg_ptr + i));
+    }
+    d->reg_ptr = (uint8_t)(d->reg_ptr + len);
+    bus_time(len);
+    return (int)len;
+}
+
+/* ============================================================================
+ * Bench control
+ * ========================================================================== */
+
+void sim_bmp280_add(uint8_t addr) {
+    bmp280_model_t *d = find(addr);
+    for (int i = 0; d == NULL && i < SIM_BMP280_MAX; i++) {
+        if (!g_dev[i].attached) d = &g_dev[i];
+    }
+    if (d == NULL) return;
+
+    memset(d, 0, sizeof(*d));
+    d->attached = true;
+    d->present = true;
+    d->addr = addr;
+    for (int i = 0; i < 12; i++) {
+        d->calib_raw[2 * i] = (uint8_t)(k_trimming[i] & 0xFF);
+        d->calib_raw[2 * i + 1] = (uint8_t)((k_trimming[i] >> 8) & 0xFF);
+    }
+    bmp280_parse_calib(d->calib_raw, &d->calib);
+    soft_reset(d);
+    d->pressure_hpa = 1013.25f;
+    d->temperature_c = 25.0f;
+    d->noise_pa = 1.3f;
+    d->rng = 0x2545F4914F6CDD1Dull ^ addr;
+}
+
+void sim_bmp280_set_present(uint8_t addr, bool present) {
+    bmp280_model_t *d = find(addr);
+    if (d != NULL) d->present = present;
+}
+
+void sim_bmp280_set_pressure(uint8_t addr, float hpa) {
+    bmp280_model_t *d = find(addr);
+    if (d == NULL) return;
+    advance(d);                     // Earlier conversions saw the old value
+    d->pressure_hpa = hpa;
+}
+
+void sim_bmp280_set_temperature(uint8_t addr, float celsius) {
+    bmp280_model_t *d = find(addr);
+    if (d == NULL) return;
+    advance(d);
+    d->temperature_c = celsius;
+}
+
+void sim_bmp280_set_noise(uint8_t addr, float pa_rms) {
+    bmp280_model_t *d = find(addr);
+    if (d != NULL) d->noise_pa = pa_rms;
+}
+
+uint32_t sim_bmp280_conversions(uint8_t addr) {
+    bmp280_model_t *d = find(addr);
+    return d != NULL ? d->conversions : 0;
+}
+
+uint32_t sim_bmp280_soft_resets(uint8_t addr) {
+    bmp280_model_t *d = find(addr);
+    return d != NULL ? d->soft_resets : 0;
+}
+
+void sim_bmp280_set_fault(uint8_t addr, sim_bmp280_fault_t fault, uint32_t arg) {
+    bmp280_model_t *d = find(addr);
+    if (d == NULL) return;
+    advance(d);
+    d->fault = fault;
+    d->release_pulses = (fault == SIM_BMP280_FAULT_STUCK_SDA) ? arg : 0;
+}
+
+sim_bmp280_fault_t sim_bmp280_fault(uint8_t addr) {
+    bmp280_model_t *d = find(addr);
+    return d != NULL ? d->fault : SIM_BMP280_FAULT_NONE;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file sim_dma.c
+ * @brief Memory-to-memory DMA and the sniffer's CRC-32 modes
+ *
+ * A triggered transfer runs to completion inside dma_channel_configure()
+ * (no simulated time; at one transfer per clk_sys cycle it would be
+ * microseconds at most). The sniffer follows the RP2350 datasheet: CRC32
+ * shifts each byte into an MSB-first IEEE 802.3 register, CRC32R reverses
+ * the bits of each byte first, and output reverse / invert apply only when
+ * the accumulator is read. Wider transfers feed their bytes LSB first.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim_sdk.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t g_claimed = 0;
+
+static struct {
+    bool enabled;
+    uint channel;
+    uint mode;
+    bool out_rev;
+    bool out_inv;
+    uint32_t data;
+} g_sniff;
+
+static uint32_t bitrev32(uint32_t v) {
+    uint32_t r = 0;
+    for (int i = 0; i < 32; i++) {
+        r = (r << 1) | ((v >> i) & 1);
+    }
+    return r;
+}
+
+static void sniff_byte(uint8_t b) {
+    if (g_sniff.mode == DMA_SNIFF_CTRL_CALC_VALUE_CRC32R) {
+        b = (uint8_t)(bitrev32(b) >> 24);
+    } else if (g_sniff.mode != DMA_SNIFF_CTRL_CALC_VALUE_CRC32) {
+        fprintf(stderr, "sim: sniffer mode %u not modelled\n", g_sniff.mode);
+        abort();
+    }
+    g_sniff.data ^= (uint32_t)b << 24;
+    for (int i = 0; i < 8; i++) {
+        g_sniff.data = (g_sniff.data & 0x80000000u) ? (g_sniff.data << 1) ^ 0x04C11DB7u
+                                                    : (g_sniff.data << 1);
+    }
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (int ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!(g_claimed & (1u << ch))) {
+            g_claimed |= 1u << ch;
+            return ch;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "sim: no free DMA channel\n");
+        abort();
+    }
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    return (dma_channel_config){ DMA_SIZE_32, true, false, false };
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config,
+                           volatile void *write_addr, const volatile void *read_addr,
+                           uint transfer_count, bool trigger) {
+    if (!trigger) return;
+    size_t width = 1u << config->size;
+    const volatile uint8_t *src = read_addr;
+    volatile uint8_t *dst = write_addr;
+    bool sniff = g_sniff.enabled && g_sniff.channel == channel && config->sniff;
+    for (uint n = 0; n < transfer_count; n++) {
+        for (size_t k = 0; k < width; k++) {
+            dst[k] = src[k];
+            if (sniff) sniff_byte(src[k]);
+        }
+        if (config->read_increment) src += width;
+        if (config->write_increment) dst += width;
+    }
+}
+
+void dma_sniffer_enable(uint channel, uint mode, bool force_channel_enable) {
+    (void)force_channel_enable;
+    g_sniff.enabled = true;
+    g_sniff.channel = channel;
+    g_sniff.mode = mode;
+}
+
+void dma_sniffer_disable(void) {
+    uint32_t data = g_sniff.data;       // SNIFF_CTRL is cleared, SNIFF_DATA is not
+    memset(&g_sniff, 0, sizeof(g_sniff));
+    g_sniff.data = data;
+}
+
+void dma_sniffer_set_data_accumulator(uint32_t seed_value) {
+    g_sniff.data = seed_value;
+}
+
+uint32_t dma_sniffer_get_data_accumulator(void) {
+    uint32_t v = g_sniff.out_rev ? bitrev32(g_sniff.data) : g_sniff.data;
+    return g_sniff.out_inv ? ~v : v;
+}
+
+void dma_sniffer_set_output_reverse_enabled(bool enable) {
+    g_sniff.out_rev = enable;
+}
+
+void dma_sniffer_set_output_invert_enabled(bool enable) {
+    g_sniff.out_inv = enable;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file sim_flash.c
+ * @brief Fake QSPI flash mapped at the real XIP address
+ *
+ * The firmware reads flash through XIP pointers (XIP_BASE + offset) and
+ * sizes the recorder region from &__flash_binary_end, so the image is
+ * mapped at 0x10000000 exactly (the executable is linked non-PIE with
+ * __flash_binary_end defined by the linker, see host/CMakeLists.txt).
+ * Program only clears bits, like NOR flash; erase and program stall both
+ * cores for the typical W25Q-class times.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim_sdk.h"
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+#define SIM_FLASH_ERASE_US      45000   // 4KB sector erase, typical
+#define SIM_FLASH_PROGRAM_US    700     // 256B page program, typical
+
+static uint8_t *g_flash = NULL;
+static sim_flash_stats_t g_stats;
+
+void sim_flash_init(void) {
+    void *p = mmap((void *)(uintptr_t)XIP_BASE, PICO_FLASH_SIZE_BYTES,
+                   PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                   -1, 0);
+    if (p != (void *)(uintptr_t)XIP_BASE) {
+        fprintf(stderr, "sim: cannot map flash at 0x%08lX\n", (unsigned long)XIP_BASE);
+        exit(1);
+    }
+    g_flash = p;
+    memset(g_flash, 0xFF, PICO_FLASH_SIZE_BYTES);
+}
+
+void sim_flash_get_stats(sim_flash_stats_t *stats) {
+    *stats = g_stats;
+}
+
+static void check_range(uint32_t offs, size_t count, uint32_t align) {
+    if (g_flash == NULL || (offs % align) != 0 || (count % align) != 0 ||
+        offs + count > PICO_FLASH_SIZE_BYTES) {
+        fprintf(stderr, "sim: bad flash access 0x%08X+%zu\n", offs, count);
+        abort();
+    }
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    check_range(flash_offs, count, FLASH_SECTOR_SIZE);
+    memset(g_flash + flash_offs, 0xFF, count);
+    uint32_t sectors = (uint32_t)(count / FLASH_SECTOR_SIZE);
+    g_stats.sector_erases += sectors;
+    g_stats.busy_us += (uint64_t)sectors * SIM_FLASH_ERASE_US;
+    sim_stall_us((uint64_t)sectors * SIM_FLASH_ERASE_US);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    check_range(flash_offs, count, FLASH_PAGE_SIZE);
+    for (size_t i = 0; i < count; i++) {
+        g_flash[flash_offs + i] &= data[i];
+    }
+    uint32_t pages = (uint32_t)(count / FLASH_PAGE_SIZE);
+    g_stats.page_programs += pages;
+    g_stats.busy_us += (uint64_t)pages * SIM_FLASH_PROGRAM_US;
+    sim_stall_us((uint64_t)pages * SIM_FLASH_PROGRAM_US);
+}
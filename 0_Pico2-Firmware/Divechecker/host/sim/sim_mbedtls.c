@@ -0,0 +1,68 @@
+/**
+ * @file sim_mbedtls.c
+ * @brief mbedtls link stubs: every operation fails
+ *
+ * The simulator builds with the placeholder (all-zero) keys, so
+ * ecdsa_init() gives up before touching mbedtls and the auth commands
+ * answer "error", exactly as an unprovisioned board does. These only have
+ * to link.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim_sdk.h"
+#include <string.h>
+
+#define SIM_MBEDTLS_ERR     (-1)
+
+void mbedtls_ecdsa_init(mbedtls_ecdsa_context *ctx) { (void)ctx; }
+void mbedtls_ecdsa_free(mbedtls_ecdsa_context *ctx) { (void)ctx; }
+void mbedtls_ctr_drbg_init(mbedtls_ctr_drbg_context *ctx) { (void)ctx; }
+void mbedtls_ctr_drbg_free(mbedtls_ctr_drbg_context *ctx) { (void)ctx; }
+
+int mbedtls_ctr_drbg_seed(mbedtls_ctr_drbg_context *ctx,
+                          int (*f_entropy)(void *, unsigned char *, size_t), void *p_entropy,
+                          const unsigned char *custom, size_t len) {
+    (void)ctx; (void)f_entropy; (void)p_entropy; (void)custom; (void)len;
+    return SIM_MBEDTLS_ERR;
+}
+
+int mbedtls_ctr_drbg_random(void *p_rng, unsigned char *output, size_t output_len) {
+    (void)p_rng; (void)output; (void)output_len;
+    return SIM_MBEDTLS_ERR;
+}
+
+int mbedtls_ecp_read_key(int grp_id, mbedtls_ecdsa_context *key, const unsigned char *buf,
+                         size_t buflen) {
+    (void)grp_id; (void)key; (void)buf; (void)buflen;
+    return SIM_MBEDTLS_ERR;
+}
+
+int mbedtls_ecp_keypair_calc_public(mbedtls_ecdsa_context *key,
+                                    int (*f_rng)(void *, unsigned char *, size_t), void *p_rng) {
+    (void)key; (void)f_rng; (void)p_rng;
+    return SIM_MBEDTLS_ERR;
+}
+
+int mbedtls_ecdsa_write_signature(mbedtls_ecdsa_context *ctx, int md_alg,
+                                  const unsigned char *hash, size_t hlen,
+                                  unsigned char *sig, size_t sig_size, size_t *slen,
+                                  int (*f_rng)(void *, unsigned char *, size_t), void *p_rng) {
+    (void)ctx; (void)md_alg; (void)hash; (void)hlen; (void)sig; (void)sig_size;
+    (void)f_rng; (void)p_rng;
+    *slen = 0;
+    return SIM_MBEDTLS_ERR;
+}
+
+int mbedtls_sha256(const unsigned char *input, size_t ilen, unsigned char *output, int is224) {
+    (void)input; (void)ilen; (void)is224;
+    memset(output, 0, 32);
+    return SIM_MBEDTLS_ERR;
+}
+
+void mbedtls_platform_zeroize(void *buf, size_t len) {
+    volatile unsigned char *p = buf;
+    while (len--) *p++ = 0;
+}
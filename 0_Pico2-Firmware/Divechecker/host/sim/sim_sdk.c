@@ -0,0 +1,410 @@
+/**
+ * @file sim_sdk.c
+ * @brief Virtual-clock scheduler and the core Pico SDK calls (time, cores,
+ *        queues, mutexes, watchdog, identity)
+ *
+ * Each participant (core 0, core 1, bench) is a thread that runs only while
+ * it holds the clock. Waiting hands the clock to the participant with the
+ * earliest wake time (ties go to the others first, so two cores polling
+ * each other both progress) and advances the simulated time to it. Code
+ * between waits takes no simulated time except for SIM_TIME_READ_NS per
+ * clock read, which keeps a spin on time_us_64() finite.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim_sdk.h"
+#include "sim.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_TIME_READ_NS        50      // Cost of one clock read
+#define SIM_POLL_US             2       // Mutex / FIFO wait poll interval
+#define SIM_FIFO_DEPTH          8       // Inter-core FIFO (RP2350: 8 words)
+
+enum { P_CORE0, P_CORE1, P_BENCH, P_COUNT };
+
+typedef struct {
+    bool active;
+    uint64_t wake_ns;
+    pthread_cond_t cv;
+} participant_t;
+
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static participant_t g_part[P_COUNT] = {
+    [P_CORE0] = { .cv = PTHREAD_COND_INITIALIZER },
+    [P_CORE1] = { .cv = PTHREAD_COND_INITIALIZER },
+    [P_BENCH] = { .active = true, .cv = PTHREAD_COND_INITIALIZER },
+};
+static int g_running = P_BENCH;
+static uint64_t g_now_ns = 0;
+static uint64_t g_switches = 0;
+static sim_halt_t g_halt = SIM_RUNNING;
+static __thread int t_self = P_BENCH;
+
+// Watchdog (one counter fed by both cores, as on the chip)
+static bool g_wd_enabled = false;
+static uint64_t g_wd_timeout_ns = 0;
+static uint64_t g_wd_deadline_ns = 0;
+
+/* ============================================================================
+ * Scheduler
+ * ========================================================================== */
+
+static void halt_locked(sim_halt_t reason) {
+    if (g_halt == SIM_RUNNING) g_halt = reason;
+    g_part[P_CORE0].active = false;
+    g_part[P_CORE1].active = false;
+}
+
+static int pick_next_locked(void) {
+    int next = -1;
+    for (int k = 1; k <= P_COUNT; k++) {    // Self last: ties go to the others
+        int i = (t_self + k) % P_COUNT;
+        if (!g_part[i].active) continue;
+        if (next < 0 || g_part[i].wake_ns < g_part[next].wake_ns) next = i;
+    }
+    return next;
+}
+
+/**
+ * @brief Hand the clock over until wake_ns (caller must not hold g_lock)
+ */
+static void yield_until(uint64_t wake_ns) {
+    pthread_mutex_lock(&g_lock);
+    g_part[t_self].wake_ns = wake_ns;
+
+    int next = pick_next_locked();
+    if (g_wd_enabled && g_halt == SIM_RUNNING) {
+        uint64_t target = g_part[next].wake_ns > g_now_ns ? g_part[next].wake_ns : g_now_ns;
+        if (target > g_wd_deadline_ns) {
+            g_now_ns = g_wd_deadline_ns > g_now_ns ? g_wd_deadline_ns : g_now_ns;
+            halt_locked(SIM_HALT_WATCHDOG);
+            next = pick_next_locked();
+        }
+    }
+    if (g_part[next].wake_ns > g_now_ns) g_now_ns = g_part[next].wake_ns;
+
+    if (next != t_self) {
+        g_switches++;
+        g_running = next;
+        pthread_cond_signal(&g_part[next].cv);
+        while (g_running != t_self) {
+            pthread_cond_wait(&g_part[t_self].cv, &g_lock);
+        }
+    }
+    pthread_mutex_unlock(&g_lock);
+}
+
+typedef struct {
+    int self;
+    void (*entry)(void);
+    int (*main)(void);
+} thread_start_t;
+
+static void *participant_thread(void *arg) {
+    thread_start_t start = *(thread_start_t *)arg;
+    free(arg);
+    t_self = start.self;
+
+    pthread_mutex_lock(&g_lock);
+    while (g_running != t_self) {
+        pthread_cond_wait(&g_part[t_self].cv, &g_lock);
+    }
+    pthread_mutex_unlock(&g_lock);
+
+    if (start.main != NULL) {
+        start.main();
+    } else {
+        start.entry();
+    }
+    // Firmware entry points never return; park like a halted core
+    pthread_mutex_lock(&g_lock);
+    g_part[t_self].active = false;
+    pthread_mutex_unlock(&g_lock);
+    yield_until(UINT64_MAX);
+    return NULL;
+}
+
+static void start_participant(int self, void (*entry)(void), int (*main_fn)(void)) {
+    thread_start_t *start = malloc(sizeof(*start));
+    if (start == NULL) abort();
+    *start = (thread_start_t){ .self = self, .entry = entry, .main = main_fn };
+
+    pthread_mutex_lock(&g_lock);
+    g_part[self].active = true;
+    g_part[self].wake_ns = g_now_ns;
+    pthread_mutex_unlock(&g_lock);
+
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, participant_thread, start) != 0) abort();
+    pthread_detach(thread);
+}
+
+/**
+ * @brief Stop both cores; a core calling this never returns
+ */
+static void halt(sim_halt_t reason) {
+    pthread_mutex_lock(&g_lock);
+    halt_locked(reason);
+    pthread_mutex_unlock(&g_lock);
+    yield_until(UINT64_MAX);
+}
+
+void sim_boot(int (*firmware_main)(void)) {
+    start_participant(P_CORE0, NULL, firmware_main);
+}
+
+void sim_run_us(uint64_t us) {
+    yield_until(g_now_ns + us * 1000);
+}
+
+uint64_t sim_now_us(void) {
+    return g_now_ns / 1000;
+}
+
+sim_halt_t sim_halted(void) {
+    return g_halt;
+}
+
+const char *sim_halt_name(sim_halt_t halt) {
+    switch (halt) {
+        case SIM_RUNNING:       return "running";
+        case SIM_HALT_WATCHDOG: return "watchdog expired";
+        case SIM_HALT_REBOOT:   return "watchdog reboot";
+        case SIM_HALT_BOOTSEL:  return "BOOTSEL reset";
+    }
+    return "?";
+}
+
+uint64_t sim_context_switches(void) {
+    return g_switches;
+}
+
+/**
+ * @brief Advance the clock without handing it over (flash stalls both cores)
+ */
+void sim_stall_us(uint64_t us) {
+    g_now_ns += us * 1000;
+}
+
+/* ============================================================================
+ * Time
+ * ========================================================================== */
+
+uint64_t time_us_64(void) {
+    g_now_ns += SIM_TIME_READ_NS;
+    return g_now_ns / 1000;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+void sleep_us(uint64_t us) {
+    yield_until(g_now_ns + us * 1000);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000);
+}
+
+/* ============================================================================
+ * Cores, FIFO, lockout
+ * ========================================================================== */
+
+typedef struct {
+    uint32_t data[SIM_FIFO_DEPTH];
+    uint rd;
+    uint level;
+} fifo_t;
+
+static fifo_t g_fifo[2];                // Indexed by receiving core
+static bool g_lockout_victim[2];
+
+uint get_core_num(void) {
+    return t_self == P_CORE1 ? 1 : 0;
+}
+
+void multicore_launch_core1(void (*entry)(void)) {
+    start_participant(P_CORE1, entry, NULL);
+}
+
+void multicore_fifo_push_blocking(uint32_t data) {
+    fifo_t *f = &g_fifo[get_core_num() ^ 1];
+    while (f->level == SIM_FIFO_DEPTH) {
+        sleep_us(SIM_POLL_US);
+    }
+    f->data[(f->rd + f->level) % SIM_FIFO_DEPTH] = data;
+    f->level++;
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    fifo_t *f = &g_fifo[get_core_num()];
+    while (f->level == 0) {
+        sleep_us(SIM_POLL_US);
+    }
+    uint32_t data = f->data[f->rd];
+    f->rd = (f->rd + 1) % SIM_FIFO_DEPTH;
+    f->level--;
+    return data;
+}
+
+void multicore_lockout_victim_init(void) {
+    g_lockout_victim[get_core_num()] = true;
+}
+
+bool multicore_lockout_victim_is_initialized(uint core_num) {
+    return core_num < 2 && g_lockout_victim[core_num];
+}
+
+// Nothing to do: only one core runs at a time and flash operations advance
+// the clock without handing it over, so the other core is parked already
+void multicore_lockout_start_blocking(void) {}
+void multicore_lockout_end_blocking(void) {}
+
+/* ============================================================================
+ * Queues and mutexes
+ * ========================================================================== */
+
+void queue_init(queue_t *q, uint element_size, uint element_count) {
+    q->data = calloc(element_count, element_size);
+    if (q->data == NULL) abort();
+    q->element_size = element_size;
+    q->element_count = element_count;
+    q->rd = 0;
+    q->level = 0;
+}
+
+bool queue_try_add(queue_t *q, const void *data) {
+    if (q->level == q->element_count) return false;
+    uint wr = (q->rd + q->level) % q->element_count;
+    memcpy(q->data + (size_t)wr * q->element_size, data, q->element_size);
+    q->level++;
+    return true;
+}
+
+bool queue_try_remove(queue_t *q, void *data) {
+    if (q->level == 0) return false;
+    memcpy(data, q->data + (size_t)q->rd * q->element_size, q->element_size);
+    q->rd = (q->rd + 1) % q->element_count;
+    q->level--;
+    return true;
+}
+
+uint queue_get_level(queue_t *q) {
+    return q->level;
+}
+
+void mutex_init(mutex_t *mtx) {
+    mtx->owner = -1;
+}
+
+void mutex_enter_blocking(mutex_t *mtx) {
+    while (mtx->owner >= 0 && mtx->owner != t_self) {
+        sleep_us(SIM_POLL_US);
+    }
+    mtx->owner = t_self;
+}
+
+void mutex_exit(mutex_t *mtx) {
+    mtx->owner = -1;
+}
+
+/* ============================================================================
+ * Watchdog, reset, identity, entropy, clocks, PIO
+ * ========================================================================== */
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug) {
+    (void)pause_on_debug;
+    g_wd_timeout_ns = (uint64_t)delay_ms * 1000000;
+    g_wd_deadline_ns = g_now_ns + g_wd_timeout_ns;
+    g_wd_enabled = true;
+}
+
+void watchdog_disable(void) {
+    g_wd_enabled = false;
+}
+
+void watchdog_update(void) {
+    g_wd_deadline_ns = g_now_ns + g_wd_timeout_ns;
+}
+
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms) {
+    (void)pc; (void)sp; (void)delay_ms;
+    halt(SIM_HALT_REBOOT);
+}
+
+void reset_usb_boot(uint32_t gpio_activity_pin_mask, uint32_t disable_interface_mask) {
+    (void)gpio_activity_pin_mask; (void)disable_interface_mask;
+    halt(SIM_HALT_BOOTSEL);
+}
+
+void pico_get_unique_board_id(pico_unique_board_id_t *id) {
+    static const uint8_t k_id[PICO_UNIQUE_BOARD_ID_SIZE_BYTES] = {
+        0xE6, 0x61, 0x38, 0x52, 0x83, 0x4C, 0x2A, 0x2F
+    };
+    memcpy(id->id, k_id, sizeof(k_id));
+}
+
+uint32_t get_rand_32(void) {
+    static uint64_t state = 0x9E3779B97F4A7C15ull;  // Fixed seed: runs repeat
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (uint32_t)(state >> 32);
+}
+
+static uint32_t g_sys_hz = 150000000;
+static uint32_t g_peri_hz = 150000000;
+
+bool clock_configure(enum clock_index clk, uint32_t src, uint32_t auxsrc,
+                     uint32_t src_freq, uint32_t freq) {
+    (void)src; (void)auxsrc;
+    if (freq > src_freq) return false;
+    if (clk == clk_sys) g_sys_hz = freq;
+    if (clk == clk_peri) g_peri_hz = freq;
+    return true;
+}
+
+void clock_configure_undivided(enum clock_index clk, uint32_t src, uint32_t auxsrc,
+                               uint32_t src_freq) {
+    clock_configure(clk, src, auxsrc, src_freq, src_freq);
+}
+
+uint32_t clock_get_hz(enum clock_index clk) {
+    switch (clk) {
+        case clk_sys:   return g_sys_hz;
+        case clk_peri:  return g_peri_hz;
+        case clk_usb:   return 48000000;
+        case clk_adc:   return 48000000;
+        default:        return 12000000;
+    }
+}
+
+struct sim_pio { uint8_t sm_claimed; };
+struct sim_pio sim_pio0, sim_pio1;
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program) {
+    (void)pio; (void)program;
+    return true;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    (void)pio; (void)program;
+    return 0;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    for (int sm = 0; sm < 4; sm++) {
+        if (!(pio->sm_claimed & (1u << sm))) {
+            pio->sm_claimed |= (uint8_t)(1u << sm);
+            return sm;
+        }
+    }
+    if (required) abort();
+    return -1;
+}
@@ -0,0 +1,309 @@
+/**
+ * @file sim_sdk.h
+ * @brief Host stand-in for the Pico SDK / TinyUSB / mbedtls API subset the
+ *        firmware uses
+ *
+ * Every SDK header path the firmware includes (pico/stdlib.h,
+ * hardware/i2c.h, tusb.h, ...) is a one-line file under include/ that
+ * pulls in this header, so the firmware sources compile unchanged. The
+ * SDK call surface is the HAL: sim_sdk.c backs time, cores, queues and
+ * mutexes with a virtual clock; sim_bmp280.c puts a register-level sensor
+ * on the I2C bus; sim_flash.c maps a fake flash at XIP_BASE; sim_usb.c is
+ * the USB-MIDI pipe; sim_dma.c runs memory-to-memory DMA with the sniffer.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef SIM_SDK_H
+#define SIM_SDK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef unsigned int uint;
+
+/* ============================================================================
+ * Compiler / platform
+ * ========================================================================== */
+
+#define PICO_ON_DEVICE          0       // As the SDK's host platform
+#define __not_in_flash_func(f)  f
+#define __time_critical_func(f) f
+
+#define PICO_ERROR_GENERIC      (-1)
+#define PICO_ERROR_TIMEOUT      (-2)
+
+#define NUM_BANK0_GPIOS         48
+#define PICO_FLASH_SIZE_BYTES   (4 * 1024 * 1024)
+
+/* ============================================================================
+ * Time (virtual clock, sim_sdk.c)
+ * ========================================================================== */
+
+typedef uint64_t absolute_time_t;
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + (uint64_t)ms * 1000; }
+static inline bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+
+/* ============================================================================
+ * Sync, cores, queues, mutexes (sim_sdk.c)
+ * ========================================================================== */
+
+static inline void __dmb(void) { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t state) { (void)state; }
+
+uint get_core_num(void);
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_fifo_push_blocking(uint32_t data);
+uint32_t multicore_fifo_pop_blocking(void);
+void multicore_lockout_victim_init(void);
+bool multicore_lockout_victim_is_initialized(uint core_num);
+void multicore_lockout_start_blocking(void);
+void multicore_lockout_end_blocking(void);
+
+typedef struct {
+    uint8_t *data;
+    uint element_size;
+    uint element_count;         // Capacity
+    uint rd;
+    uint level;
+} queue_t;
+
+void queue_init(queue_t *q, uint element_size, uint element_count);
+bool queue_try_add(queue_t *q, const void *data);
+bool queue_try_remove(queue_t *q, void *data);
+uint queue_get_level(queue_t *q);
+
+typedef struct {
+    int owner;                  // Core number, -1 = free
+} mutex_t;
+
+void mutex_init(mutex_t *mtx);
+void mutex_enter_blocking(mutex_t *mtx);
+void mutex_exit(mutex_t *mtx);
+
+/* ============================================================================
+ * Watchdog, reset, identity, entropy (sim_sdk.c)
+ * ========================================================================== */
+
+void watchdog_enable(uint32_t delay_ms, bool pause_on_debug);
+void watchdog_disable(void);
+void watchdog_update(void);
+void watchdog_reboot(uint32_t pc, uint32_t sp, uint32_t delay_ms);
+void reset_usb_boot(uint32_t gpio_activity_pin_mask, uint32_t disable_interface_mask);
+
+#define PICO_UNIQUE_BOARD_ID_SIZE_BYTES 8
+typedef struct {
+    uint8_t id[PICO_UNIQUE_BOARD_ID_SIZE_BYTES];
+} pico_unique_board_id_t;
+
+void pico_get_unique_board_id(pico_unique_board_id_t *id);
+uint32_t get_rand_32(void);
+
+// clk_sys and clk_peri take whatever clock_configure sets; the rest are fixed
+enum clock_index { clk_gpout0, clk_ref, clk_sys, clk_peri, clk_usb, clk_adc };
+#define CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX    1u
+#define CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS     0u
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS           0u
+uint32_t clock_get_hz(enum clock_index clk);
+bool clock_configure(enum clock_index clk, uint32_t src, uint32_t auxsrc,
+                     uint32_t src_freq, uint32_t freq);
+void clock_configure_undivided(enum clock_index clk, uint32_t src, uint32_t auxsrc,
+                               uint32_t src_freq);
+
+/* ============================================================================
+ * GPIO and PIO (no-ops except the I2C pins, which bus recovery bit-bangs)
+ * ========================================================================== */
+
+#define GPIO_IN                 false
+#define GPIO_OUT                true
+#define GPIO_FUNC_SPI           1
+#define GPIO_FUNC_I2C           3
+#define GPIO_FUNC_SIO           5
+#define GPIO_FUNC_PIO0          6
+#define GPIO_FUNC_PIO1          7
+#define GPIO_DRIVE_STRENGTH_2MA 0
+#define GPIO_DRIVE_STRENGTH_4MA 1
+#define GPIO_SLEW_RATE_SLOW     0
+
+static inline void gpio_init(uint gpio) { (void)gpio; }
+static inline void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+static inline void gpio_pull_down(uint gpio) { (void)gpio; }
+void gpio_put(uint gpio, bool value);         // sim_bmp280.c: I2C pins only
+bool gpio_get(uint gpio);
+void gpio_set_function(uint gpio, int fn);
+static inline void gpio_set_drive_strength(uint gpio, int s) { (void)gpio; (void)s; }
+static inline void gpio_set_slew_rate(uint gpio, int s) { (void)gpio; (void)s; }
+
+typedef struct sim_pio *PIO;
+extern struct sim_pio sim_pio0, sim_pio1;
+#define pio0 (&sim_pio0)
+#define pio1 (&sim_pio1)
+
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+int pio_claim_unused_sm(PIO pio, bool required);
+static inline void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    (void)pio; (void)sm; (void)data;
+}
+static inline void pio_sm_set_clkdiv(PIO pio, uint sm, float div) {
+    (void)pio; (void)sm; (void)div;
+}
+
+/* ============================================================================
+ * I2C (sim_bmp280.c: devices answer by address)
+ * ========================================================================== */
+
+typedef struct { int index; } i2c_inst_t;
+extern i2c_inst_t sim_i2c0, sim_i2c1;
+#define i2c0 (&sim_i2c0)
+#define i2c1 (&sim_i2c1)
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len,
+                         bool nostop, uint timeout_us);
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len,
+                        bool nostop, uint timeout_us);
+
+/* ============================================================================
+ * Flash (sim_flash.c: mapped at the real XIP address)
+ * ========================================================================== */
+
+#define FLASH_PAGE_SIZE         256u
+#define FLASH_SECTOR_SIZE       4096u
+#define XIP_BASE                ((uintptr_t)0x10000000u)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+/* ============================================================================
+ * DMA (sim_dma.c: transfers complete when triggered; sniffer CRC-32 modes)
+ * ========================================================================== */
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    enum dma_channel_transfer_size size;
+    bool read_increment;
+    bool write_increment;
+    bool sniff;
+} dma_channel_config;
+
+#define NUM_DMA_CHANNELS                    16
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC32     0x0
+#define DMA_SNIFF_CTRL_CALC_VALUE_CRC32R    0x1
+
+int dma_claim_unused_channel(bool required);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void dma_channel_configure(uint channel, const dma_channel_config *config,
+                           volatile void *write_addr, const volatile void *read_addr,
+                           uint transfer_count, bool trigger);
+static inline void dma_channel_wait_for_finish_blocking(uint channel) { (void)channel; }
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c,
+                                                         enum dma_channel_transfer_size size) {
+    c->size = size;
+}
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->read_increment = incr;
+}
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->write_increment = incr;
+}
+static inline void channel_config_set_sniff_enable(dma_channel_config *c, bool sniff) {
+    c->sniff = sniff;
+}
+
+void dma_sniffer_enable(uint channel, uint mode, bool force_channel_enable);
+void dma_sniffer_disable(void);
+void dma_sniffer_set_data_accumulator(uint32_t seed_value);
+uint32_t dma_sniffer_get_data_accumulator(void);
+void dma_sniffer_set_output_reverse_enabled(bool enable);
+void dma_sniffer_set_output_invert_enabled(bool enable);
+
+/* ============================================================================
+ * USB (sim_usb.c)
+ * ========================================================================== */
+
+typedef struct {
+    volatile uint32_t sie_status;
+} usb_hw_t;
+extern usb_hw_t *usb_hw;
+#define USB_SIE_STATUS_SUSPENDED_BITS 0x00000010u
+
+typedef struct {
+    uint8_t bLength, bDescriptorType;
+    uint16_t bcdUSB;
+    uint8_t bDeviceClass, bDeviceSubClass, bDeviceProtocol, bMaxPacketSize0;
+    uint16_t idVendor, idProduct, bcdDevice;
+    uint8_t iManufacturer, iProduct, iSerialNumber, bNumConfigurations;
+} tusb_desc_device_t;
+
+bool tusb_init(void);
+void tud_task(void);
+bool tud_connected(void);
+bool tud_mounted(void);
+bool tud_remote_wakeup(void);
+bool tud_midi_mounted(void);
+uint32_t tud_midi_stream_write(uint8_t cable_num, const uint8_t *buffer, uint32_t bufsize);
+uint32_t tud_midi_available(void);
+bool tud_midi_packet_read(uint8_t packet[4]);
+
+// Application callbacks (defined by the firmware)
+void tud_suspend_cb(bool remote_wakeup_en);
+void tud_resume_cb(void);
+
+// usb_descriptors.c stand-in
+void usb_set_serial_number(const char *serial);
+
+/* ============================================================================
+ * mbedtls (sim_mbedtls.c: every call fails, so ECDSA stays uninitialized
+ * and the auth commands answer 0x03, as with the placeholder keys)
+ * ========================================================================== */
+
+typedef struct { int unused; } mbedtls_ecdsa_context;
+typedef struct { int unused; } mbedtls_ctr_drbg_context;
+#define MBEDTLS_ECP_DP_SECP256R1    0
+#define MBEDTLS_MD_SHA256           0
+#define MBEDTLS_ECDSA_MAX_LEN       141
+
+void mbedtls_ecdsa_init(mbedtls_ecdsa_context *ctx);
+void mbedtls_ecdsa_free(mbedtls_ecdsa_context *ctx);
+void mbedtls_ctr_drbg_init(mbedtls_ctr_drbg_context *ctx);
+void mbedtls_ctr_drbg_free(mbedtls_ctr_drbg_context *ctx);
+int mbedtls_ctr_drbg_seed(mbedtls_ctr_drbg_context *ctx,
+                          int (*f_entropy)(void *, unsigned char *, size_t), void *p_entropy,
+                          const unsigned char *custom, size_t len);
+int mbedtls_ctr_drbg_random(void *p_rng, unsigned char *output, size_t output_len);
+int mbedtls_ecp_read_key(int grp_id, mbedtls_ecdsa_context *key, const unsigned char *buf,
+                         size_t buflen);
+int mbedtls_ecp_keypair_calc_public(mbedtls_ecdsa_context *key,
+                                    int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+int mbedtls_ecdsa_write_signature(mbedtls_ecdsa_context *ctx, int md_alg,
+                                  const unsigned char *hash, size_t hlen,
+                                  unsigned char *sig, size_t sig_size, size_t *slen,
+                                  int (*f_rng)(void *, unsigned char *, size_t), void *p_rng);
+int mbedtls_sha256(const unsigned char *input, size_t ilen, unsigned char *output, int is224);
+void mbedtls_platform_zeroize(void *buf, size_t len);
+
+#endif // SIM_SDK_H
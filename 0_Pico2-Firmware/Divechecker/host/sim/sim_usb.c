@@ -0,0 +1,243 @@
+/**
+ * @file sim_usb.c
+ * @brief Fake TinyUSB MIDI device plus the host that polls it
+ *
+ * Device side: tud_midi_stream_write packs the byte stream into 4-byte
+ * USB-MIDI events in a CFG_TUD_MIDI_TX_BUFSIZE FIFO, accepting bytes only
+ * while an event slot is free (as TinyUSB does), so a slow host pushes
+ * back on the firmware's retry loop. Host side: once per 1ms frame the
+ * host takes up to events_per_frame events, reassembles SysEx messages and
+ * queues them for sim_usb_recv. The FIFO is drained lazily from the frame
+ * count whenever either side touches it. Suspend/resume callbacks are
+ * delivered from tud_task on core 0, like the real stack.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sim_sdk.h"
+#include "sim.h"
+#include "tusb_config.h"
+#include <string.h>
+
+#define TX_EVENTS           (CFG_TUD_MIDI_TX_BUFSIZE / 4)
+#define RX_EVENTS           256
+#define HOST_RX_BYTES       (256 * 1024)
+#define HOST_MSG_MAX        1024
+
+static usb_hw_t g_usb_regs;
+usb_hw_t *usb_hw = &g_usb_regs;
+
+static bool g_plugged = true;
+static bool g_remote_wakeup_en = false;
+static bool g_suspend_pending = false;
+static bool g_resume_pending = false;
+static uint32_t g_events_per_frame = 64;    // Four 64-byte packets per frame
+
+// Device TX FIFO (complete events) and the event being assembled
+static uint8_t g_tx[TX_EVENTS][4];
+static uint32_t g_tx_rd = 0;
+static uint32_t g_tx_level = 0;
+static uint8_t g_tx_partial[4];
+static uint8_t g_tx_partial_len = 0;
+static uint64_t g_last_frame = 0;
+
+// Device RX FIFO (host -> device events)
+static uint8_t g_rx[RX_EVENTS][4];
+static uint32_t g_rx_rd = 0;
+static uint32_t g_rx_level = 0;
+
+// Host: message being reassembled, then completed messages as
+// [len lo][len hi][bytes...] in a ring
+static uint8_t g_host_msg[HOST_MSG_MAX];
+static size_t g_host_msg_len = 0;
+static bool g_host_in_sysex = false;
+static uint8_t g_host_rx[HOST_RX_BYTES];
+static size_t g_host_rx_rd = 0;
+static size_t g_host_rx_level = 0;
+
+static inline bool suspended(void) {
+    return (usb_hw->sie_status & USB_SIE_STATUS_SUSPENDED_BITS) != 0;
+}
+
+/* ============================================================================
+ * Host side
+ * ========================================================================== */
+
+static void host_rx_put(uint8_t b) {
+    g_host_rx[(g_host_rx_rd + g_host_rx_level) % HOST_RX_BYTES] = b;
+    g_host_rx_level++;
+}
+
+static void host_rx_byte(uint8_t b) {
+    if (b == 0xF0) {
+        g_host_in_sysex = true;
+        g_host_msg_len = 0;
+    }
+    if (!g_host_in_sysex) return;
+    if (g_host_msg_len < HOST_MSG_MAX) g_host_msg[g_host_msg_len++] = b;
+    if (b != 0xF7) return;
+
+    g_host_in_sysex = false;
+    if (g_host_rx_level + g_host_msg_len + 2 > HOST_RX_BYTES) {
+        fprintf(stderr, "sim: host receive buffer full, message dropped\n");
+        return;
+    }
+    host_rx_put((uint8_t)g_host_msg_len);
+    host_rx_put((uint8_t)(g_host_msg_len >> 8));
+    for (size_t i = 0; i < g_host_msg_len; i++) host_rx_put(g_host_msg[i]);
+}
+
+/**
+ * @brief Host polls for the frames that passed since the last call
+ */
+static void host_poll(void) {
+    uint64_t frame = sim_now_us() / 1000;
+    uint64_t frames = frame - g_last_frame;
+    g_last_frame = frame;
+    if (!g_plugged || suspended() || frames == 0) return;
+
+    uint64_t budget = frames * g_events_per_frame;
+    while (budget > 0 && g_tx_level > 0) {
+        const uint8_t *event = g_tx[g_tx_rd];
+        uint8_t cin = event[0] & 0x0F;
+        int n = (cin == 0x5) ? 1 : (cin == 0x6) ? 2 : 3;
+        for (int i = 0; i < n; i++) host_rx_byte(event[1 + i]);
+        g_tx_rd = (g_tx_rd + 1) % TX_EVENTS;
+        g_tx_level--;
+        budget--;
+    }
+}
+
+void sim_usb_plug(bool plugged) {
+    host_poll();
+    g_plugged = plugged;
+    if (!plugged) {
+        g_tx_level = 0;
+        g_tx_partial_len = 0;
+        g_rx_level = 0;
+    }
+}
+
+void sim_usb_suspend(bool remote_wakeup_en) {
+    host_poll();
+    g_remote_wakeup_en = remote_wakeup_en;
+    usb_hw->sie_status |= USB_SIE_STATUS_SUSPENDED_BITS;
+    g_suspend_pending = true;
+}
+
+void sim_usb_resume(void) {
+    usb_hw->sie_status &= ~USB_SIE_STATUS_SUSPENDED_BITS;
+    g_last_frame = sim_now_us() / 1000;    // No polling happened meanwhile
+    g_resume_pending = true;
+}
+
+void sim_usb_set_host_rate(uint32_t events_per_frame) {
+    host_poll();
+    g_events_per_frame = events_per_frame;
+}
+
+bool sim_usb_send(const uint8_t *sysex, size_t len) {
+    if (len < 2 || sysex[0] != 0xF0 || sysex[len - 1] != 0xF7) return false;
+    if (g_rx_level + (len + 2) / 3 > RX_EVENTS) return false;
+    for (size_t i = 0; i < len; i += 3) {
+        size_t n = (len - i < 3) ? len - i : 3;
+        uint8_t *event = g_rx[(g_rx_rd + g_rx_level) % RX_EVENTS];
+        bool end = (i + n == len);
+        // CIN 4: SysEx start/continue, 5/6/7: SysEx ends with 1/2/3 bytes
+        event[0] = end ? (uint8_t)(0x4 + n) : 0x4;
+        memset(&event[1], 0, 3);
+        memcpy(&event[1], &sysex[i], n);
+        g_rx_level++;
+    }
+    return true;
+}
+
+size_t sim_usb_recv(uint8_t *buf, size_t max) {
+    host_poll();
+    if (g_host_rx_level < 2) return 0;
+    size_t len = g_host_rx[g_host_rx_rd] | ((size_t)g_host_rx[(g_host_rx_rd + 1) % HOST_RX_BYTES] << 8);
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = g_host_rx[(g_host_rx_rd + 2 + i) % HOST_RX_BYTES];
+        if (i < max) buf[i] = b;
+    }
+    g_host_rx_rd = (g_host_rx_rd + 2 + len) % HOST_RX_BYTES;
+    g_host_rx_level -= 2 + len;
+    return len < max ? len : max;
+}
+
+/* ============================================================================
+ * Device side (TinyUSB API)
+ * ========================================================================== */
+
+bool tusb_init(void) {
+    return true;
+}
+
+void tud_task(void) {
+    host_poll();
+    if (g_suspend_pending) {
+        g_suspend_pending = false;
+        tud_suspend_cb(g_remote_wakeup_en);
+    }
+    if (g_resume_pending) {
+        g_resume_pending = false;
+        tud_resume_cb();
+    }
+}
+
+bool tud_connected(void) {
+    return g_plugged;
+}
+
+bool tud_mounted(void) {
+    return g_plugged;
+}
+
+bool tud_midi_mounted(void) {
+    return g_plugged;
+}
+
+bool tud_remote_wakeup(void) {
+    if (!suspended() || !g_remote_wakeup_en) return false;
+    sim_usb_resume();   // The host answers with a resume at once
+    return true;
+}
+
+uint32_t tud_midi_stream_write(uint8_t cable_num, const uint8_t *buffer, uint32_t bufsize) {
+    (void)cable_num;
+    host_poll();
+    if (!g_plugged) return 0;
+
+    uint32_t i = 0;
+    for (; i < bufsize; i++) {
+        // A byte is only taken while its event can still be queued
+        if (g_tx_level == TX_EVENTS) break;
+        uint8_t b = buffer[i];
+        g_tx_partial[1 + g_tx_partial_len++] = b;
+        if (g_tx_partial_len == 3 || b == 0xF7) {
+            g_tx_partial[0] = (b == 0xF7) ? (uint8_t)(0x4 + g_tx_partial_len) : 0x4;
+            memcpy(g_tx[(g_tx_rd + g_tx_level) % TX_EVENTS], g_tx_partial, 4);
+            g_tx_level++;
+            g_tx_partial_len = 0;
+        }
+    }
+    return i;
+}
+
+uint32_t tud_midi_available(void) {
+    return (g_plugged && !suspended()) ? g_rx_level * 4 : 0;
+}
+
+bool tud_midi_packet_read(uint8_t packet[4]) {
+    if (tud_midi_available() == 0) return false;
+    memcpy(packet, g_rx[g_rx_rd], 4);
+    g_rx_rd = (g_rx_rd + 1) % RX_EVENTS;
+    g_rx_level--;
+    return true;
+}
+
+void usb_set_serial_number(const char *serial) {
+    (void)serial;
+}
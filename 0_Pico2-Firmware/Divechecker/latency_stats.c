@@ -0,0 +1,35 @@
+/**
+ * @file latency_stats.c
+ * @brief Per-stage latency histograms for the sensor-to-USB pipeline
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "latency_stats.h"
+#include <string.h>
+
+static latency_hist_t g_hist[LATENCY_STAGE_COUNT];
+
+void latency_stats_reset(void) {
+    memset(g_hist, 0, sizeof(g_hist));
+}
+
+void latency_stats_record(latency_stage_t stage, uint32_t elapsed_us) {
+    if ((unsigned)stage >= LATENCY_STAGE_COUNT) return;
+    latency_hist_t *h = &g_hist[stage];
+
+    // floor(log2(us)) via count-leading-zeros (single CLZ instruction on M33)
+    uint32_t bucket = (elapsed_us < 2) ? 0 : (31u - (uint32_t)__builtin_clz(elapsed_us));
+    if (bucket >= LATENCY_HIST_BUCKETS) bucket = LATENCY_HIST_BUCKETS - 1;
+
+    if (h->buckets[bucket] < UINT32_MAX) h->buckets[bucket]++;
+    if (h->count < UINT32_MAX) h->count++;
+    if (elapsed_us > h->max_us) h->max_us = elapsed_us;
+}
+
+const latency_hist_t* latency_stats_get(latency_stage_t stage) {
+    if ((unsigned)stage >= LATENCY_STAGE_COUNT) return NULL;
+    return &g_hist[stage];
+}
@@ -0,0 +1,60 @@
+/**
+ * @file latency_stats.h
+ * @brief Per-stage latency histograms for the sensor-to-USB pipeline
+ *
+ * Each pressure frame is stamped at four points:
+ *   read  - bmp280_read_pressure() returned the newest sample of the window (Core 1)
+ *   push  - frame added to the inter-core queue (Core 1)
+ *   pop   - frame removed from the queue (Core 0)
+ *   tx    - frame handed to the USB MIDI endpoint (Core 0)
+ *
+ * All recording happens on Core 0 (the read/push stamps travel inside the
+ * queued packet), so the tables need no locking.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+#include <stdint.h>
+
+// log2 buckets in microseconds: bucket 0 = [0,2), bucket n = [2^n, 2^(n+1)),
+// last bucket also collects everything above (>= 524ms)
+#define LATENCY_HIST_BUCKETS    20
+
+typedef enum {
+    LATENCY_STAGE_READ_TO_PUSH = 0,  // Averaging window hold time
+    LATENCY_STAGE_PUSH_TO_POP,       // Inter-core queue residency
+    LATENCY_STAGE_POP_TO_TX,         // SysEx encode + USB write
+    LATENCY_STAGE_READ_TO_TX,        // End-to-end
+    LATENCY_STAGE_COUNT
+} latency_stage_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint32_t buckets[LATENCY_HIST_BUCKETS];
+} latency_hist_t;
+
+/**
+ * @brief Clear all histograms
+ */
+void latency_stats_reset(void);
+
+/**
+ * @brief Record one elapsed time for a stage (Core 0 only)
+ * @param stage Pipeline stage
+ * @param elapsed_us Elapsed time in microseconds
+ */
+void latency_stats_record(latency_stage_t stage, uint32_t elapsed_us);
+
+/**
+ * @brief Get histogram for a stage
+ * @return Pointer to histogram, or NULL if stage is out of range
+ */
+const latency_hist_t* latency_stats_get(latency_stage_t stage);
+
+#endif // LATENCY_STATS_H
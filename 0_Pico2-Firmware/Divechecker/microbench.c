@@ -0,0 +1,218 @@
+/**
+ * @file microbench.c
+ * @brief Opt-in microbenchmarks of the firmware hot paths
+ *
+ * Every case calls the code the firmware runs, on inputs that change per
+ * iteration so nothing is folded at compile time:
+ *
+ *   bmp280_compensate    t_fine + Q24.8 pressure + hPa (every sample)
+ *   crc32_256B           crc32_compute over one flash page (software)
+ *   crc32_region_4KB     crc32_region over one flash sector (DMA sniffer;
+ *                        on the host this times the simulator's model)
+ *   sysex_pressure_frame CMD_PRESSURE encoding (midi_sysex_send_pressure
+ *                        minus the USB write)
+ *   sysex_parse_pressure one CMD_PRESSURE message through
+ *                        midi_sysex_receive_byte
+ *   frame_average        sensor_mean over 12 samples (100 Hz at 8 Hz out)
+ *   frame_stats          sensor_frame_stats over the same window (the
+ *                        primary averager: mean, min/max, variance)
+ *   settings_build       flash_build_settings with nothing changed
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "microbench.h"
+
+#if DIVECHECKER_MICROBENCH
+
+#include "bmp280_compensate.h"
+#include "crc32.h"
+#include "crc32_dma.h"
+#include "midi_sysex.h"
+#include "profiler.h"
+#include "sensor.h"
+#include "pico/stdlib.h"
+#include "hardware/watchdog.h"
+#if !PICO_ON_DEVICE
+#include <time.h>
+#endif
+
+#define MB_CRC_LEN          256
+#define MB_REGION_LEN       4096
+#define MB_AVG_SAMPLES      12
+
+// Datasheet example trimming (section 3.12)
+static const bmp280_calib_t k_calib = {
+    27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+};
+
+static volatile uint32_t g_sink;        // Keeps results alive
+static void (*g_build_settings)(void);
+static uint8_t g_crc_buf[MB_CRC_LEN];
+static float g_avg_buf[MB_AVG_SAMPLES];
+
+static uint32_t mb_ticks(void) {
+#if PICO_ON_DEVICE
+    return profiler_cycles();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+#endif
+}
+
+uint8_t microbench_unit(void) {
+    return PICO_ON_DEVICE ? MICROBENCH_UNIT_CYCLES : MICROBENCH_UNIT_NS;
+}
+
+/* ============================================================================
+ * Cases
+ * ========================================================================== */
+
+static void mb_compensate(uint32_t iterations) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        int32_t adc_T = 519888 + (int32_t)(i & 0x3FF);
+        int32_t adc_P = 415148 + (int32_t)(i & 0xFFF);
+        int32_t t_fine = bmp280_compensate_t_fine(&k_calib, adc_T);
+        float hpa = (float)bmp280_compensate_p_q24_8(&k_calib, adc_P, t_fine) / 25600.0f;
+        acc += (uint32_t)hpa;
+    }
+    g_sink = acc;
+}
+
+static void mb_crc32(uint32_t iterations) {
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_crc_buf[0] = (uint8_t)i;
+        acc ^= crc32_compute(g_crc_buf, MB_CRC_LEN);
+    }
+    g_sink = acc;
+}
+
+static void mb_crc32_region(uint32_t iterations) {
+    // Start of the firmware image: real XIP reads
+    const void *sector = (const void *)XIP_BASE;
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        acc ^= crc32_region(i, sector, MB_REGION_LEN);
+    }
+    g_sink = acc;
+}
+
+static void mb_frame_pressure(uint32_t iterations) {
+    uint8_t buf[SYSEX_PRESSURE_FRAME_LEN];
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        acc += midi_sysex_frame_pressure(buf, (int32_t)(i * 2654435761u) >> 12);
+        acc += buf[4];
+    }
+    g_sink = acc;
+}
+
+static void mb_parse_pressure(uint32_t iterations) {
+    uint8_t buf[SYSEX_PRESSURE_FRAME_LEN];
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        uint16_t len = midi_sysex_frame_pressure(buf, (int32_t)i - 5000);
+        for (uint16_t k = 0; k < len; k++) {
+            if (midi_sysex_receive_byte(buf[k])) {
+                sysex_message_t *msg = midi_sysex_get_message();
+                acc += midi_sysex_decode_u32(msg->data);
+            }
+        }
+    }
+    g_sink = acc;
+}
+
+static void mb_average(uint32_t iterations) {
+    float acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        // One new sample per frame: the compiler cannot hoist the sum
+        g_avg_buf[i % MB_AVG_SAMPLES] = 1013.25f + (float)(i & 0xFF) * 0.001f;
+        acc += sensor_mean(g_avg_buf, MB_AVG_SAMPLES, 1.0f / MB_AVG_SAMPLES);
+    }
+    g_sink = (uint32_t)acc;
+}
+
+static void mb_stats(uint32_t iterations) {
+    float acc = 0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_avg_buf[i % MB_AVG_SAMPLES] = 1013.25f + (float)(i & 0xFF) * 0.001f;
+        sensor_frame_stats_t stats;
+        sensor_frame_stats(g_avg_buf, MB_AVG_SAMPLES, 1.0f / MB_AVG_SAMPLES, &stats);
+        acc += stats.mean + stats.max - stats.min + stats.variance;
+    }
+    g_sink = (uint32_t)acc;
+}
+
+static void mb_build_settings(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        g_build_settings();
+    }
+}
+
+static const struct {
+    const char *name;
+    void (*run)(uint32_t iterations);
+} k_cases[] = {
+    { "bmp280_compensate", mb_compensate },
+    { "crc32_256B", mb_crc32 },
+    { "crc32_region_4KB", mb_crc32_region },
+    { "sysex_pressure_frame", mb_frame_pressure },
+    { "sysex_parse_pressure", mb_parse_pressure },
+    { "frame_average", mb_average },
+    { "frame_stats", mb_stats },
+    { "settings_build", mb_build_settings },
+};
+
+_Static_assert(sizeof(k_cases) / sizeof(k_cases[0]) <= MICROBENCH_MAX_CASES,
+               "raise MICROBENCH_MAX_CASES");
+
+/* ============================================================================
+ * Runner
+ * ========================================================================== */
+
+int microbench_run_all(uint32_t iterations, void (*build_settings)(void),
+                       microbench_result_t *out) {
+    if (iterations == 0) iterations = 1;
+    if (iterations > MICROBENCH_MAX_ITERS) iterations = MICROBENCH_MAX_ITERS;
+    g_build_settings = build_settings;
+
+#if PICO_ON_DEVICE
+    PROF_DEMCR |= PROF_DEMCR_TRCENA;
+    PROF_DWT_CTRL |= PROF_DWT_CYCCNTENA;
+#endif
+    for (int i = 0; i < MB_CRC_LEN; i++) g_crc_buf[i] = (uint8_t)(i * 31 + 7);
+    for (int i = 0; i < MB_AVG_SAMPLES; i++) g_avg_buf[i] = 1013.25f;
+
+    int n = 0;
+    for (size_t c = 0; c < sizeof(k_cases) / sizeof(k_cases[0]); c++) {
+        if (k_cases[c].run == mb_build_settings && build_settings == NULL) continue;
+        k_cases[c].run(1);  // Warm caches and branch predictors
+        uint32_t best = UINT32_MAX;
+        for (int r = 0; r < MICROBENCH_RUNS; r++) {
+            watchdog_update();
+            uint32_t t0 = mb_ticks();
+            k_cases[c].run(iterations);
+            uint32_t ticks = mb_ticks() - t0;
+            if (ticks < best) best = ticks;
+        }
+        out[n++] = (microbench_result_t){ k_cases[c].name, iterations, best };
+    }
+    return n;
+}
+
+#else
+
+int microbench_run_all(uint32_t iterations, void (*build_settings)(void),
+                       microbench_result_t *out) {
+    (void)iterations; (void)build_settings; (void)out;
+    return 0;
+}
+
+uint8_t microbench_unit(void) { return MICROBENCH_UNIT_CYCLES; }
+
+#endif // DIVECHECKER_MICROBENCH
@@ -0,0 +1,70 @@
+/**
+ * @file microbench.h
+ * @brief Opt-in microbenchmarks of the firmware hot paths
+ *
+ * Build with -DDIVECHECKER_MICROBENCH=ON for the on-target image; the
+ * host simulator build always has it. CMD_RUN_MICROBENCH runs every case
+ * on Core 0 and answers with one CMD_MICROBENCH_RESULT per case. Costs are
+ * DWT cycles on the device and nanoseconds on the host (host/microbench
+ * prints either as JSON).
+ *
+ * Each case is timed over a fixed number of iterations, best of
+ * MICROBENCH_RUNS runs; the watchdog is fed between runs. Core 1 keeps
+ * sampling meanwhile, so pressure frames queue up (and may drop) while
+ * a run is in progress.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef MICROBENCH_H
+#define MICROBENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef DIVECHECKER_MICROBENCH
+#define DIVECHECKER_MICROBENCH 0
+#endif
+
+#define MICROBENCH_RUNS             5
+#define MICROBENCH_DEFAULT_ITERS    1000
+#define MICROBENCH_MAX_ITERS        10000   // Keeps one run well inside the watchdog
+#define MICROBENCH_MAX_CASES        8
+#define MICROBENCH_NAME_MAX         24
+
+// Unit of microbench_result_t.best_ticks
+#define MICROBENCH_UNIT_CYCLES      0
+#define MICROBENCH_UNIT_NS          1
+
+typedef struct {
+    const char *name;
+    uint32_t iterations;
+    uint32_t best_ticks;        // Fastest run, all iterations
+} microbench_result_t;
+
+/**
+ * @brief Run every case
+ * @param iterations Per run, clamped to 1..MICROBENCH_MAX_ITERS
+ * @param build_settings flash_build_settings() (static in Divechecker.c),
+ *                       NULL to skip that case
+ * @param out At least MICROBENCH_MAX_CASES entries
+ * @return Number of results, 0 when not compiled in
+ */
+int microbench_run_all(uint32_t iterations, void (*build_settings)(void),
+                       microbench_result_t *out);
+
+/**
+ * @brief MICROBENCH_UNIT_* of this build
+ */
+uint8_t microbench_unit(void);
+
+/**
+ * @brief Whether the benchmarks were compiled in
+ */
+static inline bool microbench_enabled(void) {
+    return DIVECHECKER_MICROBENCH != 0;
+}
+
+#endif // MICROBENCH_H
@@ -8,6 +8,7 @@
  */
 
 #include "midi_sysex.h"
+#include "bulk_transfer.h"
 #include "tusb.h"
 #include "pico/stdlib.h"
 #include <string.h>
@@ -125,12 +126,7 @@ sysex_message_t* midi_sysex_get_message(void) {
     return NULL;
 }
 
-// Send raw SysEx — single-threaded (Core 0 only), no lock needed.
-// Retries aggressively to avoid silent data loss.
-static void midi_sysex_send_raw(uint8_t command, const uint8_t* data, uint16_t len) {
-    if (!tud_midi_mounted()) return;
-
-    uint8_t buffer[SYSEX_MAX_SIZE];
+uint16_t midi_sysex_frame(uint8_t* buffer, uint8_t command, const uint8_t* data, uint16_t len) {
     uint16_t idx = 0;
 
     buffer[idx++] = SYSEX_START;
@@ -143,6 +139,15 @@ static void midi_sysex_send_raw(uint8_t command, const uint8_t* data, uint16_t l
     }
 
     buffer[idx++] = SYSEX_END;
+    return idx;
+}
+
+// Send a built frame — single-threaded (Core 0 only), no lock needed.
+// Retries aggressively to avoid silent data loss.
+// Returns true if every byte was accepted by the USB MIDI stream.
+static bool midi_sysex_send_frame(const uint8_t* buffer, uint16_t len) {
+    if (!tud_midi_mounted()) return false;
+    PROF_BEGIN(prof_t0);
 
     // Send with generous retry to survive transient USB host delays.
     // USB Full-Speed bulk transfers can stall for several ms during
@@ -150,8 +155,8 @@ static void midi_sysex_send_raw(uint8_t command, const uint8_t* data, uint16_t l
     // span multiple USB frames (1ms each) without dropping data.
     uint16_t sent = 0;
     int retry_count = 0;
-    while (sent < idx && retry_count < 200) {
-        uint32_t written = tud_midi_stream_write(0, buffer + sent, idx - sent);
+    while (sent < len && retry_count < 200) {
+        uint32_t written = tud_midi_stream_write(0, buffer + sent, len - sent);
         if (written > 0) {
             sent += written;
             retry_count = 0;  // Reset on progress
@@ -164,34 +169,78 @@ static void midi_sysex_send_raw(uint8_t command, const uint8_t* data, uint16_t l
 
     // Flush: ensure data reaches the USB endpoint
     tud_task();
+    PROF_END(prof_t0, PROF_SYSEX_SEND_RAW);
+    return sent == len;
 }
 
-void midi_sysex_send_pressure(int32_t pressure_mhpa) {
-    // Encode as 5 bytes of 7-bit data (35 bits, enough for int32)
-    // Big-endian, 7 bits per byte
-    // Use absolute value + sign bit for proper encoding
-    uint8_t data[5];
-    bool negative = (pressure_mhpa < 0);
-    uint32_t val = negative ? (~(uint32_t)pressure_mhpa + 1u) : (uint32_t)pressure_mhpa;
-    
-    data[0] = (val >> 28) & 0x0F;  // Top 4 bits
+static bool midi_sysex_send_raw(uint8_t command, const uint8_t* data, uint16_t len) {
+    if (!tud_midi_mounted()) return false;
+    uint8_t buffer[SYSEX_MAX_SIZE];
+    return midi_sysex_send_frame(buffer, midi_sysex_frame(buffer, command, data, len));
+}
+
+// Encode uint32 as 5 bytes of 7-bit data (big-endian, top 4 bits first)
+static uint8_t encode_u32_7bit(uint8_t* dst, uint32_t val) {
+    dst[0] = (val >> 28) & 0x0F;
+    dst[1] = (val >> 21) & 0x7F;
+    dst[2] = (val >> 14) & 0x7F;
+    dst[3] = (val >> 7) & 0x7F;
+    dst[4] = val & 0x7F;
+    return 5;
+}
+
+/**
+ * @brief Signed int32 as 5 septets: magnitude, sign in bit 6 of the first
+ */
+static uint8_t encode_s32_7bit(uint8_t* dst, int32_t value) {
+    bool negative = (value < 0);
+    encode_u32_7bit(dst, negative ? (~(uint32_t)value + 1u) : (uint32_t)value);
     if (negative) {
-        data[0] |= 0x40;  // Sign bit in bit 6
+        dst[0] |= 0x40;  // Sign bit in bit 6
     }
-    data[1] = (val >> 21) & 0x7F;
-    data[2] = (val >> 14) & 0x7F;
-    data[3] = (val >> 7) & 0x7F;
-    data[4] = val & 0x7F;
-    
-    midi_sysex_send_raw(CMD_PRESSURE, data, 5);
+    return 5;
+}
+
+uint16_t midi_sysex_frame_pressure(uint8_t* buffer, int32_t pressure_mhpa) {
+    // Encode as 5 bytes of 7-bit data (35 bits, enough for int32)
+    // Big-endian, 7 bits per byte; absolute value + sign bit
+    uint8_t data[5];
+    encode_s32_7bit(data, pressure_mhpa);
+    return midi_sysex_frame(buffer, CMD_PRESSURE, data, 5);
+}
+
+bool midi_sysex_send_pressure(int32_t pressure_mhpa) {
+    uint8_t buffer[SYSEX_PRESSURE_FRAME_LEN];
+    return midi_sysex_send_frame(buffer, midi_sysex_frame_pressure(buffer, pressure_mhpa));
+}
+
+bool midi_sysex_send_pressure_stats(int32_t mean_mhpa, int32_t min_mhpa, int32_t max_mhpa,
+                                    uint32_t stddev_uhpa, uint8_t count) {
+    // Format: [mean x5][min x5][max x5][stddev x5][count]
+    uint8_t data[21];
+    encode_s32_7bit(&data[0], mean_mhpa);
+    encode_s32_7bit(&data[5], min_mhpa);
+    encode_s32_7bit(&data[10], max_mhpa);
+    encode_u32_7bit(&data[15], stddev_uhpa);
+    data[20] = count & 0x7F;
+    return midi_sysex_send_raw(CMD_PRESSURE_STATS, data, sizeof(data));
+}
+
+bool midi_sysex_send_pressure_dual(int32_t fused_mhpa, int32_t diff_mhpa, uint8_t valid) {
+    // Format: [fused x5][diff x5][valid]
+    uint8_t data[11];
+    encode_s32_7bit(&data[0], fused_mhpa);
+    encode_s32_7bit(&data[5], diff_mhpa);
+    data[10] = valid & 0x03;
+    return midi_sysex_send_raw(CMD_PRESSURE_DUAL, data, sizeof(data));
 }
 
 void midi_sysex_send_device_info(const char* serial, const char* name, 
-                                  const char* fw_version, bool sensor_ok) {
+                                  const char* fw_version, uint8_t sensor_status) {
     uint8_t data[96];
     uint8_t idx = 0;
     
-    // Format: [serial_len][serial...][name_len][name...][fw_len][fw...][sensor_ok]
+    // Format: [serial_len][serial...][name_len][name...][fw_len][fw...][sensor_status]
     
     // Serial (max 24 chars)
     uint8_t serial_len = strlen(serial);
@@ -212,13 +261,13 @@ void midi_sysex_send_device_info(const char* serial, const char* name,
     // Firmware version (max 16 chars)
     uint8_t fw_len = strlen(fw_version);
     if (fw_len > 16) fw_len = 16;
-    if (idx + 1 + fw_len + 1 > sizeof(data)) return;  // +1 for sensor_ok
+    if (idx + 1 + fw_len + 1 > sizeof(data)) return;  // +1 for sensor_status
     data[idx++] = fw_len;
     memcpy(&data[idx], fw_version, fw_len);
     idx += fw_len;
     
-    // Sensor status
-    data[idx++] = sensor_ok ? 0x01 : 0x00;
+    // Sensor status (SENSOR_STATUS_*)
+    data[idx++] = sensor_status & 0x7F;
     
     midi_sysex_send_raw(CMD_DEVICE_INFO, data, idx);
 }
@@ -253,9 +302,22 @@ void midi_sysex_send_pong(void) {
 
 void midi_sysex_send_full_config(uint8_t output_rate, uint8_t led_brightness,
                                   uint8_t noise_floor, uint8_t oversampling,
-                                  uint8_t iir_filter) {
-    uint8_t data[5] = { output_rate, led_brightness, noise_floor, oversampling, iir_filter };
-    midi_sysex_send_raw(CMD_FULL_CONFIG, data, 5);
+                                  uint8_t iir_filter, const full_config_auto_t* autotune) {
+    // Format: [rate][led][noise_floor][oversampling][iir]
+    //         [auto][period_us x3][conversion_noise_mpa x3][frame_noise_mpa x3]
+    uint8_t data[5 + 1 + 3 * 3] = { output_rate, led_brightness, noise_floor,
+                                    oversampling, iir_filter };
+    uint8_t idx = 5;
+    data[idx++] = autotune->enabled ? 1 : 0;
+    const uint32_t fields[3] = { autotune->period_us, autotune->conversion_noise_mpa,
+                                 autotune->frame_noise_mpa };
+    for (int f = 0; f < 3; f++) {
+        uint32_t v = (fields[f] > 0x1FFFFF) ? 0x1FFFFF : fields[f];  // 21-bit
+        data[idx++] = (v >> 14) & 0x7F;
+        data[idx++] = (v >> 7) & 0x7F;
+        data[idx++] = v & 0x7F;
+    }
+    midi_sysex_send_raw(CMD_FULL_CONFIG, data, idx);
 }
 
 void midi_sysex_send_temperature(int16_t temp_x100) {
@@ -276,9 +338,12 @@ void midi_sysex_send_temperature(int16_t temp_x100) {
 
 void midi_sysex_send_diagnostics(uint32_t uptime_sec, uint16_t sensor_errors,
                                   uint16_t overrange_count, uint16_t i2c_recovery_count,
-                                  int16_t cpu_temp_x100) {
+                                  int16_t cpu_temp_x100,
+                                  const sensor_health_t* health, uint8_t sensor_count,
+                                  const boot_times_t* boot, const power_stats_t* power,
+                                  const overrange_stats_t* overrange) {
     // Pack into 7-bit safe bytes
-    uint8_t data[16];
+    uint8_t data[16 + 1 + 2 * 6 + 4 * 3 + 9 + 7 * POWER_PROFILE_COUNT + 3 * 2];
     uint8_t idx = 0;
     
     // Uptime: 5 bytes (32-bit, 7-bit encoded)
@@ -312,6 +377,62 @@ void midi_sysex_send_diagnostics(uint32_t uptime_sec, uint16_t sensor_errors,
     data[idx++] = (abs_temp >> 7) & 0x7F;
     data[idx++] = abs_temp & 0x7F;
     
+    // Per-sensor health: [count] then [bus errors x2][invalid x2][resets x2] each
+    if (sensor_count > 2) sensor_count = 2;
+    data[idx++] = sensor_count;
+    for (uint8_t i = 0; i < sensor_count; i++) {
+        uint16_t fields[3] = { health[i].bus_errors, health[i].invalid_samples,
+                               health[i].resets };
+        for (int f = 0; f < 3; f++) {
+            uint16_t v = (fields[f] > 0x3FFF) ? 0x3FFF : fields[f];  // 14-bit
+            data[idx++] = (v >> 7) & 0x7F;
+            data[idx++] = v & 0x7F;
+        }
+    }
+    
+    // Boot phases: [usb_init][usb_mounted][sensor_ready][first_frame],
+    // ms since reset, 21-bit each (BOOT_TIME_PENDING = not reached)
+    const uint32_t phases[4] = { boot->usb_init_ms, boot->usb_mounted_ms,
+                                 boot->sensor_ready_ms, boot->first_frame_ms };
+    for (int f = 0; f < 4; f++) {
+        uint32_t v = (phases[f] > BOOT_TIME_PENDING) ? BOOT_TIME_PENDING : phases[f];
+        data[idx++] = (v >> 14) & 0x7F;
+        data[idx++] = (v >> 7) & 0x7F;
+        data[idx++] = v & 0x7F;
+    }
+    
+    // Power: [core0 active x2][core1 active x2] (permille), [profile]
+    // [clk_sys kHz x3], then [count] and per profile [ms x5][entries x2]
+    for (int c = 0; c < 2; c++) {
+        data[idx++] = (power->active_permille[c] >> 7) & 0x7F;
+        data[idx++] = power->active_permille[c] & 0x7F;
+    }
+    data[idx++] = power->profile & 0x7F;
+    data[idx++] = (power->sys_khz >> 14) & 0x7F;
+    data[idx++] = (power->sys_khz >> 7) & 0x7F;
+    data[idx++] = power->sys_khz & 0x7F;
+    data[idx++] = POWER_PROFILE_COUNT;
+    for (int p = 0; p < POWER_PROFILE_COUNT; p++) {
+        uint32_t ms = power->state_ms[p];
+        data[idx++] = (ms >> 28) & 0x0F;
+        data[idx++] = (ms >> 21) & 0x7F;
+        data[idx++] = (ms >> 14) & 0x7F;
+        data[idx++] = (ms >> 7) & 0x7F;
+        data[idx++] = ms & 0x7F;
+        uint16_t entries = (power->entries[p] > 0x3FFF) ? 0x3FFF : power->entries[p];
+        data[idx++] = (entries >> 7) & 0x7F;
+        data[idx++] = entries & 0x7F;
+    }
+    
+    // Over-range recovery: [last ms x2][worst ms x2][predicted events x2]
+    const uint16_t recovery[3] = { overrange->last_ms, overrange->max_ms,
+                                   overrange->predicted };
+    for (int f = 0; f < 3; f++) {
+        uint16_t v = (recovery[f] > 0x3FFF) ? 0x3FFF : recovery[f];
+        data[idx++] = (v >> 7) & 0x7F;
+        data[idx++] = v & 0x7F;
+    }
+    
     midi_sysex_send_raw(CMD_DIAGNOSTICS, data, idx);
 }
 
@@ -319,3 +440,230 @@ void midi_sysex_send_ack(uint8_t cmd_id, uint8_t status) {
     uint8_t data[2] = { cmd_id & 0x7F, status & 0x7F };
     midi_sysex_send_raw(CMD_ACK, data, 2);
 }
+
+void midi_sysex_send_latency_stats(uint8_t stage, uint32_t count, uint32_t max_us,
+                                    const uint32_t* buckets, uint8_t num_buckets) {
+    // Format: [stage][count x5][max_us x5][num_buckets][bucket x5]...
+    uint8_t data[12 + 5 * 32];
+    uint16_t idx = 0;
+
+    if (num_buckets > 32) num_buckets = 32;
+
+    data[idx++] = stage & 0x7F;
+    idx += encode_u32_7bit(&data[idx], count);
+    idx += encode_u32_7bit(&data[idx], max_us);
+    data[idx++] = num_buckets;
+    for (uint8_t i = 0; i < num_buckets; i++) {
+        idx += encode_u32_7bit(&data[idx], buckets[i]);
+    }
+
+    midi_sysex_send_raw(CMD_LATENCY_STATS, data, idx);
+}
+
+void midi_sysex_send_profile_page(uint8_t page, uint8_t total_pages,
+                                   const profiler_row_t* rows, uint8_t num_rows) {
+    // Format: [page][total_pages][num_rows] then per row:
+    //   [core][id][count x5][total_hi x5][total_lo x5][min x5][max x5]
+    uint8_t data[3 + 27 * PROFILE_ROWS_PER_PAGE];
+    uint16_t idx = 0;
+
+    if (num_rows > PROFILE_ROWS_PER_PAGE) num_rows = PROFILE_ROWS_PER_PAGE;
+
+    data[idx++] = page & 0x7F;
+    data[idx++] = total_pages & 0x7F;
+    data[idx++] = num_rows;
+    for (uint8_t i = 0; i < num_rows; i++) {
+        const profiler_entry_t *e = &rows[i].entry;
+        data[idx++] = rows[i].core & 0x7F;
+        data[idx++] = rows[i].id & 0x7F;
+        idx += encode_u32_7bit(&data[idx], e->count);
+        idx += encode_u32_7bit(&data[idx], (uint32_t)(e->total_cycles >> 32));
+        idx += encode_u32_7bit(&data[idx], (uint32_t)e->total_cycles);
+        idx += encode_u32_7bit(&data[idx], e->min_cycles);
+        idx += encode_u32_7bit(&data[idx], e->max_cycles);
+    }
+
+    midi_sysex_send_raw(CMD_PROFILE_DATA, data, idx);
+}
+
+void midi_sysex_send_microbench_result(uint8_t index, uint8_t count, uint8_t unit,
+                                       const microbench_result_t* result) {
+    // Format: [index][count][unit][iterations x5][best_ticks x5][name_len][name...]
+    uint8_t data[14 + MICROBENCH_NAME_MAX];
+    uint16_t idx = 0;
+
+    data[idx++] = index & 0x7F;
+    data[idx++] = count & 0x7F;
+    data[idx++] = unit & 0x7F;
+    idx += encode_u32_7bit(&data[idx], result->iterations);
+    idx += encode_u32_7bit(&data[idx], result->best_ticks);
+    uint8_t name_len = (uint8_t)strlen(result->name);
+    if (name_len > MICROBENCH_NAME_MAX) name_len = MICROBENCH_NAME_MAX;
+    data[idx++] = name_len;
+    memcpy(&data[idx], result->name, name_len);
+    idx += name_len;
+
+    midi_sysex_send_raw(CMD_MICROBENCH_RESULT, data, idx);
+}
+
+void midi_sysex_send_flash_stats(const flash_maint_stats_t* stats) {
+    // Format: [managed x5][erased x5][dirty x5][idle_erases x5]
+    //         [forced_erases x5][max_erase_count x5][min_erase_count x5]
+    uint8_t data[35];
+    uint16_t idx = 0;
+
+    idx += encode_u32_7bit(&data[idx], stats->managed);
+    idx += encode_u32_7bit(&data[idx], stats->erased);
+    idx += encode_u32_7bit(&data[idx], stats->dirty);
+    idx += encode_u32_7bit(&data[idx], stats->idle_erases);
+    idx += encode_u32_7bit(&data[idx], stats->forced_erases);
+    idx += encode_u32_7bit(&data[idx], stats->max_erase_count);
+    idx += encode_u32_7bit(&data[idx], stats->min_erase_count);
+
+    midi_sysex_send_raw(CMD_FLASH_STATS, data, idx);
+}
+
+void midi_sysex_send_recorder_status(const recorder_status_t* status) {
+    // Format: [state][session x5][pages x5][capacity_pages x5]
+    //         [trigger_x1000 x5][headroom_ends x5]
+    uint8_t data[26];
+    uint16_t idx = 0;
+
+    data[idx++] = status->state & 0x7F;
+    idx += encode_u32_7bit(&data[idx], status->session);
+    idx += encode_u32_7bit(&data[idx], status->pages);
+    idx += encode_u32_7bit(&data[idx], status->capacity_pages);
+    idx += encode_u32_7bit(&data[idx], status->trigger_x1000);
+    idx += encode_u32_7bit(&data[idx], status->headroom_ends);
+
+    midi_sysex_send_raw(CMD_RECORDER_STATUS, data, idx);
+}
+
+void midi_sysex_send_capture_status(const capture_status_t* status) {
+    // Format: [state][id][mode][samples x2][pre x2][trigger_value x5]
+    // trigger_value uses the CMD_PRESSURE encoding (magnitude + sign in bit 6)
+    uint8_t data[12];
+    uint16_t idx = 0;
+    int32_t v = status->trigger_value;
+    bool negative = (v < 0);
+
+    data[idx++] = status->state & 0x7F;
+    data[idx++] = status->id & 0x7F;
+    data[idx++] = status->mode & 0x7F;
+    data[idx++] = (status->samples >> 7) & 0x7F;
+    data[idx++] = status->samples & 0x7F;
+    data[idx++] = (status->pre_samples >> 7) & 0x7F;
+    data[idx++] = status->pre_samples & 0x7F;
+    encode_u32_7bit(&data[idx], negative ? (~(uint32_t)v + 1u) : (uint32_t)v);
+    if (negative) {
+        data[idx] |= 0x40;
+    }
+    idx += 5;
+
+    midi_sysex_send_raw(CMD_CAPTURE_STATUS, data, idx);
+}
+
+bool midi_sysex_send_burst_batch(const burst_batch_t* batch) {
+    // Format: [flags][seq x3][t0_us x5][count] + count x ([dt_us x3][sample])
+    //   PRESSURE sample: [delta x5], RAW sample: [adc_P << 20 | adc_T x6]
+    uint8_t data[BURST_BATCH_HEADER + BURST_BATCH_MAX * BURST_SAMPLE_BYTES];
+    bool raw = (batch->mode == BURST_MODE_RAW);
+    uint16_t idx = 0;
+    uint32_t t_prev = batch->count > 0 ? batch->samples[0].t_us : 0;
+
+    data[idx++] = batch->flags & 0x7F;
+    data[idx++] = (batch->seq >> 14) & 0x7F;
+    data[idx++] = (batch->seq >> 7) & 0x7F;
+    data[idx++] = batch->seq & 0x7F;
+    idx += encode_u32_7bit(&data[idx], t_prev);
+    data[idx++] = batch->count & 0x7F;
+
+    for (uint8_t i = 0; i < batch->count; i++) {
+        const burst_sample_t* s = &batch->samples[i];
+        uint32_t dt = s->t_us - t_prev;
+        if (dt > 0x1FFFFF) dt = 0x1FFFFF;  // 21-bit field (~2 s)
+        t_prev = s->t_us;
+        data[idx++] = (dt >> 14) & 0x7F;
+        data[idx++] = (dt >> 7) & 0x7F;
+        data[idx++] = dt & 0x7F;
+
+        if (raw) {
+            // 40 bits in 6 septets, big-endian
+            uint64_t v = ((uint64_t)(s->adc_P & 0xFFFFF) << 20) | (s->adc_T & 0xFFFFF);
+            for (int shift = 35; shift >= 0; shift -= 7) {
+                data[idx++] = (uint8_t)((v >> shift) & 0x7F);
+            }
+            continue;
+        }
+
+        bool negative = (s->delta_x1000 < 0);
+        encode_u32_7bit(&data[idx], negative ? (~(uint32_t)s->delta_x1000 + 1u)
+                                             : (uint32_t)s->delta_x1000);
+        if (negative) {
+            data[idx] |= 0x40;
+        }
+        idx += 5;
+    }
+
+    return midi_sysex_send_raw(raw ? CMD_RAW_BATCH : CMD_PRESSURE_BATCH, data, idx);
+}
+
+void midi_sysex_send_calibration(uint8_t chip_id, uint8_t ctrl_meas, uint8_t config,
+                                 uint32_t interval_us, const uint8_t* calib) {
+    // Format: [chip_id x2][ctrl_meas x2][config x2][interval_us x3][calib, 8-to-7 packed]
+    uint8_t data[9 + BULK_PACKED_SIZE(MIDI_CALIB_LEN)];
+    uint16_t idx = 0;
+
+    data[idx++] = (chip_id >> 7) & 0x01;
+    data[idx++] = chip_id & 0x7F;
+    data[idx++] = (ctrl_meas >> 7) & 0x01;
+    data[idx++] = ctrl_meas & 0x7F;
+    data[idx++] = (config >> 7) & 0x01;
+    data[idx++] = config & 0x7F;
+    data[idx++] = (interval_us >> 14) & 0x7F;
+    data[idx++] = (interval_us >> 7) & 0x7F;
+    data[idx++] = interval_us & 0x7F;
+    idx += bulk_pack_8to7(calib, MIDI_CALIB_LEN, &data[idx]);
+
+    midi_sysex_send_raw(CMD_CALIBRATION, data, idx);
+}
+
+void midi_sysex_send_sensor_info(const sensor_caps_t* caps, uint8_t self_test,
+                                 uint8_t channel) {
+    // Format: [chip_id x2][flags][max_rate_hz x2][fifo_samples x2][period_us x3]
+    //         [self_test][name_len][name...][channel]
+    uint8_t data[13 + 16 + 1];
+    uint16_t idx = 0;
+
+    data[idx++] = (caps->chip_id >> 7) & 0x01;
+    data[idx++] = caps->chip_id & 0x7F;
+    data[idx++] = caps->flags & 0x7F;
+    data[idx++] = (caps->max_rate_hz >> 7) & 0x7F;
+    data[idx++] = caps->max_rate_hz & 0x7F;
+    data[idx++] = (caps->fifo_samples >> 7) & 0x7F;
+    data[idx++] = caps->fifo_samples & 0x7F;
+    data[idx++] = (caps->period_us >> 14) & 0x7F;
+    data[idx++] = (caps->period_us >> 7) & 0x7F;
+    data[idx++] = caps->period_us & 0x7F;
+    data[idx++] = self_test & 0x7F;
+
+    // Name (max 16 chars)
+    uint8_t name_len = strlen(caps->name);
+    if (name_len > 16) name_len = 16;
+    data[idx++] = name_len;
+    memcpy(&data[idx], caps->name, name_len);
+    idx += name_len;
+    data[idx++] = channel & 0x01;
+
+    midi_sysex_send_raw(CMD_SENSOR_INFO, data, idx);
+}
+
+bool midi_sysex_send_bulk(uint8_t command, const uint8_t* data, uint16_t len) {
+    return midi_sysex_send_raw(command, data, len);
+}
+
+uint32_t midi_sysex_decode_u32(const uint8_t* src) {
+    return ((uint32_t)(src[0] & 0x0F) << 28) | ((uint32_t)(src[1] & 0x7F) << 21) |
+           ((uint32_t)(src[2] & 0x7F) << 14) | ((uint32_t)(src[3] & 0x7F) << 7) |
+           (uint32_t)(src[4] & 0x7F);
+}
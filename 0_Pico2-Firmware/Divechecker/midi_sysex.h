@@ -16,6 +16,14 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "profiler.h"
+#include "flash_maint.h"
+#include "recorder.h"
+#include "capture.h"
+#include "burst.h"
+#include "sensor.h"
+#include "microbench.h"
+#include "power.h"
 
 // SysEx Protocol Constants
 #define SYSEX_START             0xF0
@@ -28,20 +36,34 @@
 #define CMD_DEVICE_INFO         0x02    // Device info response
 #define CMD_CONFIG              0x03    // Config response (output rate only)
 #define CMD_AUTH_RESPONSE       0x04    // Auth response
+#define CMD_LATENCY_STATS       0x05    // Per-stage latency histogram
 #define CMD_OVERRANGE_ALERT     0x06    // Sensor over-range warning
 #define CMD_TEMPERATURE         0x07    // Temperature data (int16 x100)
 #define CMD_DIAGNOSTICS         0x08    // Runtime diagnostics
 #define CMD_FULL_CONFIG         0x09    // Full config dump
 #define CMD_ACK                 0x0A    // Generic acknowledgment (cmd + status)
+#define CMD_PROFILE_DATA        0x0B    // Cycle profiler table page
+#define CMD_FLASH_STATS         0x0C    // Flash maintenance / wear statistics
+#define CMD_RECORDER_STATUS     0x0D    // Session recorder state and usage
+#define CMD_BULK_INFO           0x0E    // Bulk transfer parameters (reply to BULK_START)
+#define CMD_BULK_DATA           0x0F    // Bulk chunk: seq, crc32, 8-to-7 packed data
 
 // Command bytes (Bidirectional)
 #define CMD_PING                0x10    // Ping request
 #define CMD_PONG                0x11    // Pong response
+#define CMD_CAPTURE_STATUS      0x12    // Capture state (sent on freeze and on query)
+#define CMD_PRESSURE_BATCH      0x13    // Burst mode: batch of raw samples with timing
+#define CMD_RAW_BATCH           0x14    // Raw ADC mode: batch of adc_P/adc_T with timing
+#define CMD_CALIBRATION         0x15    // Sensor calibration block + measurement config
+#define CMD_SENSOR_INFO         0x16    // Sensor capabilities + self-test result
+#define CMD_PRESSURE_DUAL       0x17    // Two sensors: fused + difference (int32 each) + valid mask
+#define CMD_MICROBENCH_RESULT   0x18    // One hot-path benchmark result (microbench.h)
+#define CMD_PRESSURE_STATS      0x19    // Pressure + window min/max/stddev (CMD_SET_PRESSURE_STATS)
 
 // Command bytes (App -> Device)
 #define CMD_REQUEST_INFO        0x20    // Request device info
 #define CMD_SET_NAME            0x21    // Set device name (PIN required)
-#define CMD_SET_OUTPUT_RATE     0x22    // Set output rate (1 byte: 4-50 Hz)
+#define CMD_SET_OUTPUT_RATE     0x22    // Set output rate (1 byte: MIN..MAX_OUTPUT_RATE_HZ)
 #define CMD_RESET_BASELINE      0x23    // Reset baseline
 #define CMD_GET_CONFIG          0x24    // Request full config dump
 #define CMD_SET_LED             0x25    // Set LED brightness (1 byte: 0-100)
@@ -54,11 +76,82 @@
 #define CMD_SET_OVERSAMPLING    0x2C    // Set pressure oversampling (1 byte: 0-5)
 #define CMD_SET_IIR_FILTER      0x2D    // Set IIR filter coefficient (1 byte: 0-4)
 #define CMD_SOFT_REBOOT         0x2E    // Soft reboot via watchdog
+#define CMD_SET_PRESSURE_STATS  0x2F    // Pressure frame format (1 byte: 0 = plain, 1 = stats)
 #define CMD_AUTH_CHALLENGE      0x30    // Auth challenge (32 bytes nonce)
 #define CMD_SET_PIN             0x31    // Set PIN (old PIN + new PIN)
+#define CMD_GET_LATENCY         0x32    // Get latency histogram (1 byte: stage, 0x7F=reset)
+#define CMD_GET_PROFILE         0x33    // Get profiler page (1 byte: page, 0x7F=reset)
+#define CMD_GET_FLASH_STATS     0x34    // Request flash maintenance statistics
+#define CMD_RECORDER_CONTROL    0x35    // Recorder control (1 byte op + optional u32)
+#define CMD_GET_RECORDER_STATUS 0x36    // Request recorder status
+#define CMD_BULK_START          0x37    // Open object (object, offset, chunk, window)
+#define CMD_BULK_ACK            0x38    // Cumulative ACK (next seq x3 + flags)
+#define CMD_BULK_ABORT          0x39    // Cancel bulk transfer
+#define CMD_CAPTURE_CONTROL     0x3A    // Pre/post-trigger capture (1 byte op + args)
+#define CMD_BURST_CONTROL       0x3B    // Full-rate burst streaming (1 byte op + duration)
+#define CMD_GET_CALIBRATION     0x3C    // Request sensor calibration block
+#define CMD_GET_SENSOR_INFO     0x3D    // Request sensor capabilities (op + optional channel)
+#define CMD_SET_DUAL_MODE       0x3E    // Two-sensor output mode (1 byte: DUAL_MODE_*)
+#define CMD_RUN_MICROBENCH      0x3F    // Run the hot-path benchmarks (optional iterations x5)
+#define CMD_LAST                CMD_RUN_MICROBENCH  // Highest assigned command byte
+
+// CMD_GET_LATENCY argument that clears all histograms instead of reading one
+#define LATENCY_RESET_ALL       0x7F
+
+// CMD_GET_PROFILE argument that clears the profiler tables
+#define PROFILE_RESET_ALL       0x7F
+// Profiler rows per CMD_PROFILE_DATA page (27 bytes each)
+#define PROFILE_ROWS_PER_PAGE   8
+
+// CMD_RECORDER_CONTROL operations
+#define RECORDER_OP_STOP        0x00
+#define RECORDER_OP_START       0x01
+#define RECORDER_OP_SET_TRIGGER 0x02    // + 5-byte u32 threshold (hPa x1000), 0 = disarm
+
+// Bulk transfer objects (CMD_BULK_START)
+#define BULK_OBJECT_RECORDER    0x00    // Recorder pages, oldest first
+#define BULK_OBJECT_CAPTURE     0x01    // Frozen capture, [dt_us int32][value int32] per sample
+
+// CMD_CAPTURE_CONTROL operations
+#define CAPTURE_OP_OFF          0x00
+#define CAPTURE_OP_ARM_LEVEL    0x01    // + [level x5][pre x2][post x2]
+#define CAPTURE_OP_ARM_SLOPE    0x02    // + [slope per sample x5][pre x2][post x2]
+#define CAPTURE_OP_REARM        0x03    // Release the frozen capture, same trigger
+#define CAPTURE_OP_STATUS       0x04    // Reply with CMD_CAPTURE_STATUS
+
+// CMD_BURST_CONTROL operations
+#define BURST_OP_STOP           0x00
+#define BURST_OP_START          0x01    // + 5-byte u32 duration (ms, 1-60000)
+#define BURST_OP_START_RAW      0x02    // Same, uncompensated ADC at the sensor rate
+
+// CMD_GET_SENSOR_INFO operations
+#define SENSOR_INFO_OP_CAPS     0x00
+#define SENSOR_INFO_OP_SELF_TEST 0x01   // Run the self-test first
+// CMD_SENSOR_INFO self-test field when none was run
+#define SENSOR_SELF_TEST_NOT_RUN 0x7F
+
+// CMD_SET_OVERSAMPLING value that hands oversampling + IIR to the firmware
+// (any manual oversampling or IIR value leaves auto mode)
+#define OVERSAMPLING_AUTO       0x7F
+
+// CMD_SET_DUAL_MODE modes (a second sensor at 0x77 is optional)
+#define DUAL_MODE_PRIMARY       0x00    // CMD_PRESSURE from the 0x76 sensor only
+#define DUAL_MODE_FUSED         0x01    // CMD_PRESSURE carries the mean of both
+#define DUAL_MODE_BOTH          0x02    // CMD_PRESSURE_DUAL instead of CMD_PRESSURE
+// CMD_PRESSURE_DUAL valid mask
+#define DUAL_VALID_PRIMARY      0x01
+#define DUAL_VALID_SECONDARY    0x02
+
+// BMP280 calibration block (registers 0x88-0x9F, CMD_CALIBRATION)
+#define MIDI_CALIB_LEN          24
+
+// CMD_BULK_ACK flags
+#define BULK_ACK_RETRANSMIT     0x01    // Gap/CRC error: resend from next seq
 
 // SysEx buffer size (needs 150+ bytes for auth signature)
 #define SYSEX_MAX_SIZE          256
+// CMD_PRESSURE message: F0 7D 01 01 [value x5] F7
+#define SYSEX_PRESSURE_FRAME_LEN 10
 
 /**
  * @brief SysEx message structure
@@ -70,6 +163,42 @@ typedef struct {
     bool overflow;                      // Set if data exceeded buffer capacity
 } sysex_message_t;
 
+/**
+ * @brief Auto mode fields of CMD_FULL_CONFIG (21-bit each, clamped)
+ */
+typedef struct {
+    bool enabled;                   // OVERSAMPLING_AUTO in effect
+    uint32_t period_us;             // Measured conversion period (model until measured)
+    uint32_t conversion_noise_mpa;  // RMS per conversion before the IIR, 0 = not measured
+    uint32_t frame_noise_mpa;       // Predicted RMS per output frame, 0 = unknown
+} full_config_auto_t;
+
+// Sensor status byte of CMD_DEVICE_INFO
+#define SENSOR_STATUS_ABSENT    0x00    // Not found; Core 1 keeps retrying
+#define SENSOR_STATUS_READY     0x01
+#define SENSOR_STATUS_STARTING  0x02    // Boot bring-up still in progress
+
+#define BOOT_TIME_PENDING       0x1FFFFF    // Phase not reached yet (21-bit)
+
+/**
+ * @brief Boot-phase timestamps of CMD_DIAGNOSTICS, ms since reset
+ */
+typedef struct {
+    uint32_t usb_init_ms;           // tusb_init() done, host requests serviced
+    uint32_t usb_mounted_ms;        // Host configured the device
+    uint32_t sensor_ready_ms;       // Primary sensor started (Core 1)
+    uint32_t first_frame_ms;        // First pressure frame handed to USB
+} boot_times_t;
+
+/**
+ * @brief Over-range recovery figures of CMD_DIAGNOSTICS (14-bit each)
+ */
+typedef struct {
+    uint16_t last_ms;               // Last over-range reading -> first clean frame
+    uint16_t max_ms;                // Worst since boot
+    uint16_t predicted;             // Events the pressure trend saw coming
+} overrange_stats_t;
+
 /**
  * @brief Initialize MIDI SysEx handler
  */
@@ -88,21 +217,58 @@ bool midi_sysex_receive_byte(uint8_t byte);
  */
 sysex_message_t* midi_sysex_get_message(void);
 
+/**
+ * @brief Build a complete message (F0 7D 01 cmd data F7) without sending it
+ * @param buffer At least SYSEX_MAX_SIZE bytes (data is masked to 7 bits and
+ *               truncated to fit)
+ * @return Message length
+ */
+uint16_t midi_sysex_frame(uint8_t* buffer, uint8_t command, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief Build the CMD_PRESSURE message midi_sysex_send_pressure() sends
+ * @param buffer At least SYSEX_PRESSURE_FRAME_LEN bytes
+ * @return Message length
+ */
+uint16_t midi_sysex_frame_pressure(uint8_t* buffer, int32_t pressure_mhpa);
+
 /**
  * @brief Send pressure data via SysEx
  * @param pressure_mhpa Pressure delta in milli-hPa (hPa * 1000)
+ * @return true if the whole frame was handed to the USB endpoint
+ */
+bool midi_sysex_send_pressure(int32_t pressure_mhpa);
+
+/**
+ * @brief Send pressure with the statistics of its averaging window
+ * @param mean_mhpa Frame value, as in CMD_PRESSURE (milli-hPa)
+ * @param min_mhpa Lowest sample in the window (milli-hPa, no noise floor)
+ * @param max_mhpa Highest sample in the window (milli-hPa, no noise floor)
+ * @param stddev_uhpa Population standard deviation (hPa x 1000000)
+ * @param count Samples averaged
+ * @return true if the whole frame was handed to the USB endpoint
+ */
+bool midi_sysex_send_pressure_stats(int32_t mean_mhpa, int32_t min_mhpa, int32_t max_mhpa,
+                                    uint32_t stddev_uhpa, uint8_t count);
+
+/**
+ * @brief Send both sensor channels via SysEx (DUAL_MODE_BOTH)
+ * @param fused_mhpa Mean of the valid channels' deltas (milli-hPa)
+ * @param diff_mhpa Secondary minus primary delta (0 unless both valid)
+ * @param valid DUAL_VALID_* mask
+ * @return true if the whole frame was handed to the USB endpoint
  */
-void midi_sysex_send_pressure(int32_t pressure_mhpa);
+bool midi_sysex_send_pressure_dual(int32_t fused_mhpa, int32_t diff_mhpa, uint8_t valid);
 
 /**
  * @brief Send device info via SysEx
  * @param serial Serial number string
  * @param name Device name string
  * @param fw_version Firmware version string
- * @param sensor_ok Sensor status
+ * @param sensor_status SENSOR_STATUS_*
  */
 void midi_sysex_send_device_info(const char* serial, const char* name, 
-                                  const char* fw_version, bool sensor_ok);
+                                  const char* fw_version, uint8_t sensor_status);
 
 /**
  * @brief Send config response via SysEx
@@ -135,10 +301,11 @@ void midi_sysex_send_pong(void);
  * @param noise_floor Noise floor threshold x1000
  * @param oversampling BMP280 oversampling control value (0-5)
  * @param iir_filter BMP280 IIR filter coefficient (0-4)
+ * @param autotune Auto mode state and the measurements behind it
  */
 void midi_sysex_send_full_config(uint8_t output_rate, uint8_t led_brightness,
                                   uint8_t noise_floor, uint8_t oversampling,
-                                  uint8_t iir_filter);
+                                  uint8_t iir_filter, const full_config_auto_t* autotune);
 
 /**
  * @brief Send temperature data via SysEx
@@ -153,10 +320,18 @@ void midi_sysex_send_temperature(int16_t temp_x100);
  * @param overrange_count Cumulative over-range event count
  * @param i2c_recovery_count I2C bus recovery count
  * @param cpu_temp_x100 RP2350 internal temp x100 (if available, else 0)
+ * @param health Per-sensor health counters (primary first)
+ * @param sensor_count Sensors present (1 or 2)
+ * @param boot Boot-phase timestamps
+ * @param power Activity ratios and clock governor time-in-state (power.h)
+ * @param overrange Over-range recovery times
  */
 void midi_sysex_send_diagnostics(uint32_t uptime_sec, uint16_t sensor_errors,
                                   uint16_t overrange_count, uint16_t i2c_recovery_count,
-                                  int16_t cpu_temp_x100);
+                                  int16_t cpu_temp_x100,
+                                  const sensor_health_t* health, uint8_t sensor_count,
+                                  const boot_times_t* boot, const power_stats_t* power,
+                                  const overrange_stats_t* overrange);
 
 /**
  * @brief Send generic acknowledgment via SysEx
@@ -165,4 +340,89 @@ void midi_sysex_send_diagnostics(uint32_t uptime_sec, uint16_t sensor_errors,
  */
 void midi_sysex_send_ack(uint8_t cmd_id, uint8_t status);
 
+/**
+ * @brief Send one stage's latency histogram via SysEx
+ * @param stage Pipeline stage index (latency_stage_t)
+ * @param count Number of recorded frames
+ * @param max_us Largest recorded latency in microseconds
+ * @param buckets log2 bucket counts (bucket n = [2^n, 2^(n+1)) us)
+ * @param num_buckets Number of buckets
+ */
+void midi_sysex_send_latency_stats(uint8_t stage, uint32_t count, uint32_t max_us,
+                                    const uint32_t* buckets, uint8_t num_buckets);
+
+/**
+ * @brief Send one microbenchmark result via SysEx
+ * @param index Result index (0-based)
+ * @param count Number of results in this run
+ * @param unit MICROBENCH_UNIT_*
+ */
+void midi_sysex_send_microbench_result(uint8_t index, uint8_t count, uint8_t unit,
+                                       const microbench_result_t* result);
+
+/**
+ * @brief Send one page of the cycle profiler table via SysEx
+ * @param page Page index
+ * @param total_pages Number of pages available
+ * @param rows Non-empty profiler rows for this page
+ * @param num_rows Number of rows (max PROFILE_ROWS_PER_PAGE)
+ */
+void midi_sysex_send_profile_page(uint8_t page, uint8_t total_pages,
+                                   const profiler_row_t* rows, uint8_t num_rows);
+
+/**
+ * @brief Send flash maintenance statistics via SysEx
+ * @param stats Snapshot from flash_maint_get_stats()
+ */
+void midi_sysex_send_flash_stats(const flash_maint_stats_t* stats);
+
+/**
+ * @brief Send session recorder status via SysEx
+ * @param status Snapshot from recorder_get_status()
+ */
+void midi_sysex_send_recorder_status(const recorder_status_t* status);
+
+/**
+ * @brief Send capture status via SysEx
+ * @param status Snapshot from capture_get_status()
+ */
+void midi_sysex_send_capture_status(const capture_status_t* status);
+
+/**
+ * @brief Send a burst batch via SysEx (CMD_PRESSURE_BATCH or CMD_RAW_BATCH)
+ * @return true if the whole frame was queued
+ */
+bool midi_sysex_send_burst_batch(const burst_batch_t* batch);
+
+/**
+ * @brief Send the sensor calibration block via SysEx
+ * @param chip_id Sensor chip ID register
+ * @param ctrl_meas Current ctrl_meas register (oversampling, mode)
+ * @param config Current config register (standby, IIR)
+ * @param interval_us Raw mode sampling interval
+ * @param calib MIDI_CALIB_LEN bytes as read from the sensor (little-endian)
+ */
+void midi_sysex_send_calibration(uint8_t chip_id, uint8_t ctrl_meas, uint8_t config,
+                                 uint32_t interval_us, const uint8_t* calib);
+
+/**
+ * @brief Send sensor capabilities via SysEx
+ * @param caps Snapshot from sensor_get_caps()
+ * @param self_test sensor_self_test_t result, or SENSOR_SELF_TEST_NOT_RUN
+ * @param channel 0 = primary (0x76), 1 = secondary (0x77)
+ */
+void midi_sysex_send_sensor_info(const sensor_caps_t* caps, uint8_t self_test,
+                                 uint8_t channel);
+
+/**
+ * @brief Send a preformatted bulk transfer message (bulk_io_t send hook)
+ * @return true if the whole message was queued
+ */
+bool midi_sysex_send_bulk(uint8_t command, const uint8_t* data, uint16_t len);
+
+/**
+ * @brief Decode a 5-byte 7-bit big-endian u32 (the device's own encoding)
+ */
+uint32_t midi_sysex_decode_u32(const uint8_t* src);
+
 #endif // MIDI_SYSEX_H
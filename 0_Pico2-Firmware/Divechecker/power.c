@@ -0,0 +1,145 @@
+/**
+ * @file power.c
+ * @brief Clock governor, USB suspend state and per-core activity accounting
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "power.h"
+#include "sensor_bus.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+
+// clk_sys = PLL_SYS / divider (150 MHz PLL: 50, 75, 150 MHz)
+static const uint8_t k_pll_divider[POWER_PROFILE_COUNT] = {
+    [POWER_PROFILE_IDLE]      = 3,
+    [POWER_PROFILE_STREAMING] = 2,
+    [POWER_PROFILE_FULL]      = 1,
+    [POWER_PROFILE_CRYPTO]    = 1,
+    [POWER_PROFILE_FLASH]     = 3,
+    [POWER_PROFILE_SUSPEND]   = 3,
+};
+
+#define NO_JOB  POWER_PROFILE_COUNT
+
+typedef struct {
+    uint64_t window_start_us;
+    uint64_t idle_us;               // Slept in the current window
+    volatile uint16_t active_permille;
+} core_activity_t;
+
+static core_activity_t g_activity[2];
+static void (*g_on_clock_change)(void);
+static uint32_t g_pll_hz;           // PLL_SYS output = clk_sys at boot
+static volatile power_profile_t g_workload = POWER_PROFILE_FULL;
+static power_profile_t g_job = NO_JOB;
+static power_profile_t g_active = POWER_PROFILE_FULL;
+static uint64_t g_active_since_us;
+static uint64_t g_state_us[POWER_PROFILE_COUNT];
+static uint16_t g_entries[POWER_PROFILE_COUNT];
+
+void power_init(void (*on_clock_change)(void)) {
+    g_on_clock_change = on_clock_change;
+    g_pll_hz = clock_get_hz(clk_sys);
+    g_active_since_us = time_us_64();
+    g_entries[POWER_PROFILE_FULL] = 1;
+}
+
+/**
+ * @brief Divide clk_sys down from PLL_SYS (or back to 1:1)
+ * @details clk_peri is clk_sys undivided, so the hardware I2C/SPI dividers
+ *          go stale with it: the change happens with the bus idle and
+ *          locked, and the bus re-derives them before anyone else uses it
+ */
+static void set_sys_hz(uint32_t hz) {
+    sensor_bus_begin_clock_change();
+    clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS, g_pll_hz, hz);
+    clock_configure_undivided(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS, hz);
+    sensor_bus_end_clock_change();
+    if (g_on_clock_change != NULL) {
+        g_on_clock_change();
+    }
+}
+
+/**
+ * @brief Count a workload change or job start (not the return from a job)
+ */
+static void count_entry(power_profile_t profile) {
+    if (g_entries[profile] < UINT16_MAX) g_entries[profile]++;
+}
+
+/**
+ * @brief Switch to the job's profile, or the workload's without a job
+ */
+static void apply(void) {
+    if (g_pll_hz == 0) return;  // Boot, before power_init: stays at full
+    power_profile_t profile = (g_job != NO_JOB) ? g_job : g_workload;
+    if (profile == g_active) return;
+
+    uint64_t now = time_us_64();
+    g_state_us[g_active] += now - g_active_since_us;
+    g_active_since_us = now;
+    g_active = profile;
+
+    uint32_t hz = g_pll_hz / k_pll_divider[profile];
+    if (hz != clock_get_hz(clk_sys)) {
+        set_sys_hz(hz);
+    }
+}
+
+void power_set_profile(power_profile_t profile) {
+    if (profile >= POWER_PROFILE_COUNT || profile == g_workload) return;
+    g_workload = profile;
+    count_entry(profile);
+    apply();
+}
+
+power_profile_t power_enter(power_profile_t profile) {
+    power_profile_t token = g_job;
+    g_job = profile;
+    count_entry(profile);
+    apply();
+    return token;
+}
+
+void power_leave(power_profile_t token) {
+    g_job = token;
+    apply();
+}
+
+bool power_is_suspended(void) {
+    return g_workload == POWER_PROFILE_SUSPEND;
+}
+
+void power_idle_us(uint32_t us) {
+    core_activity_t *a = &g_activity[get_core_num()];
+    uint64_t t0 = time_us_64();
+    sleep_us(us);
+    uint64_t t1 = time_us_64();
+    a->idle_us += t1 - t0;
+
+    uint64_t elapsed = t1 - a->window_start_us;
+    if (elapsed >= POWER_WINDOW_US) {
+        uint64_t active = (elapsed > a->idle_us) ? elapsed - a->idle_us : 0;
+        a->active_permille = (uint16_t)(active * 1000 / elapsed);
+        a->window_start_us = t1;
+        a->idle_us = 0;
+    }
+}
+
+void power_get_stats(power_stats_t *stats) {
+    stats->active_permille[0] = g_activity[0].active_permille;
+    stats->active_permille[1] = g_activity[1].active_permille;
+    stats->profile = (uint8_t)g_active;
+    stats->sys_khz = clock_get_hz(clk_sys) / 1000;
+    uint64_t now = time_us_64();
+    for (int p = 0; p < POWER_PROFILE_COUNT; p++) {
+        uint64_t us = g_state_us[p];
+        if (p == (int)g_active) us += now - g_active_since_us;
+        stats->state_ms[p] = (uint32_t)(us / 1000);
+        stats->entries[p] = g_entries[p];
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file power.h
+ * @brief Clock governor (system clock per workload profile), USB suspend
+ *        state and per-core activity accounting
+ *
+ * Core 0 picks a workload profile every main loop iteration
+ * (power_set_profile) and wraps short jobs that want a different clock in
+ * power_enter()/power_leave(); the governor runs clk_sys at that profile's
+ * divider of PLL_SYS:
+ *
+ *   idle        50 MHz   no app streaming: 100 Hz sampling, recorder, USB
+ *   streaming   75 MHz   averaged frames up to the fast-output threshold
+ *   full       150 MHz   bursts, raw ADC, faster output; also until the
+ *                        first decision after boot
+ *   crypto     150 MHz   ECDSA key setup and signing: done sooner
+ *   flash       50 MHz   sector erase: both cores only wait on the chip,
+ *                        which does not run faster with clk_sys
+ *   suspend     50 MHz   bus suspended: Core 1 keep-warm sampling only
+ *
+ * Every clock is divided from the running PLL_SYS, so the PLL stays locked,
+ * switching takes effect at once and nothing runs above the boot clock
+ * (the flash interface divider was set for it). USB and the ADC run from
+ * PLL_USB at 48 MHz and are not affected. clk_peri follows clk_sys, so the
+ * sensor bus is re-timed under its lock and the on_clock_change hook
+ * re-times everything else (the WS2812 PIO).
+ *
+ * Power is not measured directly. Each core sleeps through power_idle_us(),
+ * and the share of each POWER_WINDOW_US it spent awake is reported in
+ * CMD_DIAGNOSTICS together with the time spent in, and the entries into,
+ * each profile.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define POWER_WINDOW_US         1000000     // Activity ratio window
+
+typedef enum {
+    POWER_PROFILE_IDLE = 0,
+    POWER_PROFILE_STREAMING,
+    POWER_PROFILE_FULL,
+    POWER_PROFILE_CRYPTO,
+    POWER_PROFILE_FLASH,
+    POWER_PROFILE_SUSPEND,
+    POWER_PROFILE_COUNT
+} power_profile_t;
+
+typedef struct {
+    uint16_t active_permille[2];    // Per core, last complete window
+    uint8_t profile;                // In effect now
+    uint32_t sys_khz;               // clk_sys now
+    uint32_t state_ms[POWER_PROFILE_COUNT];     // Time in each profile
+    uint16_t entries[POWER_PROFILE_COUNT];      // Chosen as workload / job (saturating)
+} power_stats_t;
+
+/**
+ * @brief Record the boot clock and the re-timing hook (profile: full)
+ * @param on_clock_change Called on Core 0 after every clk_sys change, NULL
+ *                        for none
+ * @note Call once on Core 0 before Core 1 starts
+ */
+void power_init(void (*on_clock_change)(void));
+
+/**
+ * @brief Set the workload profile (Core 0)
+ * @details Takes effect at once unless a power_enter() job is running
+ */
+void power_set_profile(power_profile_t profile);
+
+/**
+ * @brief Run a short job (crypto, flash) under its own profile (Core 0)
+ * @return Token for power_leave(); jobs nest
+ */
+power_profile_t power_enter(power_profile_t profile);
+
+/**
+ * @brief End the job started by power_enter()
+ */
+void power_leave(power_profile_t token);
+
+/**
+ * @brief Whether the workload profile is suspend (either core)
+ */
+bool power_is_suspended(void);
+
+/**
+ * @brief Sleep us on the calling core, counted as idle
+ */
+void power_idle_us(uint32_t us);
+
+/**
+ * @brief Snapshot for CMD_DIAGNOSTICS
+ */
+void power_get_stats(power_stats_t *stats);
+
+#endif // POWER_H
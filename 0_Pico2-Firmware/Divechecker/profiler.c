@@ -0,0 +1,81 @@
+/**
+ * @file profiler.c
+ * @brief Opt-in cycle-accurate function profiler (Cortex-M33 DWT CYCCNT)
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "profiler.h"
+#include "pico/stdlib.h"
+#include <string.h>
+
+#if DIVECHECKER_PROFILER
+
+static profiler_entry_t g_prof[PROFILER_NUM_CORES][PROF_ID_COUNT];
+
+static void profiler_clear_core(uint core) {
+    memset(g_prof[core], 0, sizeof(g_prof[core]));
+    for (int i = 0; i < PROF_ID_COUNT; i++) {
+        g_prof[core][i].min_cycles = UINT32_MAX;
+    }
+}
+
+void profiler_init_core(void) {
+    profiler_clear_core(get_core_num());
+    PROF_DEMCR |= PROF_DEMCR_TRCENA;
+    PROF_DWT_CYCCNT = 0;
+    PROF_DWT_CTRL |= PROF_DWT_CYCCNTENA;
+}
+
+void profiler_record(prof_id_t id, uint32_t cycles) {
+    if ((unsigned)id >= PROF_ID_COUNT) return;
+    profiler_entry_t *e = &g_prof[get_core_num()][id];
+    e->count++;
+    e->total_cycles += cycles;
+    if (cycles < e->min_cycles) e->min_cycles = cycles;
+    if (cycles > e->max_cycles) e->max_cycles = cycles;
+}
+
+void profiler_reset(void) {
+    for (uint core = 0; core < PROFILER_NUM_CORES; core++) {
+        profiler_clear_core(core);
+    }
+}
+
+uint16_t profiler_collect(uint16_t first, profiler_row_t *out, uint16_t max_rows,
+                          uint16_t *total_rows) {
+    uint16_t total = 0;
+    uint16_t copied = 0;
+    for (uint core = 0; core < PROFILER_NUM_CORES; core++) {
+        for (int id = 0; id < PROF_ID_COUNT; id++) {
+            const profiler_entry_t *e = &g_prof[core][id];
+            if (e->count == 0) continue;
+            if (total >= first && copied < max_rows) {
+                out[copied].core = (uint8_t)core;
+                out[copied].id = (uint8_t)id;
+                out[copied].entry = *e;
+                copied++;
+            }
+            total++;
+        }
+    }
+    *total_rows = total;
+    return copied;
+}
+
+#else
+
+void profiler_init_core(void) {}
+void profiler_record(prof_id_t id, uint32_t cycles) { (void)id; (void)cycles; }
+void profiler_reset(void) {}
+
+uint16_t profiler_collect(uint16_t first, profiler_row_t *out, uint16_t max_rows,
+                          uint16_t *total_rows) {
+    (void)first; (void)out; (void)max_rows;
+    *total_rows = 0;
+    return 0;
+}
+
+#endif // DIVECHECKER_PROFILER
@@ -0,0 +1,120 @@
+/**
+ * @file profiler.h
+ * @brief Opt-in cycle-accurate function profiler (Cortex-M33 DWT CYCCNT)
+ *
+ * Build with -DDIVECHECKER_PROFILER=ON to enable. When disabled, the
+ * PROF_BEGIN/PROF_END macros compile to nothing and the table is absent.
+ *
+ * Each core has its own DWT unit and its own row in the table, so the
+ * hot path (profiler_record) is lock-free. Reads from the other core may
+ * observe a half-updated entry; the dump is a diagnostic snapshot only.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef DIVECHECKER_PROFILER
+#define DIVECHECKER_PROFILER 0
+#endif
+
+#define PROFILER_NUM_CORES      2
+#define PROFILER_SYSEX_SLOTS    64      // One slot per command byte 0x00..0x3F; others are not recorded
+
+typedef enum {
+    PROF_TUD_TASK = 0,
+    PROF_MIDI_TASK,
+    PROF_SYSEX_SEND_RAW,
+    PROF_BMP280_READ,
+    PROF_I2C_READ,
+    PROF_FLASH_SAVE,
+    PROF_ECDSA_SIGN,
+    PROF_SYSEX_CMD_BASE,                // midi_process_sysex, + command byte
+    PROF_ID_COUNT = PROF_SYSEX_CMD_BASE + PROFILER_SYSEX_SLOTS
+} prof_id_t;
+
+// Row ids go out as one 7-bit SysEx byte
+_Static_assert(PROF_ID_COUNT <= 0x80, "profiler ids must fit in 7 bits");
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} profiler_entry_t;
+
+/**
+ * @brief One non-empty table row, as reported over SysEx
+ */
+typedef struct {
+    uint8_t core;
+    uint8_t id;
+    profiler_entry_t entry;
+} profiler_row_t;
+
+/// DWT cycle counter (per-core, private peripheral bus; also used by microbench)
+#define PROF_DWT_CTRL       (*(volatile uint32_t *)0xE0001000u)
+#define PROF_DWT_CYCCNT     (*(volatile uint32_t *)0xE0001004u)
+#define PROF_DEMCR          (*(volatile uint32_t *)0xE000EDFCu)
+#define PROF_DEMCR_TRCENA   (1u << 24)
+#define PROF_DWT_CYCCNTENA  (1u << 0)
+
+static inline uint32_t profiler_cycles(void) {
+    return PROF_DWT_CYCCNT;
+}
+
+#if DIVECHECKER_PROFILER
+
+#define PROF_BEGIN(t0)      uint32_t t0 = profiler_cycles()
+#define PROF_END(t0, id)    profiler_record((id), profiler_cycles() - (t0))
+
+#else
+
+#define PROF_BEGIN(t0)      ((void)0)
+#define PROF_END(t0, id)    ((void)0)
+
+#endif // DIVECHECKER_PROFILER
+
+/**
+ * @brief Enable the DWT cycle counter on the calling core
+ * @note Must be called once from each core that records samples
+ */
+void profiler_init_core(void);
+
+/**
+ * @brief Accumulate one measurement for the calling core
+ * @param id Function identifier
+ * @param cycles Elapsed CPU cycles
+ */
+void profiler_record(prof_id_t id, uint32_t cycles);
+
+/**
+ * @brief Clear the tables of both cores
+ */
+void profiler_reset(void);
+
+/**
+ * @brief Copy non-empty rows (core 0 first, then core 1)
+ * @param first Index of the first non-empty row to copy
+ * @param out Destination array
+ * @param max_rows Capacity of out
+ * @param total_rows Set to the total number of non-empty rows
+ * @return Number of rows copied
+ */
+uint16_t profiler_collect(uint16_t first, profiler_row_t *out, uint16_t max_rows,
+                          uint16_t *total_rows);
+
+/**
+ * @brief Whether the profiler was compiled in
+ */
+static inline bool profiler_enabled(void) {
+    return DIVECHECKER_PROFILER != 0;
+}
+
+#endif // PROFILER_H
@@ -0,0 +1,105 @@
+# Build-time product profiles (shared by CMakeLists.txt and host/)
+#
+#   cmake -DDIVECHECKER_PROFILE=standard|highrate|lowpower|research ...
+#
+# A profile fixes the sampling rates, buffer sizes and feature set of one
+# product variant. divechecker_generate_config() writes them, together with
+# the output rate tables derived from them, to divechecker_config.h in the
+# build tree (template: divechecker_config.h.in), so the firmware sees plain
+# constants and table lookups instead of run-time divisions.
+#
+#   profile    internal  output (default)  queue  capture  burst  dual  extras
+#   standard   100 Hz    4-50 Hz (8)       32     2048     256    on
+#   highrate   200 Hz    4-100 Hz (25)     64     4096     512    on
+#   lowpower   50 Hz     2-25 Hz (4)       16     1024     128    off
+#   research   100 Hz    4-50 Hz (8)       64     8192     1024   on    profiler, microbench
+
+set(DIVECHECKER_PROFILES_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(DIVECHECKER_PROFILES standard highrate lowpower research)
+set(DIVECHECKER_PROFILE standard CACHE STRING "Product profile (${DIVECHECKER_PROFILES})")
+set_property(CACHE DIVECHECKER_PROFILE PROPERTY STRINGS ${DIVECHECKER_PROFILES})
+if(NOT DIVECHECKER_PROFILE IN_LIST DIVECHECKER_PROFILES)
+    message(FATAL_ERROR "DIVECHECKER_PROFILE must be one of: ${DIVECHECKER_PROFILES}")
+endif()
+
+# Extras the profile turns on regardless of the DIVECHECKER_<feature> options
+set(DIVECHECKER_PROFILE_PROFILER OFF)
+set(DIVECHECKER_PROFILE_MICROBENCH OFF)
+
+if(DIVECHECKER_PROFILE STREQUAL "standard")
+    set(DC_SAMPLE_RATE_HZ 100)
+    set(DC_DEFAULT_OUTPUT_HZ 8)
+    set(DC_MIN_OUTPUT_HZ 4)
+    set(DC_MAX_OUTPUT_HZ 50)
+    set(DC_PRESSURE_QUEUE 32)
+    set(DC_CAPTURE_SAMPLES 2048)
+    set(DC_BURST_QUEUE 256)
+    set(DC_DUAL_SENSOR 1)
+elseif(DIVECHECKER_PROFILE STREQUAL "highrate")
+    set(DC_SAMPLE_RATE_HZ 200)
+    set(DC_DEFAULT_OUTPUT_HZ 25)
+    set(DC_MIN_OUTPUT_HZ 4)
+    set(DC_MAX_OUTPUT_HZ 100)
+    set(DC_PRESSURE_QUEUE 64)
+    set(DC_CAPTURE_SAMPLES 4096)
+    set(DC_BURST_QUEUE 512)
+    set(DC_DUAL_SENSOR 1)
+elseif(DIVECHECKER_PROFILE STREQUAL "lowpower")
+    set(DC_SAMPLE_RATE_HZ 50)
+    set(DC_DEFAULT_OUTPUT_HZ 4)
+    set(DC_MIN_OUTPUT_HZ 2)
+    set(DC_MAX_OUTPUT_HZ 25)
+    set(DC_PRESSURE_QUEUE 16)
+    set(DC_CAPTURE_SAMPLES 1024)
+    set(DC_BURST_QUEUE 128)
+    set(DC_DUAL_SENSOR 0)
+elseif(DIVECHECKER_PROFILE STREQUAL "research")
+    set(DC_SAMPLE_RATE_HZ 100)
+    set(DC_DEFAULT_OUTPUT_HZ 8)
+    set(DC_MIN_OUTPUT_HZ 4)
+    set(DC_MAX_OUTPUT_HZ 50)
+    set(DC_PRESSURE_QUEUE 64)
+    set(DC_CAPTURE_SAMPLES 8192)
+    set(DC_BURST_QUEUE 1024)
+    set(DC_DUAL_SENSOR 1)
+    set(DIVECHECKER_PROFILE_PROFILER ON)
+    set(DIVECHECKER_PROFILE_MICROBENCH ON)
+endif()
+
+# Limits the firmware relies on: the rate goes out as one SysEx data byte,
+# every frame averages at least one sample, and the capture ring index
+# wraps with a mask-friendly modulo in 16 bits
+if(DC_MIN_OUTPUT_HZ LESS 1 OR DC_MAX_OUTPUT_HZ GREATER 127 OR
+   DC_MAX_OUTPUT_HZ GREATER DC_SAMPLE_RATE_HZ OR
+   DC_DEFAULT_OUTPUT_HZ LESS DC_MIN_OUTPUT_HZ OR DC_DEFAULT_OUTPUT_HZ GREATER DC_MAX_OUTPUT_HZ)
+    message(FATAL_ERROR "DIVECHECKER_PROFILE ${DIVECHECKER_PROFILE}: bad output rate range")
+endif()
+math(EXPR _dc_capture_mask "${DC_CAPTURE_SAMPLES} & (${DC_CAPTURE_SAMPLES} - 1)")
+if(NOT _dc_capture_mask EQUAL 0 OR DC_CAPTURE_SAMPLES GREATER 32768)
+    message(FATAL_ERROR "DIVECHECKER_PROFILE ${DIVECHECKER_PROFILE}: capture ring must be a power of two <= 32768")
+endif()
+
+# Write divechecker_config.h for the selected profile into out_dir
+function(divechecker_generate_config out_dir)
+    math(EXPR DC_MAX_SAMPLES "${DC_SAMPLE_RATE_HZ} / ${DC_MIN_OUTPUT_HZ}")
+    math(EXPR DC_SAMPLE_INTERVAL_US "1000000 / ${DC_SAMPLE_RATE_HZ}")
+    math(EXPR DC_SAMPLE_INTERVAL_MS "1000 / ${DC_SAMPLE_RATE_HZ}")
+
+    # One row per output rate: { interval_ms, interval_us, samples per frame }
+    set(DC_RATE_TABLE "")
+    foreach(rate RANGE ${DC_MIN_OUTPUT_HZ} ${DC_MAX_OUTPUT_HZ})
+        math(EXPR ms "1000 / ${rate}")
+        math(EXPR us "1000000 / ${rate}")
+        math(EXPR samples "${DC_SAMPLE_RATE_HZ} / ${rate}")
+        string(APPEND DC_RATE_TABLE "    { ${ms}, ${us}, ${samples} },  /* ${rate} Hz */ \\\n")
+    endforeach()
+
+    # 1 / n for every frame size the averager can see (n = 0 unused)
+    set(DC_MEAN_SCALE_TABLE "    0.0f, \\\n")
+    foreach(n RANGE 1 ${DC_MAX_SAMPLES})
+        string(APPEND DC_MEAN_SCALE_TABLE "    1.0f / ${n}, \\\n")
+    endforeach()
+
+    configure_file(${DIVECHECKER_PROFILES_DIR}/divechecker_config.h.in
+                   ${out_dir}/divechecker_config.h @ONLY)
+endfunction()
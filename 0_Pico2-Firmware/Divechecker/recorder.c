@@ -0,0 +1,381 @@
+/**
+ * @file recorder.c
+ * @brief On-device session recorder into a ring of flash sectors
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "recorder.h"
+#include "flash_io.h"
+#include "flash_maint.h"
+#include "crc32_dma.h"
+#include "hardware/flash.h"
+#include <string.h>
+
+#define REC_HEADER_SIZE     24
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;
+    uint8_t flags;
+    uint8_t count;          // Samples in this page (first + deltas)
+    uint32_t sequence;      // Monotonic over the whole ring
+    uint16_t session;
+    uint16_t interval_ms;
+    uint32_t t_ms;          // Session time of the first sample
+    int32_t first;          // First sample, hPa x1000
+    uint16_t payload_len;   // Bytes of varint deltas
+    uint16_t crc16;         // Low 16 bits of CRC32 over the page, this field = 0xFFFF
+} rec_page_header_t;
+
+_Static_assert(sizeof(rec_page_header_t) == REC_HEADER_SIZE, "recorder page header size");
+_Static_assert(FLASH_MAINT_DATA_OFFSET + RECORDER_PAGE_SIZE == FLASH_PAGE_SIZE,
+               "a recorded page fills one flash page after the sector header gap");
+_Static_assert(RECORDER_PAGES_PER_SECTOR * FLASH_PAGE_SIZE == FLASH_SECTOR_SIZE,
+               "recorder pages per sector");
+
+static uint32_t g_region_offset = 0;
+static uint16_t g_num_sectors = 0;
+static uint16_t g_head = 0;         // Sector receiving pages
+static uint8_t g_head_slot = 0;     // Next free page slot in the head sector
+static uint16_t g_tail = 0;         // Oldest sector holding pages
+static bool g_has_data = false;
+static uint32_t g_next_seq = 0;
+static uint16_t g_session = 0;
+
+static recorder_state_t g_state = RECORDER_STATE_IDLE;
+static uint32_t g_trigger_x1000 = 0;
+static uint32_t g_headroom_ends = 0;
+static uint32_t g_session_start_ms = 0;
+static uint32_t g_quiet_since_ms = 0;
+static bool g_session_first_page = false;
+
+// Page under construction
+static uint8_t g_page[RECORDER_PAGE_SIZE];
+static uint16_t g_page_len = 0;     // 0 = no page open
+static uint8_t g_page_count = 0;
+static uint8_t g_page_flags = 0;
+static uint16_t g_page_interval = 0;
+static uint32_t g_page_start_ms = 0;
+static int32_t g_page_first = 0;
+static int32_t g_last_value = 0;
+
+static uint32_t ring_sector_offset(uint16_t sector) {
+    return g_region_offset + (uint32_t)sector * FLASH_SECTOR_SIZE;
+}
+
+static uint32_t page_offset(uint16_t sector, uint8_t slot) {
+    return ring_sector_offset(sector) + (uint32_t)slot * FLASH_PAGE_SIZE + FLASH_MAINT_DATA_OFFSET;
+}
+
+static const rec_page_header_t* page_header(uint16_t sector, uint8_t slot) {
+    return (const rec_page_header_t*)flash_io_read_ptr(page_offset(sector, slot));
+}
+
+static uint16_t ring_next(uint16_t sector) {
+    return (uint16_t)((sector + 1) % g_num_sectors);
+}
+
+static uint16_t ring_prev(uint16_t sector) {
+    return (uint16_t)((sector + g_num_sectors - 1) % g_num_sectors);
+}
+
+static inline uint32_t abs_i32(int32_t v) {
+    return (v < 0) ? (uint32_t)(-(int64_t)v) : (uint32_t)v;
+}
+
+/// Zigzag + LEB128 varint, returns bytes written (max 5)
+static uint8_t varint_encode(uint8_t *dst, int32_t delta) {
+    uint32_t zz = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+    uint8_t n = 0;
+    while (zz >= 0x80) {
+        dst[n++] = (uint8_t)(zz | 0x80);
+        zz >>= 7;
+    }
+    dst[n++] = (uint8_t)zz;
+    return n;
+}
+
+/// Sector the head moves to once its current one is full
+static uint16_t head_next_sector(void) {
+    return g_has_data ? ring_next(g_head) : g_head;
+}
+
+/// Whether the next page can be written without erasing in line
+static bool head_has_room(void) {
+    if (g_has_data && g_head_slot < RECORDER_PAGES_PER_SECTOR) return true;
+    return flash_maint_is_erased(ring_sector_offset(head_next_sector()));
+}
+
+/// Make the (erased) head sector ours; overwrites the oldest sector if needed
+static void head_acquire(void) {
+    if (g_has_data && g_head == g_tail) {
+        g_tail = ring_next(g_tail);  // Ring full: oldest sector is lost
+    }
+    flash_maint_take(ring_sector_offset(g_head));
+}
+
+/// End the running session for lack of erased sectors
+static void session_end_full(void) {
+    g_headroom_ends++;
+    g_state = (g_trigger_x1000 > 0) ? RECORDER_STATE_ARMED : RECORDER_STATE_IDLE;
+}
+
+static void page_flush(bool session_end) {
+    if (g_page_len == 0) return;
+
+    if (g_head_slot == RECORDER_PAGES_PER_SECTOR) {
+        g_head = ring_next(g_head);
+        g_head_slot = 0;
+    }
+    if (g_head_slot == 0) {
+        head_acquire();
+    }
+
+    // The last slot of the head sector with nothing erased after it: this
+    // page ends the session. Erasing in line instead would lock Core 1 out
+    // for 100-400 ms, a gap in the very data being recorded.
+    bool full = !session_end && g_head_slot == RECORDER_PAGES_PER_SECTOR - 1 &&
+                !flash_maint_is_erased(ring_sector_offset(ring_next(g_head)));
+    if (session_end || full) g_page_flags |= RECORDER_FLAG_SESSION_END;
+    rec_page_header_t hdr = {
+        .magic = RECORDER_PAGE_MAGIC,
+        .flags = g_page_flags,
+        .count = g_page_count,
+        .sequence = g_next_seq,
+        .session = g_session,
+        .interval_ms = g_page_interval,
+        .t_ms = g_page_start_ms - g_session_start_ms,
+        .first = g_page_first,
+        .payload_len = (uint16_t)(g_page_len - REC_HEADER_SIZE),
+        .crc16 = 0xFFFF,
+    };
+    memcpy(g_page, &hdr, REC_HEADER_SIZE);
+    hdr.crc16 = (uint16_t)crc32_region(0, g_page, g_page_len);
+    memcpy(g_page, &hdr, REC_HEADER_SIZE);
+
+    // Program-only (~1ms lockout); Core 1 rides it out with its lockout grace
+    flash_io_program(page_offset(g_head, g_head_slot), g_page, g_page_len);
+    g_head_slot++;
+    g_has_data = true;
+    g_next_seq++;
+    g_page_len = 0;
+    if (full) session_end_full();
+}
+
+static void page_open(int32_t value, uint32_t now_ms, uint16_t interval_ms) {
+    memset(g_page, 0xFF, sizeof(g_page));
+    g_page_first = value;
+    g_page_len = REC_HEADER_SIZE;
+    g_page_count = 1;
+    g_page_interval = interval_ms;
+    g_page_start_ms = now_ms;
+    g_page_flags = (g_state == RECORDER_STATE_TRIGGERED) ? RECORDER_FLAG_TRIGGERED : 0;
+    if (g_session_first_page) {
+        g_page_flags |= RECORDER_FLAG_SESSION_START;
+        g_session_first_page = false;
+    }
+    g_last_value = value;
+}
+
+static void session_begin(recorder_state_t state, uint32_t now_ms) {
+    g_state = state;
+    g_session++;
+    g_session_start_ms = now_ms;
+    g_quiet_since_ms = now_ms;
+    g_session_first_page = true;
+    g_page_len = 0;
+}
+
+void recorder_init(uint32_t region_offset, uint16_t num_sectors) {
+    g_region_offset = region_offset;
+    g_num_sectors = num_sectors;
+    g_has_data = false;
+    g_head = 0;
+    g_head_slot = 0;
+    g_tail = 0;
+    g_next_seq = 0;
+    g_session = 0;
+    if (num_sectors == 0) return;
+
+    flash_maint_add_region(region_offset, num_sectors);
+
+    // Newest sector = highest page sequence in slot 0 (headers only, no CRC:
+    // reading ~1000 sector headers keeps the boot scan in the low ms)
+    for (uint16_t s = 0; s < num_sectors; s++) {
+        const rec_page_header_t *h = page_header(s, 0);
+        if (h->magic != RECORDER_PAGE_MAGIC) continue;
+        if (!g_has_data || (int32_t)(h->sequence - page_header(g_head, 0)->sequence) > 0) {
+            g_head = s;
+            g_has_data = true;
+        }
+    }
+
+    if (g_has_data) {
+        // Walk back while sequences keep decreasing: that run is the history
+        g_tail = g_head;
+        uint32_t seq = page_header(g_head, 0)->sequence;
+        for (uint16_t s = ring_prev(g_head); s != g_head; s = ring_prev(s)) {
+            const rec_page_header_t *h = page_header(s, 0);
+            if (h->magic != RECORDER_PAGE_MAGIC || (int32_t)(seq - h->sequence) <= 0) break;
+            seq = h->sequence;
+            g_tail = s;
+        }
+
+        const rec_page_header_t *last = NULL;
+        while (g_head_slot < RECORDER_PAGES_PER_SECTOR) {
+            const rec_page_header_t *h = page_header(g_head, g_head_slot);
+            if (h->magic != RECORDER_PAGE_MAGIC) break;
+            last = h;
+            g_head_slot++;
+        }
+        g_next_seq = last->sequence + 1;
+        g_session = last->session;
+    }
+
+    // Claim the history; anything else that is not erased goes back for erase
+    for (uint16_t s = 0; s < num_sectors; s++) {
+        uint32_t off = ring_sector_offset(s);
+        bool in_history = g_has_data &&
+            (uint16_t)((s - g_tail + num_sectors) % num_sectors) <=
+            (uint16_t)((g_head - g_tail + num_sectors) % num_sectors);
+        if (in_history) {
+            flash_maint_claim(off);
+        } else if (!flash_maint_is_erased(off)) {
+            flash_maint_claim(off);
+            flash_maint_release(off);
+        }
+    }
+
+    recorder_task();
+}
+
+void recorder_start(uint32_t now_ms) {
+    if (recorder_is_recording() || g_num_sectors == 0) return;
+    if (!head_has_room()) {
+        g_headroom_ends++;
+        return;
+    }
+    session_begin(RECORDER_STATE_RECORDING, now_ms);
+}
+
+void recorder_stop(void) {
+    if (recorder_is_recording()) {
+        page_flush(true);
+    }
+    g_state = (g_trigger_x1000 > 0) ? RECORDER_STATE_ARMED : RECORDER_STATE_IDLE;
+}
+
+void recorder_set_trigger(uint32_t threshold_x1000) {
+    g_trigger_x1000 = threshold_x1000;
+    if (!recorder_is_recording()) {
+        g_state = (threshold_x1000 > 0 && g_num_sectors > 0) ? RECORDER_STATE_ARMED
+                                                             : RECORDER_STATE_IDLE;
+    }
+}
+
+void recorder_append(int32_t value_x1000, uint32_t now_ms, uint16_t interval_ms) {
+    uint32_t magnitude = abs_i32(value_x1000);
+
+    // An armed trigger waits for headroom quietly (no count per frame)
+    if (g_state == RECORDER_STATE_ARMED && magnitude >= g_trigger_x1000 && head_has_room()) {
+        session_begin(RECORDER_STATE_TRIGGERED, now_ms);
+    }
+    if (!recorder_is_recording()) return;
+
+    if (g_state == RECORDER_STATE_TRIGGERED) {
+        if (magnitude >= g_trigger_x1000) {
+            g_quiet_since_ms = now_ms;
+        } else if (now_ms - g_quiet_since_ms > RECORDER_TRIGGER_HOLDOFF_MS) {
+            recorder_stop();
+            return;
+        }
+    }
+
+    if (g_page_len > 0) {
+        // A rate change or a gap (dropped frames) starts a new page so the
+        // implicit timestamps (t_ms + i * interval) stay exact
+        uint32_t expected_ms = g_page_start_ms + (uint32_t)g_page_count * g_page_interval;
+        int32_t skew = (int32_t)(now_ms - expected_ms);
+        if (interval_ms != g_page_interval || skew > (int32_t)(interval_ms / 2) ||
+            skew < -(int32_t)(interval_ms / 2)) {
+            page_flush(false);
+            if (!recorder_is_recording()) return;  // That page used up the headroom
+        }
+    }
+
+    if (g_page_len > 0) {
+        uint8_t buf[5];
+        uint8_t n = varint_encode(buf, (int32_t)((uint32_t)value_x1000 - (uint32_t)g_last_value));
+        if (g_page_len + n > RECORDER_PAGE_SIZE || g_page_count == UINT8_MAX) {
+            page_flush(false);
+            if (!recorder_is_recording()) return;  // That page used up the headroom
+        } else {
+            memcpy(&g_page[g_page_len], buf, n);
+            g_page_len += n;
+            g_page_count++;
+            g_last_value = value_x1000;
+            return;
+        }
+    }
+    page_open(value_x1000, now_ms, interval_ms);
+}
+
+void recorder_task(void) {
+    if (recorder_is_recording() || !g_has_data) return;
+
+    // Release the oldest sectors that fall inside the headroom window so
+    // flash_maint erases them before the next session needs them
+    uint16_t headroom = (g_num_sectors > RECORDER_HEADROOM_SECTORS + 1) ?
+                        RECORDER_HEADROOM_SECTORS : (uint16_t)(g_num_sectors - 1);
+    while (g_tail != g_head &&
+           (uint16_t)((g_tail - g_head + g_num_sectors) % g_num_sectors) <= headroom) {
+        flash_maint_release(ring_sector_offset(g_tail));
+        g_tail = ring_next(g_tail);
+    }
+}
+
+bool recorder_is_recording(void) {
+    return g_state == RECORDER_STATE_RECORDING || g_state == RECORDER_STATE_TRIGGERED;
+}
+
+uint32_t recorder_page_count(void) {
+    if (!g_has_data) return 0;
+    uint32_t full = (uint16_t)((g_head - g_tail + g_num_sectors) % g_num_sectors);
+    return full * RECORDER_PAGES_PER_SECTOR + g_head_slot;
+}
+
+bool recorder_read_page(uint32_t index, uint8_t *out) {
+    if (index >= recorder_page_count()) return false;
+    uint16_t sector = (uint16_t)((g_tail + index / RECORDER_PAGES_PER_SECTOR) % g_num_sectors);
+    uint8_t slot = (uint8_t)(index % RECORDER_PAGES_PER_SECTOR);
+    memcpy(out, flash_io_read_ptr(page_offset(sector, slot)), RECORDER_PAGE_SIZE);
+    return true;
+}
+
+uint32_t recorder_read(uint32_t offset, uint8_t *dst, uint32_t len) {
+    uint32_t total = recorder_page_count() * RECORDER_PAGE_SIZE;
+    uint32_t copied = 0;
+    while (copied < len && offset < total) {
+        uint32_t index = offset / RECORDER_PAGE_SIZE;
+        uint32_t in_page = offset % RECORDER_PAGE_SIZE;
+        uint32_t n = RECORDER_PAGE_SIZE - in_page;
+        if (n > len - copied) n = len - copied;
+        uint16_t sector = (uint16_t)((g_tail + index / RECORDER_PAGES_PER_SECTOR) % g_num_sectors);
+        uint8_t slot = (uint8_t)(index % RECORDER_PAGES_PER_SECTOR);
+        memcpy(&dst[copied], flash_io_read_ptr(page_offset(sector, slot) + in_page), n);
+        copied += n;
+        offset += n;
+    }
+    return copied;
+}
+
+void recorder_get_status(recorder_status_t *status) {
+    status->state = (uint8_t)g_state;
+    status->session = g_session;
+    status->pages = recorder_page_count();
+    status->capacity_pages = (uint32_t)g_num_sectors * RECORDER_PAGES_PER_SECTOR;
+    status->trigger_x1000 = g_trigger_x1000;
+    status->headroom_ends = g_headroom_ends;
+}
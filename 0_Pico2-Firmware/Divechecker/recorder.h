@@ -0,0 +1,125 @@
+/**
+ * @file recorder.h
+ * @brief On-device session recorder into a ring of flash sectors
+ *
+ * Output frames (hPa x1000 delta, same values as CMD_PRESSURE) are
+ * delta-compressed into self-contained flash pages so a device can record
+ * standalone and be synced later. Sectors come pre-erased from flash_maint,
+ * so recording is program-only (~1ms lockout per page) and Core 1 keeps
+ * sampling throughout. There is no erase while recording: a session that
+ * uses up the erased headroom ends, with RECORDER_FLAG_SESSION_END on its
+ * last page and a count in the status, and a new one starts only once
+ * flash_maint has erased ahead again.
+ *
+ * Page layout (one per 256-byte flash page, after the first 8 bytes which
+ * hold the flash_maint header in page 0 and stay blank elsewhere):
+ *   header (24 B): magic, flags, count, sequence, session, interval_ms,
+ *                  t_ms (session time of first sample), first sample,
+ *                  payload length, crc16 (CRC32 low half over the page
+ *                  with this field set to 0xFFFF)
+ *   payload: zigzag varint deltas of the following samples
+ *
+ * Core 0 only.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RECORDER_PAGE_MAGIC         0x5052      // "RP"
+#define RECORDER_PAGE_SIZE          248         // Bytes per recorded page
+#define RECORDER_PAGES_PER_SECTOR   16
+#define RECORDER_HEADROOM_SECTORS   32          // Kept erased ahead of the head (~128KB)
+#define RECORDER_TRIGGER_HOLDOFF_MS 10000       // Quiet time before a triggered session ends
+
+// Page flags
+#define RECORDER_FLAG_SESSION_START 0x01
+#define RECORDER_FLAG_SESSION_END   0x02
+#define RECORDER_FLAG_TRIGGERED     0x04
+
+typedef enum {
+    RECORDER_STATE_IDLE = 0,
+    RECORDER_STATE_ARMED,           // Waiting for the pressure trigger
+    RECORDER_STATE_RECORDING,       // Started by command
+    RECORDER_STATE_TRIGGERED,       // Started by the pressure trigger
+} recorder_state_t;
+
+typedef struct {
+    uint8_t state;                  // recorder_state_t
+    uint16_t session;               // Current or last session id
+    uint32_t pages;                 // Pages stored (oldest..newest)
+    uint32_t capacity_pages;        // Pages the ring can hold
+    uint32_t trigger_x1000;         // Trigger threshold, 0 = disarmed
+    uint32_t headroom_ends;         // Sessions ended (or refused) with no erased sector left
+} recorder_status_t;
+
+/**
+ * @brief Register the ring with flash_maint and find the newest page
+ * @param region_offset Sector-aligned flash offset of the ring
+ * @param num_sectors Ring size in sectors
+ */
+void recorder_init(uint32_t region_offset, uint16_t num_sectors);
+
+/**
+ * @brief Start a session by command (no-op if already recording, or if no
+ *        erased sector is left: counted in headroom_ends)
+ * @param now_ms Session time base
+ */
+void recorder_start(uint32_t now_ms);
+
+/**
+ * @brief Stop the current session and flush the partial page
+ * @details Returns to ARMED if a trigger threshold is set.
+ */
+void recorder_stop(void);
+
+/**
+ * @brief Arm (threshold > 0) or disarm (0) the pressure trigger
+ * @param threshold_x1000 |delta| in hPa x1000 that starts a session
+ */
+void recorder_set_trigger(uint32_t threshold_x1000);
+
+/**
+ * @brief Feed one output frame or pressure burst sample (Core 0, whether
+ *        or not an app is connected)
+ * @param value_x1000 Pressure delta, hPa x1000
+ * @param now_ms Time the frame was produced
+ * @param interval_ms Current output interval
+ */
+void recorder_append(int32_t value_x1000, uint32_t now_ms, uint16_t interval_ms);
+
+/**
+ * @brief Keep erase headroom ahead of the head while not recording
+ * @details Only releases sectors: flash_maint_task() erases them
+ */
+void recorder_task(void);
+
+bool recorder_is_recording(void);
+
+void recorder_get_status(recorder_status_t *status);
+
+/**
+ * @brief Number of stored pages, oldest first
+ */
+uint32_t recorder_page_count(void);
+
+/**
+ * @brief Copy one stored page (RECORDER_PAGE_SIZE bytes)
+ * @param index 0 = oldest page
+ * @return false if index is out of range
+ */
+bool recorder_read_page(uint32_t index, uint8_t *out);
+
+/**
+ * @brief Byte view over the stored pages (page i at i * RECORDER_PAGE_SIZE)
+ * @return Bytes copied (short at the end of the data)
+ */
+uint32_t recorder_read(uint32_t offset, uint8_t *dst, uint32_t len);
+
+#endif // RECORDER_H
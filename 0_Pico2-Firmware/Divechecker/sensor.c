@@ -0,0 +1,102 @@
+/**
+ * @file sensor.c
+ * @brief Pressure sensor driver interface: probing and dispatch
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sensor.h"
+#include <stdio.h>
+#include "tusb_config.h"
+
+// Probe order: the BMP280 ID register (0xD0) is reserved on BMP3xx and the
+// BMP3xx one (0x00) is reserved on BMP280, so neither aliases the other
+static const sensor_driver_t *const g_drivers[] = {
+    &sensor_bmp280_driver,
+    &sensor_bmp3xx_driver,
+};
+
+bool sensor_open(sensor_t *s, uint8_t addr, const sensor_config_t *config) {
+    s->driver = NULL;
+    s->addr = addr;
+    for (size_t i = 0; i < sizeof(g_drivers) / sizeof(g_drivers[0]); i++) {
+        uint8_t chip_id;
+        if (!g_drivers[i]->probe(addr, &chip_id)) continue;
+
+        #if CFG_TUD_CDC
+        printf("INFO:ChipID=0x%02X (%s)\n", chip_id, g_drivers[i]->name);
+        #endif
+        s->chip_id = chip_id;
+        s->config = *config;
+        if (!g_drivers[i]->init(s, config)) {
+            return false;
+        }
+        s->driver = g_drivers[i];
+        return true;
+    }
+    #if CFG_TUD_CDC
+    printf("ERR:No known sensor at 0x%02X\n", addr);
+    #endif
+    return false;
+}
+
+bool sensor_configure(sensor_t *s, const sensor_config_t *config) {
+    if (s->driver == NULL) return false;
+    if (!s->driver->configure(s, config)) return false;
+    s->config = *config;
+    return true;
+}
+
+bool sensor_reset(sensor_t *s) {
+    return s->driver != NULL && s->driver->reset(s);
+}
+
+int sensor_read_batch(sensor_t *s, sensor_sample_t *out, int max) {
+    if (s->driver == NULL) return -1;
+    if (max > SENSOR_BATCH_MAX) max = SENSOR_BATCH_MAX;
+    return s->driver->read_batch(s, out, max);
+}
+
+sensor_self_test_t sensor_self_test(sensor_t *s) {
+    if (s->driver == NULL) return SENSOR_SELF_TEST_NO_RESPONSE;
+    return s->driver->self_test(s);
+}
+
+void sensor_get_caps(const sensor_t *s, sensor_caps_t *caps) {
+    if (s->driver == NULL) {
+        *caps = (sensor_caps_t){ .name = "none" };
+        return;
+    }
+    s->driver->get_caps(s, caps);
+}
+
+uint32_t sensor_period_us(const sensor_t *s, const sensor_config_t *config) {
+    return s->driver != NULL ? s->driver->period_us(config) : 0;
+}
+
+bool sensor_read_raw(sensor_t *s, int32_t *adc_P, int32_t *adc_T) {
+    return s->driver != NULL && s->driver->read_raw != NULL &&
+           s->driver->read_raw(s, adc_P, adc_T);
+}
+
+bool sensor_get_calibration(const sensor_t *s, sensor_calibration_t *calib) {
+    return s->driver != NULL && s->driver->get_calibration != NULL &&
+           s->driver->get_calibration(s, calib);
+}
+
+bool sensor_standby(sensor_t *s, bool on) {
+    return s->driver != NULL && s->driver->standby != NULL &&
+           s->driver->standby(s, on);
+}
+
+bool sensor_trigger(sensor_t *s) {
+    return s->driver != NULL && s->driver->trigger != NULL &&
+           s->driver->trigger(s);
+}
+
+bool sensor_filter_bypass(sensor_t *s, bool on) {
+    return s->driver != NULL && s->driver->filter_bypass != NULL &&
+           s->driver->filter_bypass(s, on);
+}
@@ -0,0 +1,248 @@
+/**
+ * @file sensor.h
+ * @brief Pressure sensor driver interface
+ *
+ * The sampling loop talks to a sensor_t, never to a specific part. Each
+ * backend (sensor_bmp280.c, sensor_bmp3xx.c) fills a sensor_driver_t;
+ * sensor_open() probes them in turn at the given bus address and keeps the
+ * first that answers with a known chip ID.
+ *
+ *   init        - soft reset, read trimming data, apply the configuration
+ *   configure   - change oversampling / IIR / rate on a running sensor
+ *   read_batch  - every measurement since the last call: one register read
+ *                 on parts without a FIFO, a single FIFO drain otherwise
+ *   self_test   - ID, trimming data and a plausibility read
+ *   get_caps    - what the part can do and how it is configured right now
+ *   period_us   - measurement period a configuration would give (no bus
+ *                 traffic; the auto-tuner compares candidates with it)
+ *   standby     - optional: stop continuous conversions, or resume them;
+ *                 trimming, configuration and the IIR filter memory stay
+ *   trigger     - optional, in standby: one forced conversion, which
+ *                 read_batch returns once period_us has passed
+ *   filter_bypass - optional: IIR filter off (on) or back to the configured
+ *                 coefficient, with no reset and no settle wait; readings
+ *                 follow the pressure from the next conversion on
+ *
+ * Raw ADC mode needs read_raw and get_calibration (SENSOR_CAP_RAW_ADC);
+ * keep-warm sampling during USB suspend needs standby and trigger
+ * (SENSOR_CAP_STANDBY); fast over-range recovery needs filter_bypass
+ * (SENSOR_CAP_FILTER_BYPASS). Backends without them leave the pointers NULL.
+ *
+ * Threading: Core 1 calls read_batch/read_raw; Core 0 calls configure,
+ * reset and self_test while Core 1 skips reads (g_sensor_reconfiguring).
+ * The bus itself is serialized by sensor_bus.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SENSOR_BATCH_MAX        32      // Samples per read_batch call
+#define SENSOR_CALIB_MAX        24      // Raw trimming block (BMP280: 0x88-0x9F)
+#define SENSOR_PRIV_WORDS       20      // Backend state (160 bytes, 8-byte aligned)
+
+// Capability flags
+#define SENSOR_CAP_FIFO         0x01    // read_batch drains an on-chip FIFO
+#define SENSOR_CAP_RAW_ADC      0x02    // read_raw + get_calibration (raw ADC mode)
+#define SENSOR_CAP_STANDBY      0x04    // standby + trigger (keep-warm sampling)
+#define SENSOR_CAP_FILTER_BYPASS 0x08   // filter_bypass (fast over-range recovery)
+
+// Self-test plausibility window (the sampling loop's own validity range)
+#define SENSOR_PLAUSIBLE_MIN_HPA    300.0f
+#define SENSOR_PLAUSIBLE_MAX_HPA    1250.0f
+#define SENSOR_PLAUSIBLE_MIN_X100   (-4000)     // -40 °C
+#define SENSOR_PLAUSIBLE_MAX_X100   8500        // +85 °C
+
+typedef enum {
+    SENSOR_SELF_TEST_PASS = 0,
+    SENSOR_SELF_TEST_NO_RESPONSE,       // Bus error or chip ID changed
+    SENSOR_SELF_TEST_BAD_CALIB,         // Trimming data blank or changed since init
+    SENSOR_SELF_TEST_DEVICE_ERROR,      // Part reports an internal error
+    SENSOR_SELF_TEST_IMPLAUSIBLE,       // Reading outside physical limits
+} sensor_self_test_t;
+
+/**
+ * @brief Measurement configuration (same codes as the SysEx commands)
+ */
+typedef struct {
+    uint8_t oversampling;       // 0=skip,1=x1,2=x2,3=x4,4=x8,5=x16
+    uint8_t iir;                // 0=off,1=x2,2=x4,3=x8,4=x16
+    uint16_t rate_hz;           // Sample rate the caller consumes
+} sensor_config_t;
+
+typedef struct {
+    float pressure_hpa;         // NAN = skipped or invalid measurement
+    int16_t temperature_x100;   // °C x100
+    uint32_t t_us;              // Measurement time (time_us_32)
+} sensor_sample_t;
+
+typedef struct {
+    const char *name;
+    uint8_t chip_id;
+    uint8_t flags;              // SENSOR_CAP_*
+    uint16_t max_rate_hz;       // Fastest output data rate of the part
+    uint16_t fifo_samples;      // Samples the FIFO holds, 0 = no FIFO
+    uint32_t period_us;         // Measurement period of the current config
+} sensor_caps_t;
+
+/**
+ * @brief Per-sensor health counters (saturating, CMD_DIAGNOSTICS)
+ */
+typedef struct {
+    uint16_t bus_errors;        // read_batch failures
+    uint16_t invalid_samples;   // NAN or outside the plausible window
+    uint16_t resets;            // Reinitializations after a run of invalid samples
+} sensor_health_t;
+
+/**
+ * @brief Raw trimming block and measurement registers (CMD_CALIBRATION)
+ */
+typedef struct {
+    uint8_t ctrl_meas;
+    uint8_t config;
+    uint8_t block[SENSOR_CALIB_MAX];
+} sensor_calibration_t;
+
+typedef struct sensor sensor_t;
+
+typedef struct {
+    const char *name;
+    bool (*probe)(uint8_t addr, uint8_t *chip_id);
+    bool (*init)(sensor_t *s, const sensor_config_t *config);
+    bool (*configure)(sensor_t *s, const sensor_config_t *config);
+    bool (*reset)(sensor_t *s);         // Soft reset, same configuration (clears IIR)
+    int  (*read_batch)(sensor_t *s, sensor_sample_t *out, int max);
+    sensor_self_test_t (*self_test)(sensor_t *s);
+    void (*get_caps)(const sensor_t *s, sensor_caps_t *caps);
+    uint32_t (*period_us)(const sensor_config_t *config);
+    // Optional (SENSOR_CAP_RAW_ADC)
+    bool (*read_raw)(sensor_t *s, int32_t *adc_P, int32_t *adc_T);
+    bool (*get_calibration)(const sensor_t *s, sensor_calibration_t *calib);
+    // Optional (SENSOR_CAP_STANDBY)
+    bool (*standby)(sensor_t *s, bool on);
+    bool (*trigger)(sensor_t *s);
+    // Optional (SENSOR_CAP_FILTER_BYPASS)
+    bool (*filter_bypass)(sensor_t *s, bool on);
+} sensor_driver_t;
+
+struct sensor {
+    const sensor_driver_t *driver;      // NULL until sensor_open succeeds
+    uint8_t addr;
+    uint8_t chip_id;
+    sensor_config_t config;             // Last applied
+    uint64_t priv[SENSOR_PRIV_WORDS];   // Backend state
+};
+
+extern const sensor_driver_t sensor_bmp280_driver;
+extern const sensor_driver_t sensor_bmp3xx_driver;
+
+/**
+ * @brief Probe the backends at addr and initialize the first match
+ * @return false if nothing known answered or init failed
+ */
+bool sensor_open(sensor_t *s, uint8_t addr, const sensor_config_t *config);
+
+bool sensor_configure(sensor_t *s, const sensor_config_t *config);
+bool sensor_reset(sensor_t *s);
+
+/**
+ * @brief Measurements since the last call, oldest first
+ * @return Number of samples, 0 if none is ready yet, -1 on a bus error
+ */
+int sensor_read_batch(sensor_t *s, sensor_sample_t *out, int max);
+
+sensor_self_test_t sensor_self_test(sensor_t *s);
+void sensor_get_caps(const sensor_t *s, sensor_caps_t *caps);
+
+/**
+ * @brief Measurement period the part would run at with config
+ * @return 0 without a sensor
+ */
+uint32_t sensor_period_us(const sensor_t *s, const sensor_config_t *config);
+
+/**
+ * @brief Uncompensated ADC codes (raw ADC mode)
+ * @return false on a bus error, a skipped measurement or no SENSOR_CAP_RAW_ADC
+ */
+bool sensor_read_raw(sensor_t *s, int32_t *adc_P, int32_t *adc_T);
+
+bool sensor_get_calibration(const sensor_t *s, sensor_calibration_t *calib);
+
+/**
+ * @brief Enter (on) or leave standby (see the driver list above)
+ * @return false on a bus error or without SENSOR_CAP_STANDBY
+ */
+bool sensor_standby(sensor_t *s, bool on);
+
+/**
+ * @brief Start one conversion while in standby
+ * @return false on a bus error or without SENSOR_CAP_STANDBY
+ */
+bool sensor_trigger(sensor_t *s);
+
+/**
+ * @brief Turn the IIR filter off (on) or back on (see the driver list above)
+ * @details s->config is not changed: configure/reset apply the filter again
+ * @return false on a bus error or without SENSOR_CAP_FILTER_BYPASS
+ */
+bool sensor_filter_bypass(sensor_t *s, bool on);
+
+/**
+ * @brief Statistics of one output frame's samples (hPa)
+ */
+typedef struct {
+    float mean;
+    float min;
+    float max;
+    float variance;         // Population variance (hPa^2)
+} sensor_frame_stats_t;
+
+/**
+ * @brief Mean, extremes and variance of one output frame in one pass
+ * @details The sums run relative to the first sample: squares of the
+ *          absolute ~1000 hPa values would drown the sub-Pa spread in
+ *          float rounding
+ * @param count Number of samples, > 0
+ * @param scale 1.0f / count, from a table (no division per frame)
+ */
+static inline void sensor_frame_stats(const float *samples, int count, float scale,
+                                      sensor_frame_stats_t *out) {
+    float ref = samples[0];
+    float lo = ref, hi = ref;
+    float sum = 0, sum_sq = 0;
+    for (int i = 0; i < count; i++) {
+        float x = samples[i];
+        float d = x - ref;
+        sum += d;
+        sum_sq += d * d;
+        if (x < lo) lo = x;
+        if (x > hi) hi = x;
+    }
+    float mean_d = sum * scale;
+    float variance = sum_sq * scale - mean_d * mean_d;
+    out->mean = ref + mean_d;
+    out->min = lo;
+    out->max = hi;
+    out->variance = (variance > 0) ? variance : 0;
+}
+
+/**
+ * @brief Mean of one output frame's samples (second sensor's averager)
+ * @param count Number of samples, > 0
+ * @param scale 1.0f / count, from a table (no division per frame)
+ */
+static inline float sensor_mean(const float *samples, int count, float scale) {
+    float sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    return sum * scale;
+}
+
+#endif // SENSOR_H
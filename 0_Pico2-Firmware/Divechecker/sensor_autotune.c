@@ -0,0 +1,141 @@
+/**
+ * @file sensor_autotune.c
+ * @brief Oversampling / IIR auto mode from measured noise and conversion rate
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sensor_autotune.h"
+#include "hardware/sync.h"
+#include <math.h>
+
+#define OVERSAMPLING_MAX    5       // x16
+#define IIR_MAX             4       // Coefficient 16
+
+// Samples to reach 75% of a step (BMP280 datasheet table 6), per IIR code
+static const uint8_t k_iir_settle[IIR_MAX + 1] = { 1, 2, 5, 11, 22 };
+
+// Core 1 working state
+static uint32_t g_start_us = 0;
+static uint32_t g_first_fresh_us = 0;
+static uint32_t g_last_fresh_us = 0;
+static uint32_t g_conversions = 0;
+static uint32_t g_diffs = 0;
+static float g_diff_sq_sum = 0.0f;
+static float g_last_hpa = 0.0f;
+
+// Shared (Core 1 fills the copy, then sets the flag; Core 0 clears it)
+static autotune_measurement_t g_published;
+static volatile bool g_published_ready = false;
+
+static inline uint8_t oversampling_factor(uint8_t code) {
+    return (uint8_t)(1u << (code - 1));     // 1..5 -> x1..x16
+}
+
+void autotune_core1_restart(void) {
+    g_conversions = 0;
+    g_diffs = 0;
+    g_diff_sq_sum = 0.0f;
+}
+
+void autotune_core1_sample(float pressure_hpa, uint32_t t_us, bool fresh_always) {
+    if (g_conversions == 0) {
+        g_start_us = t_us;
+        g_first_fresh_us = t_us;
+        g_last_fresh_us = t_us;
+        g_last_hpa = pressure_hpa;
+        g_conversions = 1;
+        return;
+    }
+
+    // A polled part returns the same result until its next conversion
+    if (fresh_always || pressure_hpa != g_last_hpa) {
+        float d = pressure_hpa - g_last_hpa;
+        if (fabsf(d) < AUTOTUNE_QUIET_HPA) {
+            g_diff_sq_sum += d * d;
+            g_diffs++;
+        }
+        g_last_hpa = pressure_hpa;
+        g_last_fresh_us = t_us;
+        g_conversions++;
+    }
+
+    if (t_us - g_start_us < AUTOTUNE_WINDOW_US) return;
+
+    // Too much breath in the window to see the noise: just try again
+    if (g_diffs >= AUTOTUNE_MIN_DIFFS && g_conversions > 1 && !g_published_ready) {
+        g_published.period_us = (g_last_fresh_us - g_first_fresh_us) / (g_conversions - 1);
+        // Without the IIR correction here: Core 0 knows the coefficient
+        g_published.noise_var_hpa2 = g_diff_sq_sum / (float)g_diffs;
+        __dmb();
+        g_published_ready = true;
+    }
+    autotune_core1_restart();
+}
+
+bool autotune_take_measurement(autotune_measurement_t *m) {
+    if (!g_published_ready) return false;
+    __dmb();
+    m->period_us = g_published.period_us;
+    m->noise_var_hpa2 = g_published.noise_var_hpa2;
+    __dmb();
+    g_published_ready = false;
+    return true;
+}
+
+void autotune_choose(const sensor_t *s, const autotune_measurement_t *m,
+                     const sensor_config_t *current, uint32_t frame_us,
+                     autotune_result_t *out) {
+    uint32_t poll_us = current->rate_hz ? 1000000u / current->rate_hz : 0;
+
+    // Measured / model period, only where the measurement can see it (a
+    // part converting faster than it is polled just looks poll-limited)
+    float scale = 1.0f;
+    float var_x1 = 0.0f;
+    if (m != NULL) {
+        uint32_t model_us = sensor_period_us(s, &m->config);
+        if (model_us > poll_us + poll_us / 4 && m->period_us > 0) {
+            scale = (float)m->period_us / (float)model_us;
+            if (scale < 0.5f) scale = 0.5f;
+            if (scale > 1.5f) scale = 1.5f;
+        }
+        uint8_t iir = (m->config.iir > IIR_MAX) ? IIR_MAX : m->config.iir;
+        uint8_t osrs = m->config.oversampling;
+        if (osrs >= 1 && osrs <= OVERSAMPLING_MAX) {
+            float c = (float)(1u << iir);
+            var_x1 = m->noise_var_hpa2 * c * (2.0f * c - 1.0f) * 0.5f * oversampling_factor(osrs);
+        }
+    }
+
+    // Fallback: x1, no filter (always feasible at the output rates we allow)
+    float best_score = 0.0f;
+    out->config = *current;
+    out->config.oversampling = 1;
+    out->config.iir = 0;
+    out->period_us = 0;
+
+    for (uint8_t osrs = 1; osrs <= OVERSAMPLING_MAX; osrs++) {
+        sensor_config_t candidate = *current;
+        candidate.oversampling = osrs;
+        uint32_t period_us = (uint32_t)((float)sensor_period_us(s, &candidate) * scale);
+        if (period_us < poll_us) period_us = poll_us;
+        if (period_us == 0 || period_us > frame_us) continue;
+        uint32_t n = frame_us / period_us;
+
+        for (uint8_t iir = 0; iir <= IIR_MAX; iir++) {
+            if ((uint32_t)k_iir_settle[iir] * period_us > frame_us) break;
+            // Inverse of the predicted frame variance (in units of var_x1)
+            float score = (float)oversampling_factor(osrs) * (float)(n + (2u << iir) - 2u);
+            if (score > best_score) {   // Ties keep the cheaper, faster setting
+                best_score = score;
+                out->config.oversampling = osrs;
+                out->config.iir = iir;
+                out->period_us = period_us;
+            }
+        }
+    }
+
+    out->frame_noise_hpa = (best_score > 0.0f && var_x1 > 0.0f) ? sqrtf(var_x1 / best_score) : 0.0f;
+}
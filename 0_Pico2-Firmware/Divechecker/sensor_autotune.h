@@ -0,0 +1,87 @@
+/**
+ * @file sensor_autotune.h
+ * @brief Oversampling / IIR auto mode from measured noise and conversion rate
+ *
+ * Core 1 feeds every valid primary reading in. Over a window of
+ * AUTOTUNE_WINDOW_US it counts fresh conversions (each FIFO sample; a
+ * polled reading that differs from the previous one) and collects the
+ * differences between successive conversions that are small enough to be
+ * noise rather than breath. At the end of the window it publishes:
+ *
+ *   period_us  - measured time between fresh conversions
+ *   noise_var  - per-conversion variance before the sensor's IIR filter,
+ *                from the difference variance (an IIR of coefficient c
+ *                leaves 2 / (c * (2c - 1)) of the input variance in the
+ *                successive differences)
+ *
+ * Core 0 then scores every oversampling x IIR pair against the output
+ * frame. A candidate must deliver at least one fresh conversion per frame
+ * and settle its IIR (75% of a step) within one frame; among those the
+ * lowest predicted frame variance wins:
+ *
+ *   var_frame = var_x1 / (os * (n + 2c - 2))
+ *
+ * with os the oversampling factor, n the fresh conversions per frame and
+ * c the IIR coefficient (n samples of an IIR output, 1/(2c - 1) at n = 1,
+ * 1/n without a filter). Model periods come from the driver and are
+ * scaled by measured / model for the current configuration, so a part
+ * that converts faster than the datasheet maximum gets credit for it.
+ * Standby stays at the driver's minimum: a longer one only drops
+ * conversions from the frame average.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef SENSOR_AUTOTUNE_H
+#define SENSOR_AUTOTUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sensor.h"
+
+#define AUTOTUNE_WINDOW_US      2000000 // Measurement window
+#define AUTOTUNE_MIN_DIFFS      16      // Quiet conversion pairs a window needs
+#define AUTOTUNE_QUIET_HPA      0.05f   // Larger steps are signal, not noise
+#define AUTOTUNE_PASSES         2       // Windows evaluated per (re)tune
+
+typedef struct {
+    sensor_config_t config;     // Configuration it was measured under (Core 0 fills)
+    uint32_t period_us;         // Measured time between fresh conversions
+    float noise_var_hpa2;       // Per-conversion variance before the IIR
+} autotune_measurement_t;
+
+typedef struct {
+    sensor_config_t config;     // Chosen oversampling / IIR (rate_hz unchanged)
+    uint32_t period_us;         // Predicted conversion period
+    float frame_noise_hpa;      // Predicted RMS per output frame, 0 = unknown
+} autotune_result_t;
+
+/**
+ * @brief Core 1: one valid reading
+ * @param fresh_always true on FIFO parts (every sample is a new conversion)
+ */
+void autotune_core1_sample(float pressure_hpa, uint32_t t_us, bool fresh_always);
+
+/**
+ * @brief Core 1: drop the current window (sensor reconfigured or reset)
+ */
+void autotune_core1_restart(void);
+
+/**
+ * @brief Core 0: take the last published window, if there is a new one
+ */
+bool autotune_take_measurement(autotune_measurement_t *m);
+
+/**
+ * @brief Pick the lowest-noise configuration for an output frame
+ * @param m Measurement of the running configuration, NULL if none yet
+ *          (datasheet periods, no noise estimate)
+ * @param current Running configuration (rate_hz is kept in the result)
+ */
+void autotune_choose(const sensor_t *s, const autotune_measurement_t *m,
+                     const sensor_config_t *current, uint32_t frame_us,
+                     autotune_result_t *out);
+
+#endif // SENSOR_AUTOTUNE_H
@@ -0,0 +1,323 @@
+/**
+ * @file sensor_bmp280.c
+ * @brief BMP280 / BME280 backend (polled, no FIFO)
+ *
+ * One 6-byte burst read per sample from the data registers; the part runs
+ * in normal mode and the caller polls it at its own rate. The compensation
+ * is shared with the host tools (bmp280_compensate.h).
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sensor.h"
+#include "sensor_bus.h"
+#include "bmp280_compensate.h"
+#include "pico/stdlib.h"
+#include "tusb_config.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define BMP280_CHIP_ID          0x58
+#define BME280_CHIP_ID          0x60
+
+#define BMP280_REG_ID           0xD0
+#define BMP280_REG_RESET        0xE0
+#define BMP280_REG_CTRL_MEAS    0xF4
+#define BMP280_REG_CONFIG       0xF5
+#define BMP280_REG_PRESS_MSB    0xF7
+#define BMP280_REG_CALIB_START  0x88
+
+#define BMP280_RESET_VALUE      0xB6
+#define BMP280_STARTUP_MS       2       // t_startup, also after a soft reset
+#define BMP280_ADC_SKIPPED      0x80000 // Measurement skipped/invalid
+
+typedef struct {
+    bmp280_calib_t calib;
+    uint8_t calib_raw[BMP280_CALIB_LEN];    // As read, for CMD_CALIBRATION
+    uint8_t ctrl_meas;                      // Last written ctrl_meas
+    uint8_t config_reg;
+} bmp280_priv_t;
+
+_Static_assert(sizeof(bmp280_priv_t) <= sizeof(((sensor_t *)0)->priv),
+               "BMP280 state must fit sensor_t");
+_Static_assert(BMP280_CALIB_LEN <= SENSOR_CALIB_MAX, "calibration block size");
+
+static inline bmp280_priv_t *priv(sensor_t *s) {
+    return (bmp280_priv_t *)s->priv;
+}
+
+static inline const bmp280_priv_t *priv_c(const sensor_t *s) {
+    return (const bmp280_priv_t *)s->priv;
+}
+
+/**
+ * @brief Normal-mode measurement period for a ctrl_meas value
+ * @details Datasheet maximum conversion time plus the 0.5ms standby this
+ *          firmware always uses; reading faster only returns repeats.
+ */
+static uint32_t bmp280_period_us(uint8_t ctrl_meas) {
+    static const uint8_t oversampling[8] = { 0, 1, 2, 4, 8, 16, 16, 16 };
+    uint8_t os_t = oversampling[(ctrl_meas >> 5) & 0x07];
+    uint8_t os_p = oversampling[(ctrl_meas >> 2) & 0x07];
+    uint32_t t_us = 1250 + 2300u * os_t;
+    if (os_p > 0) {
+        t_us += 2300u * os_p + 575;
+    }
+    return t_us + 500;
+}
+
+/**
+ * @brief ctrl_meas for a configuration: osrs_t[7:5]=x2(0b010),
+ *        osrs_p[4:2]=variable, mode[1:0]=normal(0b11)
+ */
+static uint8_t bmp280_ctrl_meas(const sensor_config_t *config) {
+    uint8_t osrs = config->oversampling;
+    if (osrs > 5) osrs = 5;
+    return (uint8_t)((0x02 << 5) | (osrs << 2) | 0x03);
+}
+
+static uint32_t bmp280_config_period_us(const sensor_config_t *config) {
+    return bmp280_period_us(bmp280_ctrl_meas(config));
+}
+
+static bool bmp280_probe(uint8_t addr, uint8_t *chip_id) {
+    if (!sensor_bus_read(addr, BMP280_REG_ID, chip_id, 1)) {
+        return false;
+    }
+    return *chip_id == BMP280_CHIP_ID || *chip_id == BME280_CHIP_ID;
+}
+
+/**
+ * @brief Write oversampling + IIR filter (sleep mode first: config is
+ *        only writable while the part is asleep)
+ */
+static bool bmp280_write_config(sensor_t *s, const sensor_config_t *config) {
+    uint8_t iir = config->iir;
+    if (iir > 4) iir = 4;
+
+    uint8_t ctrl_meas = bmp280_ctrl_meas(config);
+    // config: t_sb[7:5]=0.5ms(0b000), filter[4:2]=variable, spi3w_en=0
+    uint8_t config_reg = (iir << 2);
+
+    // Enter sleep mode first
+    if (!sensor_bus_write(s->addr, BMP280_REG_CTRL_MEAS, 0x00)) return false;
+    sleep_ms(2);
+
+    // Apply config (only writable in sleep mode)
+    if (!sensor_bus_write(s->addr, BMP280_REG_CONFIG, config_reg)) return false;
+    sleep_ms(2);
+
+    // Back to normal mode with new oversampling
+    if (!sensor_bus_write(s->addr, BMP280_REG_CTRL_MEAS, ctrl_meas)) return false;
+    // First measurement with the new config: one conversion, not a guess
+    sleep_us(bmp280_period_us(ctrl_meas));
+    priv(s)->ctrl_meas = ctrl_meas;
+    priv(s)->config_reg = config_reg;
+    return true;
+}
+
+static bool bmp280_init(sensor_t *s, const sensor_config_t *config) {
+    // Soft reset
+    if (!sensor_bus_write(s->addr, BMP280_REG_RESET, BMP280_RESET_VALUE)) {
+        return false;
+    }
+    sleep_ms(BMP280_STARTUP_MS);
+
+    // Read calibration data
+    uint8_t calib_raw[BMP280_CALIB_LEN];
+    if (!sensor_bus_read(s->addr, BMP280_REG_CALIB_START, calib_raw, BMP280_CALIB_LEN)) {
+        #if CFG_TUD_CDC
+        printf("ERR:Failed to read calibration data\n");
+        #endif
+        return false;
+    }
+    bmp280_parse_calib(calib_raw, &priv(s)->calib);
+    memcpy(priv(s)->calib_raw, calib_raw, BMP280_CALIB_LEN);
+
+    if (!bmp280_write_config(s, config)) return false;
+
+    // Verify registers were written correctly
+    #if CFG_TUD_CDC
+    uint8_t ctrl_meas_read = 0, config_read = 0;
+    sensor_bus_read(s->addr, BMP280_REG_CTRL_MEAS, &ctrl_meas_read, 1);
+    sensor_bus_read(s->addr, BMP280_REG_CONFIG, &config_read, 1);
+    printf("INFO:CTRL_MEAS=0x%02X CONFIG=0x%02X\n", ctrl_meas_read, config_read);
+    #endif
+    return true;
+}
+
+static bool bmp280_configure(sensor_t *s, const sensor_config_t *config) {
+    return bmp280_write_config(s, config);
+}
+
+/**
+ * @brief Soft reset (clears the IIR filter state), then the same config
+ */
+static bool bmp280_reset(sensor_t *s) {
+    if (!sensor_bus_write(s->addr, BMP280_REG_RESET, BMP280_RESET_VALUE)) {
+        return false;
+    }
+    sleep_ms(BMP280_STARTUP_MS);
+    return bmp280_write_config(s, &s->config);
+}
+
+/**
+ * @brief Burst-read the 20-bit pressure and temperature codes
+ * @return false on I2C failure only (codes may still be BMP280_ADC_SKIPPED)
+ */
+static bool bmp280_read_codes(sensor_t *s, int32_t *adc_P, int32_t *adc_T) {
+    uint8_t data[6] = {0};
+    if (!sensor_bus_read(s->addr, BMP280_REG_PRESS_MSB, data, 6)) {
+        return false;
+    }
+    *adc_P = ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
+    *adc_T = ((int32_t)data[3] << 12) | ((int32_t)data[4] << 4) | (data[5] >> 4);
+    return true;
+}
+
+static bool bmp280_read_raw(sensor_t *s, int32_t *adc_P, int32_t *adc_T) {
+    return bmp280_read_codes(s, adc_P, adc_T) &&
+           *adc_P != BMP280_ADC_SKIPPED && *adc_T != BMP280_ADC_SKIPPED;
+}
+
+/**
+ * @brief Compensate one pair of codes (NAN for skipped or corrupt data)
+ */
+static void bmp280_compensate(const sensor_t *s, int32_t adc_P, int32_t adc_T,
+                              sensor_sample_t *out) {
+    const bmp280_calib_t *calib = &priv_c(s)->calib;
+    out->pressure_hpa = NAN;
+    out->temperature_x100 = 0;
+    if (adc_T == BMP280_ADC_SKIPPED) return;
+
+    // Temperature compensation (required for accurate pressure)
+    int32_t t_fine = bmp280_compensate_t_fine(calib, adc_T);
+    out->temperature_x100 = (int16_t)bmp280_t_fine_to_x100(t_fine);
+    if (adc_P == BMP280_ADC_SKIPPED) return;
+
+    // Pressure compensation (shared with the host tools, see bmp280_compensate.h)
+    uint32_t p = bmp280_compensate_p_q24_8(calib, adc_P, t_fine);
+    if (p == 0) return;  // Corrupt calibration data
+    out->pressure_hpa = (float)p / 25600.0f;  // Convert to hPa
+}
+
+static int bmp280_read_batch(sensor_t *s, sensor_sample_t *out, int max) {
+    (void)max;  // No FIFO: always the latest measurement
+    int32_t adc_P, adc_T;
+    if (!bmp280_read_codes(s, &adc_P, &adc_T)) {
+        return -1;
+    }
+    out[0].t_us = time_us_32();
+    bmp280_compensate(s, adc_P, adc_T, &out[0]);
+    return 1;
+}
+
+static sensor_self_test_t bmp280_self_test(sensor_t *s) {
+    uint8_t chip_id;
+    if (!sensor_bus_read(s->addr, BMP280_REG_ID, &chip_id, 1) || chip_id != s->chip_id) {
+        return SENSOR_SELF_TEST_NO_RESPONSE;
+    }
+
+    // Trimming data must be what init parsed, and not blank
+    uint8_t calib_raw[BMP280_CALIB_LEN];
+    if (!sensor_bus_read(s->addr, BMP280_REG_CALIB_START, calib_raw, BMP280_CALIB_LEN)) {
+        return SENSOR_SELF_TEST_NO_RESPONSE;
+    }
+    const bmp280_calib_t *calib = &priv(s)->calib;
+    if (memcmp(calib_raw, priv(s)->calib_raw, BMP280_CALIB_LEN) != 0 ||
+        calib->dig_T1 == 0 || calib->dig_T1 == 0xFFFF ||
+        calib->dig_P1 == 0 || calib->dig_P1 == 0xFFFF) {
+        return SENSOR_SELF_TEST_BAD_CALIB;
+    }
+
+    int32_t adc_P, adc_T;
+    if (!bmp280_read_codes(s, &adc_P, &adc_T)) {
+        return SENSOR_SELF_TEST_NO_RESPONSE;
+    }
+    if (adc_T == BMP280_ADC_SKIPPED) {
+        return SENSOR_SELF_TEST_IMPLAUSIBLE;
+    }
+    sensor_sample_t sample;
+    bmp280_compensate(s, adc_P, adc_T, &sample);
+    if (sample.temperature_x100 < SENSOR_PLAUSIBLE_MIN_X100 ||
+        sample.temperature_x100 > SENSOR_PLAUSIBLE_MAX_X100) {
+        return SENSOR_SELF_TEST_IMPLAUSIBLE;
+    }
+    // Skipped pressure is expected with oversampling "skip"
+    if (s->config.oversampling != 0 &&
+        !(sample.pressure_hpa >= SENSOR_PLAUSIBLE_MIN_HPA &&
+          sample.pressure_hpa <= SENSOR_PLAUSIBLE_MAX_HPA)) {
+        return SENSOR_SELF_TEST_IMPLAUSIBLE;
+    }
+    return SENSOR_SELF_TEST_PASS;
+}
+
+static void bmp280_get_caps(const sensor_t *s, sensor_caps_t *caps) {
+    caps->name = (s->chip_id == BME280_CHIP_ID) ? "BME280" : "BMP280";
+    caps->chip_id = s->chip_id;
+    caps->flags = SENSOR_CAP_RAW_ADC | SENSOR_CAP_STANDBY | SENSOR_CAP_FILTER_BYPASS;
+    caps->max_rate_hz = (uint16_t)(1000000u / bmp280_period_us((0x01 << 5) | (0x01 << 2)));
+    caps->fifo_samples = 0;
+    caps->period_us = bmp280_period_us(priv_c(s)->ctrl_meas);
+}
+
+/**
+ * @brief Sleep mode (on) or back to normal mode with the same ctrl_meas
+ * @details Only the mode bits change: config is untouched, so the IIR
+ *          filter keeps its memory across the pause
+ */
+static bool bmp280_standby(sensor_t *s, bool on) {
+    uint8_t ctrl_meas = priv(s)->ctrl_meas;
+    return sensor_bus_write(s->addr, BMP280_REG_CTRL_MEAS,
+                            on ? (uint8_t)(ctrl_meas & ~0x03) : ctrl_meas);
+}
+
+/**
+ * @brief Forced mode: one conversion, then the part returns to sleep
+ */
+static bool bmp280_trigger(sensor_t *s) {
+    return sensor_bus_write(s->addr, BMP280_REG_CTRL_MEAS,
+                            (uint8_t)((priv(s)->ctrl_meas & ~0x03) | 0x01));
+}
+
+/**
+ * @brief Filter coefficient 0 (on) or the configured one, nothing else
+ * @details config is only writable asleep, but unlike write_config there
+ *          is nothing to settle: the data registers keep the last
+ *          conversion and the next one follows the pressure unfiltered.
+ *          priv->config_reg keeps the configured value for the way back.
+ */
+static bool bmp280_filter_bypass(sensor_t *s, bool on) {
+    const bmp280_priv_t *p = priv_c(s);
+    uint8_t config_reg = on ? (uint8_t)(p->config_reg & ~0x1C) : p->config_reg;
+    return sensor_bus_write(s->addr, BMP280_REG_CTRL_MEAS, (uint8_t)(p->ctrl_meas & ~0x03)) &&
+           sensor_bus_write(s->addr, BMP280_REG_CONFIG, config_reg) &&
+           sensor_bus_write(s->addr, BMP280_REG_CTRL_MEAS, p->ctrl_meas);
+}
+
+static bool bmp280_get_calibration(const sensor_t *s, sensor_calibration_t *calib) {
+    calib->ctrl_meas = priv_c(s)->ctrl_meas;
+    calib->config = priv_c(s)->config_reg;
+    memcpy(calib->block, priv_c(s)->calib_raw, BMP280_CALIB_LEN);
+    return true;
+}
+
+const sensor_driver_t sensor_bmp280_driver = {
+    .name = "BMP280/BME280",
+    .probe = bmp280_probe,
+    .init = bmp280_init,
+    .configure = bmp280_configure,
+    .reset = bmp280_reset,
+    .read_batch = bmp280_read_batch,
+    .self_test = bmp280_self_test,
+    .get_caps = bmp280_get_caps,
+    .period_us = bmp280_config_period_us,
+    .read_raw = bmp280_read_raw,
+    .get_calibration = bmp280_get_calibration,
+    .standby = bmp280_standby,
+    .trigger = bmp280_trigger,
+    .filter_bypass = bmp280_filter_bypass,
+};
@@ -0,0 +1,300 @@
+/**
+ * @file sensor_bus.c
+ * @brief Shared sensor bus (I2C or SPI, see sensor_bus.h)
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "sensor_bus.h"
+#include "pico/stdlib.h"
+#include "pico/mutex.h"
+#include "hardware/gpio.h"
+#include "profiler.h"
+#if SENSOR_BUS_SPI
+#include "hardware/spi.h"
+#include "hardware/dma.h"
+#include <string.h>
+#else
+#include "hardware/i2c.h"
+#endif
+
+static mutex_t g_bus_mutex;
+static volatile uint16_t g_recovery_count = 0;
+static volatile bool g_configured = false;  // sensor_bus_setup_pins done
+
+void sensor_bus_init(void) {
+    mutex_init(&g_bus_mutex);
+}
+
+#if SENSOR_BUS_SPI
+
+/* ============================================================================
+ * SPI transport: one DMA transfer per transaction, CS driven as GPIO
+ * ========================================================================== */
+
+// Bit 7 of the address byte selects read (1) or write (0) on BMP280/BMP3xx
+#define SPI_READ_BIT    0x80
+
+static int g_dma_tx = -1;
+static int g_dma_rx = -1;
+// Transmit: address byte, then zeros clocked out while the part answers
+static uint8_t g_spi_tx[SENSOR_BUS_SPI_MAX];
+static uint8_t g_spi_rx[SENSOR_BUS_SPI_MAX];
+// A soft reset returns the part to I2C mode until CSB falls again
+static bool g_spi_reselect = false;
+
+static void bus_setup(void) {
+    spi_init(SPI_PORT, SPI_BAUDRATE);
+    spi_set_format(SPI_PORT, 8, SPI_CPOL_1, SPI_CPHA_1, SPI_MSB_FIRST);  // Mode 3
+    gpio_set_function(SPI_MISO_PIN, GPIO_FUNC_SPI);
+    gpio_set_function(SPI_SCK_PIN, GPIO_FUNC_SPI);
+    gpio_set_function(SPI_MOSI_PIN, GPIO_FUNC_SPI);
+
+    gpio_init(SPI_CS_PIN);
+    gpio_set_dir(SPI_CS_PIN, GPIO_OUT);
+    gpio_put(SPI_CS_PIN, 1);
+    gpio_init(SPI_CS2_PIN);
+    gpio_set_dir(SPI_CS2_PIN, GPIO_OUT);
+    gpio_put(SPI_CS2_PIN, 1);
+
+    // EMC: weakest drive that still gives clean 10MHz edges on a short lead
+    gpio_set_drive_strength(SPI_SCK_PIN, GPIO_DRIVE_STRENGTH_4MA);
+    gpio_set_drive_strength(SPI_MOSI_PIN, GPIO_DRIVE_STRENGTH_2MA);
+    gpio_set_drive_strength(SPI_CS_PIN, GPIO_DRIVE_STRENGTH_2MA);
+    gpio_set_drive_strength(SPI_CS2_PIN, GPIO_DRIVE_STRENGTH_2MA);
+    gpio_set_slew_rate(SPI_MOSI_PIN, GPIO_SLEW_RATE_SLOW);
+    gpio_set_slew_rate(SPI_CS_PIN, GPIO_SLEW_RATE_SLOW);
+    gpio_set_slew_rate(SPI_CS2_PIN, GPIO_SLEW_RATE_SLOW);
+
+    g_dma_tx = dma_claim_unused_channel(true);
+    g_dma_rx = dma_claim_unused_channel(true);
+
+    dma_channel_config c = dma_channel_get_default_config(g_dma_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(SPI_PORT, true));
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(g_dma_tx, &c, &spi_get_hw(SPI_PORT)->dr, g_spi_tx, 0, false);
+
+    c = dma_channel_get_default_config(g_dma_rx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(SPI_PORT, false));
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    dma_channel_configure(g_dma_rx, &c, g_spi_rx, &spi_get_hw(SPI_PORT)->dr, 0, false);
+}
+
+/**
+ * @brief Chip select for an I2C-style device address
+ */
+static inline uint spi_cs_pin(uint8_t addr) {
+    return addr == SPI_CS2_ADDR ? SPI_CS2_PIN : SPI_CS_PIN;
+}
+
+/**
+ * @brief Clock n bytes of g_spi_tx out and n bytes into g_spi_rx
+ * @details Both channels start together so the RX FIFO never overflows;
+ *          the CPU only waits. Caller holds the bus mutex.
+ */
+static bool spi_transfer(uint cs, size_t n) {
+    if (g_spi_reselect) {
+        // Falling CSB edge switches the parts back to SPI (see sensor_bus_write)
+        gpio_put(SPI_CS_PIN, 0);
+        gpio_put(SPI_CS2_PIN, 0);
+        sleep_us(1);
+        gpio_put(SPI_CS_PIN, 1);
+        gpio_put(SPI_CS2_PIN, 1);
+        g_spi_reselect = false;
+    }
+
+    dma_channel_set_read_addr(g_dma_tx, g_spi_tx, false);
+    dma_channel_set_trans_count(g_dma_tx, n, false);
+    dma_channel_set_write_addr(g_dma_rx, g_spi_rx, false);
+    dma_channel_set_trans_count(g_dma_rx, n, false);
+
+    gpio_put(cs, 0);
+    dma_start_channel_mask((1u << g_dma_tx) | (1u << g_dma_rx));
+
+    uint32_t start = time_us_32();
+    bool ok = true;
+    while (dma_channel_is_busy(g_dma_rx)) {
+        if (time_us_32() - start > SENSOR_BUS_TIMEOUT_US) {
+            // Never seen in practice (SPI has no clock stretching), but a
+            // wedged channel must not hang Core 1 until the watchdog fires
+            dma_channel_abort(g_dma_tx);
+            dma_channel_abort(g_dma_rx);
+            while (spi_is_readable(SPI_PORT)) {
+                (void)spi_get_hw(SPI_PORT)->dr;
+            }
+            if (g_recovery_count < UINT16_MAX) g_recovery_count++;
+            ok = false;
+            break;
+        }
+    }
+    gpio_put(cs, 1);
+    return ok;
+}
+
+bool sensor_bus_write(uint8_t addr, uint8_t reg, uint8_t value) {
+    mutex_enter_blocking(&g_bus_mutex);
+    g_spi_tx[0] = reg & (uint8_t)~SPI_READ_BIT;
+    g_spi_tx[1] = value;
+    bool ok = spi_transfer(spi_cs_pin(addr), 2);
+    g_spi_tx[1] = 0;
+    // Cheap to assume every write might have been a soft reset: writes
+    // only happen on (re)configuration
+    g_spi_reselect = true;
+    mutex_exit(&g_bus_mutex);
+    return ok;
+}
+
+bool sensor_bus_read_skip(uint8_t addr, uint8_t reg, size_t skip,
+                          uint8_t *buffer, size_t len) {
+    size_t n = 1 + skip + len;
+    if (n > SENSOR_BUS_SPI_MAX) {
+        return false;
+    }
+    PROF_BEGIN(prof_t0);  // Includes mutex wait: that is part of the real cost
+    mutex_enter_blocking(&g_bus_mutex);
+    g_spi_tx[0] = reg | SPI_READ_BIT;
+    bool ok = spi_transfer(spi_cs_pin(addr), n);
+    if (ok) {
+        memcpy(buffer, &g_spi_rx[1 + skip], len);
+    }
+    mutex_exit(&g_bus_mutex);
+    PROF_END(prof_t0, PROF_I2C_READ);
+    return ok;
+}
+
+/**
+ * @brief Re-derive the SPI divider after a clk_peri change
+ */
+static void bus_retime(void) {
+    spi_set_baudrate(SPI_PORT, SPI_BAUDRATE);
+}
+
+#else
+
+/* ============================================================================
+ * I2C transport
+ * ========================================================================== */
+
+static void bus_setup(void) {
+    i2c_init(I2C_PORT, I2C_BAUDRATE);
+    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA_PIN);
+    gpio_pull_up(I2C_SCL_PIN);
+
+    // EMC: Reduce drive strength and slew rate for I2C pins
+    gpio_set_drive_strength(I2C_SDA_PIN, GPIO_DRIVE_STRENGTH_2MA);
+    gpio_set_drive_strength(I2C_SCL_PIN, GPIO_DRIVE_STRENGTH_2MA);
+    gpio_set_slew_rate(I2C_SDA_PIN, GPIO_SLEW_RATE_SLOW);
+    gpio_set_slew_rate(I2C_SCL_PIN, GPIO_SLEW_RATE_SLOW);
+}
+
+/**
+ * @brief Recover I2C bus from stuck state (SDA held low)
+ * @details Generates clock pulses to release stuck slave devices
+ */
+static void bus_recover(void) {
+    // Temporarily disable I2C function on pins
+    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_SIO);
+    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_SIO);
+
+    gpio_set_dir(I2C_SDA_PIN, GPIO_IN);
+    gpio_set_dir(I2C_SCL_PIN, GPIO_OUT);
+    gpio_pull_up(I2C_SDA_PIN);
+
+    // Generate 9 clock pulses to release any stuck slave
+    for (int i = 0; i < 9; i++) {
+        gpio_put(I2C_SCL_PIN, 0);
+        sleep_us(5);
+        gpio_put(I2C_SCL_PIN, 1);
+        sleep_us(5);
+
+        // Check if SDA is released
+        if (gpio_get(I2C_SDA_PIN)) {
+            break;
+        }
+    }
+
+    // Generate STOP condition
+    gpio_set_dir(I2C_SDA_PIN, GPIO_OUT);
+    gpio_put(I2C_SDA_PIN, 0);
+    sleep_us(5);
+    gpio_put(I2C_SCL_PIN, 1);
+    sleep_us(5);
+    gpio_put(I2C_SDA_PIN, 1);
+    sleep_us(5);
+
+    // Restore I2C function
+    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA_PIN);
+    gpio_pull_up(I2C_SCL_PIN);
+
+    if (g_recovery_count < UINT16_MAX) g_recovery_count++;
+}
+
+bool sensor_bus_write(uint8_t addr, uint8_t reg, uint8_t value) {
+    mutex_enter_blocking(&g_bus_mutex);
+    uint8_t buf[2] = {reg, value};
+    bool ok = i2c_write_timeout_us(I2C_PORT, addr, buf, 2, false, SENSOR_BUS_TIMEOUT_US) >= 0;
+    if (!ok) {
+        bus_recover();
+    }
+    mutex_exit(&g_bus_mutex);
+    return ok;
+}
+
+bool sensor_bus_read_skip(uint8_t addr, uint8_t reg, size_t skip,
+                          uint8_t *buffer, size_t len) {
+    (void)skip;  // I2C parts never send dummy bytes
+    PROF_BEGIN(prof_t0);  // Includes mutex wait: that is part of the real cost
+    mutex_enter_blocking(&g_bus_mutex);
+    bool ok = i2c_write_timeout_us(I2C_PORT, addr, &reg, 1, true, SENSOR_BUS_TIMEOUT_US) >= 0 &&
+              i2c_read_timeout_us(I2C_PORT, addr, buffer, len, false, SENSOR_BUS_TIMEOUT_US) >= 0;
+    if (!ok) {
+        bus_recover();
+    }
+    mutex_exit(&g_bus_mutex);
+    PROF_END(prof_t0, PROF_I2C_READ);
+    return ok;
+}
+
+/**
+ * @brief Re-derive the I2C SCL timing after a clk_peri change
+ */
+static void bus_retime(void) {
+    i2c_set_baudrate(I2C_PORT, I2C_BAUDRATE);
+}
+
+#endif // SENSOR_BUS_SPI
+
+bool sensor_bus_read(uint8_t addr, uint8_t reg, uint8_t *buffer, size_t len) {
+    return sensor_bus_read_skip(addr, reg, 0, buffer, len);
+}
+
+uint16_t sensor_bus_recovery_count(void) {
+    return g_recovery_count;
+}
+
+void sensor_bus_setup_pins(void) {
+    // Under the lock: a clock change meanwhile would leave stale dividers
+    mutex_enter_blocking(&g_bus_mutex);
+    bus_setup();
+    g_configured = true;
+    mutex_exit(&g_bus_mutex);
+}
+
+void sensor_bus_begin_clock_change(void) {
+    mutex_enter_blocking(&g_bus_mutex);
+}
+
+void sensor_bus_end_clock_change(void) {
+    if (g_configured) bus_retime();
+    mutex_exit(&g_bus_mutex);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file sensor_bus.h
+ * @brief Shared sensor bus (I2C or SPI) with timeouts and error recovery
+ *
+ * Both cores talk to the sensor: Core 1 samples, Core 0 reconfigures on
+ * command. Every transaction holds one mutex, gives up after
+ * SENSOR_BUS_TIMEOUT_US and recovers the bus on failure (EMC).
+ * Transactions carry the 7-bit I2C device address so drivers do not care
+ * which part sits where.
+ *
+ * The transport is chosen at build time:
+ *   default                     - RP2350 I2C block, CPU-polled
+ *   DIVECHECKER_SENSOR_SPI      - SPI + DMA; the address only picks the
+ *                                 chip select (SPI_CS2_ADDR on SPI_CS2_PIN,
+ *                                 anything else on SPI_CS_PIN), a 6-byte
+ *                                 BMP280 sample takes about 6 us, not 200 us
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef SENSOR_BUS_H
+#define SENSOR_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef SENSOR_BUS_SPI
+#define SENSOR_BUS_SPI      0           // 1 = SPI + DMA (DIVECHECKER_SENSOR_SPI)
+#endif
+
+#if SENSOR_BUS_SPI
+#define SPI_PORT            spi0
+#define SPI_MISO_PIN        4           // Sensor SDO
+#define SPI_CS_PIN          5           // Sensor CSB (GPIO, active low)
+#define SPI_CS2_PIN         3           // Second sensor CSB (optional)
+#define SPI_CS2_ADDR        0x77        // Device address routed to SPI_CS2_PIN
+#define SPI_SCK_PIN         6           // Sensor SCK
+#define SPI_MOSI_PIN        7           // Sensor SDI
+#define SPI_BAUDRATE        10000000    // 10MHz (BMP280/BMP390 max spec)
+#define SENSOR_BUS_SPI_MAX  256         // Longest transaction (command + data)
+#else
+#define I2C_PORT            i2c0
+#define I2C_SDA_PIN         8
+#define I2C_SCL_PIN         9
+#define I2C_BAUDRATE        400000      // 400kHz (BMP280/BMP390 max spec)
+#endif
+
+// Transaction timeout in microseconds (50ms should be plenty for 400kHz)
+#define SENSOR_BUS_TIMEOUT_US   50000
+
+/**
+ * @brief Create the bus mutex (Core 0, before Core 1 starts)
+ */
+void sensor_bus_init(void);
+
+/**
+ * @brief Configure the bus block, pins and DMA (Core 1, before the first transfer)
+ */
+void sensor_bus_setup_pins(void);
+
+/**
+ * @brief Write one register
+ */
+bool sensor_bus_write(uint8_t addr, uint8_t reg, uint8_t value);
+
+/**
+ * @brief Read len consecutive registers starting at reg
+ */
+bool sensor_bus_read(uint8_t addr, uint8_t reg, uint8_t *buffer, size_t len);
+
+/**
+ * @brief sensor_bus_read for parts that send dummy bytes before the data
+ * @details BMP3xx clocks out one dummy byte after the register address in
+ *          SPI mode; skip is ignored on I2C
+ */
+bool sensor_bus_read_skip(uint8_t addr, uint8_t reg, size_t skip,
+                          uint8_t *buffer, size_t len);
+
+/**
+ * @brief Bus recoveries since boot (saturating)
+ * @details I2C: stuck-bus clock-outs. SPI: aborted DMA transfers.
+ */
+uint16_t sensor_bus_recovery_count(void);
+
+/**
+ * @brief Hold the bus idle across a clk_sys / clk_peri change
+ * @details begin waits for the transaction in flight and locks the bus;
+ *          end re-derives the transport's divider from the new clock and
+ *          unlocks. Both on the core that changes the clock.
+ */
+void sensor_bus_begin_clock_change(void);
+void sensor_bus_end_clock_change(void);
+
+#endif // SENSOR_BUS_H
@@ -0,0 +1,243 @@
+/**
+ * @file settings_journal.c
+ * @brief Append-only key/value settings journal in flash
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#include "settings_journal.h"
+#include "flash_io.h"
+#include "flash_maint.h"
+#include "crc32.h"
+#include "crc32_dma.h"
+#include "hardware/flash.h"
+#include <string.h>
+
+#define SJ_HEADER_SIZE      16
+#define SJ_RECORD_OVERHEAD  4       // key, len, crc16 (little-endian)
+#define SJ_KEY_EMPTY        0xFF    // Erased flash: end of log
+#define SJ_LEN_UNSET        0xFF    // RAM copy: key never written
+#define SJ_PENDING_SIZE     256
+// Worst case compacted image: header + every key at maximum length
+#define SJ_IMAGE_MAX        (SJ_HEADER_SIZE + (SETTINGS_JOURNAL_MAX_KEYS - 1) * \
+                             (SJ_RECORD_OVERHEAD + SETTINGS_JOURNAL_MAX_VALUE))
+
+_Static_assert(SJ_IMAGE_MAX <= FLASH_SECTOR_SIZE - FLASH_MAINT_DATA_OFFSET,
+               "compacted journal must fit one sector");
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t reserved;
+    uint32_t crc32;         // CRC32 of the first 12 bytes
+} sj_header_t;
+
+_Static_assert(sizeof(sj_header_t) == SJ_HEADER_SIZE, "journal header size");
+
+typedef struct {
+    uint8_t len;                                // SJ_LEN_UNSET if never written
+    uint8_t value[SETTINGS_JOURNAL_MAX_VALUE];
+} sj_entry_t;
+
+static sj_entry_t g_entries[SETTINGS_JOURNAL_MAX_KEYS];
+static uint32_t g_region_offset = 0;
+static int g_active = -1;           // Active sector index, -1 = no journal yet
+static uint32_t g_sequence = 0;
+static uint32_t g_write_off = 0;    // Append position within the active sector
+static bool g_active_full = false;  // Tail unusable: compact on next commit
+
+static uint8_t g_pending[SJ_PENDING_SIZE];
+static uint16_t g_pending_len = 0;
+static bool g_pending_overflow = false;
+
+static uint8_t g_image[SJ_IMAGE_MAX];   // Compaction scratch (kept off the stack)
+static settings_journal_stats_t g_stats;
+
+static uint32_t sector_offset(int sector) {
+    return g_region_offset + (uint32_t)sector * FLASH_SECTOR_SIZE;
+}
+
+static uint16_t record_crc(uint8_t key, uint8_t len, const uint8_t *value) {
+    uint8_t buf[2 + SETTINGS_JOURNAL_MAX_VALUE];
+    buf[0] = key;
+    buf[1] = len;
+    memcpy(&buf[2], value, len);
+    return (uint16_t)crc32_compute(buf, 2u + len);
+}
+
+/// Serialize one record, returns its size
+static uint16_t record_encode(uint8_t *dst, uint8_t key, const uint8_t *value, uint8_t len) {
+    uint16_t crc = record_crc(key, len, value);
+    dst[0] = key;
+    dst[1] = len;
+    dst[2] = crc & 0xFF;
+    dst[3] = crc >> 8;
+    memcpy(&dst[SJ_RECORD_OVERHEAD], value, len);
+    return SJ_RECORD_OVERHEAD + len;
+}
+
+static bool header_valid(const sj_header_t *h) {
+    return h->magic == SETTINGS_JOURNAL_MAGIC &&
+           h->crc32 == crc32_region(0, h, SJ_HEADER_SIZE - sizeof(uint32_t));
+}
+
+/// Rebuild the active sector in the spare one from the RAM copy
+static void journal_compact(void) {
+    int target = (g_active < 0) ? 0 : 1 - g_active;
+    uint32_t target_off = sector_offset(target);
+
+    // Normally pre-erased in the background by flash_maint_task()
+    if (!flash_maint_is_erased(target_off)) {
+        flash_maint_erase_now(target_off);
+        if (g_stats.forced_erases < UINT16_MAX) g_stats.forced_erases++;
+    }
+    flash_maint_take(target_off);
+
+    uint16_t len = SJ_HEADER_SIZE;
+    for (int key = 1; key < SETTINGS_JOURNAL_MAX_KEYS; key++) {
+        const sj_entry_t *e = &g_entries[key];
+        if (e->len == SJ_LEN_UNSET) continue;
+        len += record_encode(&g_image[len], (uint8_t)key, e->value, e->len);
+    }
+
+    sj_header_t hdr = {
+        .magic = SETTINGS_JOURNAL_MAGIC,
+        .sequence = g_sequence + 1,
+        .reserved = 0xFFFFFFFF,
+    };
+    hdr.crc32 = crc32_compute((const uint8_t*)&hdr, SJ_HEADER_SIZE - sizeof(uint32_t));
+
+    // Records first, header last: a torn compaction never becomes active
+    uint32_t base = target_off + FLASH_MAINT_DATA_OFFSET;
+    flash_io_program(base + SJ_HEADER_SIZE, &g_image[SJ_HEADER_SIZE], len - SJ_HEADER_SIZE);
+    flash_io_program(base, (const uint8_t*)&hdr, SJ_HEADER_SIZE);
+
+    if (g_active >= 0) {
+        flash_maint_release(sector_offset(g_active));
+    }
+    g_active = target;
+    g_sequence = hdr.sequence;
+    g_write_off = FLASH_MAINT_DATA_OFFSET + len;
+    g_active_full = false;
+    if (g_stats.compactions < UINT16_MAX) g_stats.compactions++;
+}
+
+bool settings_journal_init(uint32_t region_offset) {
+    g_region_offset = region_offset;
+    g_active = -1;
+    g_active_full = false;
+    g_pending_len = 0;
+    g_pending_overflow = false;
+    memset(&g_stats, 0, sizeof(g_stats));
+    for (int key = 0; key < SETTINGS_JOURNAL_MAX_KEYS; key++) {
+        g_entries[key].len = SJ_LEN_UNSET;
+    }
+
+    // Newest valid header wins (wrap-safe sequence compare)
+    for (int s = 0; s < SETTINGS_JOURNAL_SECTORS; s++) {
+        const sj_header_t *h = (const sj_header_t*)flash_io_read_ptr(sector_offset(s) + FLASH_MAINT_DATA_OFFSET);
+        if (!header_valid(h)) continue;
+        if (g_active < 0 || (int32_t)(h->sequence - g_sequence) > 0) {
+            g_active = s;
+            g_sequence = h->sequence;
+        }
+    }
+    if (g_active < 0) {
+        return false;  // Nothing to claim: a legacy migration may still need the sectors
+    }
+
+    // Single pass: remember where the latest record of each key lives
+    const uint8_t *base = flash_io_read_ptr(sector_offset(g_active));
+    uint16_t latest[SETTINGS_JOURNAL_MAX_KEYS] = {0};
+    uint32_t off = FLASH_MAINT_DATA_OFFSET + SJ_HEADER_SIZE;
+    while (off + SJ_RECORD_OVERHEAD <= FLASH_SECTOR_SIZE) {
+        uint8_t key = base[off];
+        if (key == SJ_KEY_EMPTY) break;
+        uint8_t len = base[off + 1];
+        if (len > SETTINGS_JOURNAL_MAX_VALUE ||
+            off + SJ_RECORD_OVERHEAD + len > FLASH_SECTOR_SIZE) {
+            g_active_full = true;  // Length byte corrupt: cannot find next record
+            break;
+        }
+        uint16_t crc = base[off + 2] | (base[off + 3] << 8);
+        if (key != 0 && key < SETTINGS_JOURNAL_MAX_KEYS &&
+            crc == record_crc(key, len, &base[off + SJ_RECORD_OVERHEAD])) {
+            latest[key] = (uint16_t)off;
+        }
+        off += SJ_RECORD_OVERHEAD + len;
+        g_stats.records_scanned++;
+    }
+    g_write_off = off;
+
+    // A torn append may have left programmed bytes past the end marker
+    if (!g_active_full && !flash_io_is_blank(sector_offset(g_active) + off,
+                                             FLASH_SECTOR_SIZE - off)) {
+        g_active_full = true;
+    }
+
+    for (int key = 1; key < SETTINGS_JOURNAL_MAX_KEYS; key++) {
+        if (latest[key] == 0) continue;
+        uint8_t len = base[latest[key] + 1];
+        g_entries[key].len = len;
+        memcpy(g_entries[key].value, &base[latest[key] + SJ_RECORD_OVERHEAD], len);
+    }
+
+    // The other sector is stale (or a torn compaction): hand it to maintenance
+    flash_maint_claim(sector_offset(g_active));
+    uint32_t other_off = sector_offset(1 - g_active);
+    if (!flash_maint_is_erased(other_off)) {
+        flash_maint_claim(other_off);
+        flash_maint_release(other_off);
+    }
+    return true;
+}
+
+int settings_journal_get(uint8_t key, void *out, uint8_t max_len) {
+    if (key == 0 || key >= SETTINGS_JOURNAL_MAX_KEYS) return -1;
+    const sj_entry_t *e = &g_entries[key];
+    if (e->len == SJ_LEN_UNSET) return -1;
+    memcpy(out, e->value, (e->len < max_len) ? e->len : max_len);
+    return e->len;
+}
+
+bool settings_journal_put(uint8_t key, const void *value, uint8_t len) {
+    if (key == 0 || key >= SETTINGS_JOURNAL_MAX_KEYS || len > SETTINGS_JOURNAL_MAX_VALUE) {
+        return false;
+    }
+    sj_entry_t *e = &g_entries[key];
+    if (e->len == len && memcmp(e->value, value, len) == 0) {
+        return true;  // Unchanged: no flash traffic
+    }
+    e->len = len;
+    memcpy(e->value, value, len);
+
+    if (g_pending_len + SJ_RECORD_OVERHEAD + len <= SJ_PENDING_SIZE) {
+        g_pending_len += record_encode(&g_pending[g_pending_len], key, e->value, len);
+    } else {
+        g_pending_overflow = true;  // Compaction writes the RAM copy anyway
+    }
+    return true;
+}
+
+bool settings_journal_commit(void) {
+    if (g_pending_len == 0 && !g_pending_overflow) return true;
+
+    if (g_active < 0 || g_active_full || g_pending_overflow ||
+        g_write_off + g_pending_len > FLASH_SECTOR_SIZE) {
+        journal_compact();
+    } else {
+        flash_io_program(sector_offset(g_active) + g_write_off, g_pending, g_pending_len);
+        g_write_off += g_pending_len;
+    }
+    g_pending_len = 0;
+    g_pending_overflow = false;
+    return true;
+}
+
+void settings_journal_get_stats(settings_journal_stats_t *stats) {
+    *stats = g_stats;
+    stats->sequence = g_sequence;
+    stats->used_bytes = (uint16_t)g_write_off;
+}
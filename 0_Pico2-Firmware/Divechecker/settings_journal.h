@@ -0,0 +1,82 @@
+/**
+ * @file settings_journal.h
+ * @brief Append-only key/value settings journal in flash
+ *
+ * Replaces whole-struct slot rewrites: changing one setting appends a
+ * small record ([key][len][crc16][value]) to the active sector. When the
+ * active sector fills, the RAM copy of every key is compacted into the
+ * spare sector. The old sector is released to flash_maint, which erases
+ * it when the device is idle, so runtime saves are program-only.
+ *
+ * Sector layout (after the 8-byte flash_maint header):
+ *   [magic 'DIVJ'][sequence][reserved][header crc32]  16 bytes
+ *   [record][record]...                               0xFF = end of log
+ *
+ * The sector with the newest valid sequence number is active. Records
+ * are written first and a sector header last, so a torn compaction
+ * leaves the previous sector in charge.
+ *
+ * Core 0 only.
+ *
+ * @author Createch (legal@createch.kr)
+ * @copyright Copyright (C) 2025-2026 Createch
+ * @license Apache License 2.0
+ */
+
+#ifndef SETTINGS_JOURNAL_H
+#define SETTINGS_JOURNAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SETTINGS_JOURNAL_MAGIC      0x4A564944  // "DIVJ"
+#define SETTINGS_JOURNAL_SECTORS    2
+#define SETTINGS_JOURNAL_MAX_KEYS   32          // Valid keys: 1..31
+#define SETTINGS_JOURNAL_MAX_VALUE  32          // Bytes per value
+
+/**
+ * @brief Scan the journal region and build the RAM index
+ * @details One pass over the records of the active sector: O(records).
+ *          The region must already be registered with flash_maint.
+ * @param region_offset Flash offset of the first journal sector
+ * @return true if a valid journal was found
+ */
+bool settings_journal_init(uint32_t region_offset);
+
+/**
+ * @brief Read a value from the RAM copy
+ * @param key Setting key
+ * @param out Destination buffer
+ * @param max_len Capacity of out
+ * @return Stored value length, or -1 if the key has never been written
+ */
+int settings_journal_get(uint8_t key, void *out, uint8_t max_len);
+
+/**
+ * @brief Stage a value; only changed values produce a flash record
+ * @return false if key or length is out of range
+ */
+bool settings_journal_put(uint8_t key, const void *value, uint8_t len);
+
+/**
+ * @brief Write all staged records to flash
+ * @details Program-only unless the active sector is full and the spare
+ *          has not been pre-erased by flash_maint yet.
+ * @return true if nothing was pending or the write succeeded
+ */
+bool settings_journal_commit(void);
+
+/**
+ * @brief Journal statistics for diagnostics
+ */
+typedef struct {
+    uint32_t sequence;          // Sequence number of the active sector
+    uint16_t used_bytes;        // Bytes used in the active sector
+    uint16_t records_scanned;   // Records visited by the boot scan
+    uint16_t compactions;       // Compactions since boot
+    uint16_t forced_erases;     // Erases that could not be deferred
+} settings_journal_stats_t;
+
+void settings_journal_get_stats(settings_journal_stats_t *stats);
+
+#endif // SETTINGS_JOURNAL_H